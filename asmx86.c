@@ -19,6 +19,10 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <stddef.h>
+#include <string.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 #include "asmx86.h"
 
 #define DEC_FLAG_LOCK                   0x0020
@@ -38,6 +42,42 @@
 #define DEC_FLAG_REG_RM_FAR_SIZE        0x02
 #define DEC_FLAG_REG_RM_NO_SIZE         0x03
 
+// Longest encoding of an instruction after its prefixes (opcode, ModRM, SIB, 32-bit displacement
+// and 32-bit immediate)
+#define MAX_INSTRUCTION_BODY_LENGTH     11
+
+#define PACKED_LENGTH_MASK              0x0f
+#define PACKED_SEGMENT_SHIFT            4
+#define PACKED_INSUFFICIENT_LENGTH      0x80
+#define PACKED_PREFIX_FLAGS_MASK        0x3f
+#define PACKED_SIZES_IN_VALUES          0x40
+#define PACKED_MEM2_IN_VALUES           0x80
+#define PACKED_MEM_SCALE_MASK           0x03
+#define PACKED_MEM_SEGMENT_SHIFT        2
+#define PACKED_MEM_RELATIVE             0x20
+#define PACKED_SIZE_CODE_BITS           4
+#define PACKED_SIZE_CODE_MASK           0x0f
+#define PACKED_VALUE_PRESENT_SHIFT      12
+
+#define FORMAT_STEP_TEXT                0
+#define FORMAT_STEP_ADDRESS             1
+#define FORMAT_STEP_BYTES               2
+#define FORMAT_STEP_MNEMONIC            3
+#define FORMAT_STEP_OPERANDS            4
+
+// Longest operand list: three memory operands, each with a size, segment, base, scaled index and
+// 64-bit displacement, separated by ", "
+#define MAX_MEMORY_OPERAND_STRING_LENGTH  (6 + (MAX_OPERAND_STRING_LENGTH + 1) + 1 + MAX_OPERAND_STRING_LENGTH + \
+	1 + MAX_OPERAND_STRING_LENGTH + 2 + 3 + 16 + 1)
+#define MAX_OPERANDS_STRING_LENGTH        ((3 * MAX_MEMORY_OPERAND_STRING_LENGTH) + 4)
+
+// Select the decoder function with a switch on the decoder kind instead of calling through the
+// function pointer in the opcode tables. This is always done by the mode specialized decoders,
+// and can be requested for the runtime decoder with ASMX86_DIRECT_DISPATCH.
+#if defined(ASMX86_MODE_SPECIALIZED) || defined(ASMX86_DIRECT_DISPATCH)
+#define DECODER_KIND_DISPATCH
+#endif
+
 
 #ifdef __cplusplus
 namespace x86
@@ -60,6 +100,9 @@ namespace x86
 		InstructionOperand* operand1;
 		const uint8_t* opcodeStart;
 		const uint8_t* opcode;
+		const uint8_t* body;
+		const uint8_t* modRM;
+		const uint8_t* modRMEnd;
 		uint64_t addr;
 		size_t len, origLen;
 		uint16_t opSize, finalOpSize, addrSize;
@@ -78,6 +121,34 @@ namespace x86
 
 #include "asmx86str.h"
 
+	// Rules in operationOperandAccess for moves that write part of an XMM register
+#define ACCESS_PARTIAL_WRITE	0x1000	// A register destination is read as well, as the rest of it is kept
+#define ACCESS_REGISTER_SOURCE	0x2000	// Only when the source is a register, as loads from memory clear the rest
+
+
+	// Sets the access of each operand from the pattern for the operation with its number of operands
+	static void SetOperandAccess(Instruction* instr)
+	{
+		uint16_t rules = operationOperandAccess[instr->operation];
+		uint16_t access = rules;
+		if (instr->operands[2].operand != NONE)
+			access = (access >> 6) & 0x3f;
+		else if (instr->operands[1].operand != NONE)
+			access = (access >> 2) & 0xf;
+		else if (instr->operands[0].operand != NONE)
+			access &= 3;
+		else
+			access = 0;
+		instr->operands[0].access = (uint8_t)(access & 3);
+		instr->operands[1].access = (uint8_t)((access >> 2) & 3);
+		instr->operands[2].access = (uint8_t)(access >> 4);
+
+		if ((rules & ACCESS_PARTIAL_WRITE) && (instr->operands[0].operand != MEM) &&
+			((!(rules & ACCESS_REGISTER_SOURCE)) || (instr->operands[1].operand != MEM)))
+			instr->operands[0].access = X86_ACCESS_READ_WRITE;
+	}
+
+#ifndef DECODER_KIND_DISPATCH
 	typedef void (*DecodingFunction)(DecodeState* state);
 
 	static void InvalidDecode(DecodeState* state);
@@ -150,157 +221,178 @@ namespace x86
 	static void DecodeMovNti(DecodeState* state);
 	static void DecodeCrc32(DecodeState* state);
 	static void DecodeArpl(DecodeState* state);
+#endif
+
+
+	enum DecoderKind
+	{
+		DECODE_INVALID, DECODE_TWO_BYTE, DECODE_FPU, DECODE_NO_OPERANDS, DECODE_REG_RM, DECODE_REG_RM_IMM,
+		DECODE_RM_REG_IMM8, DECODE_RM_REG_CL, DECODE_EAX_IMM, DECODE_PUSH_POP_SEG, DECODE_OP_REG,
+		DECODE_EAX_OP_REG, DECODE_OP_REG_IMM, DECODE_NOP, DECODE_IMM, DECODE_IMM16_IMM8, DECODE_EDI_DX,
+		DECODE_DX_ESI, DECODE_REL_IMM, DECODE_REL_IMM_ADDR_SIZE, DECODE_GROUP_RM, DECODE_GROUP_RM_IMM,
+		DECODE_GROUP_RM_IMM8_V, DECODE_GROUP_RM_ONE, DECODE_GROUP_RM_CL, DECODE_GROUP_F6F7, DECODE_GROUP_FF,
+		DECODE_GROUP_0F00, DECODE_GROUP_0F01, DECODE_GROUP_0FAE, DECODE_0FB8, DECODE_RM_SREG_V, DECODE_RM_8,
+		DECODE_RM_V, DECODE_FAR_IMM, DECODE_EAX_ADDR, DECODE_EDI_ESI, DECODE_EDI_EAX, DECODE_EAX_ESI,
+		DECODE_AL_EBX_AL, DECODE_EAX_IMM8, DECODE_EAX_DX, DECODE_3DNOW, DECODE_SSE_TABLE, DECODE_SSE_TABLE_IMM8,
+		DECODE_SSE_TABLE_MEM8, DECODE_SSE, DECODE_SSE_SINGLE, DECODE_SSE_PACKED, DECODE_MMX, DECODE_MMX_SSE_ONLY,
+		DECODE_MMX_GROUP, DECODE_PINSRW, DECODE_REG_CR, DECODE_MOVSXZX_8, DECODE_MOVSXZX_16, DECODE_MEM_16,
+		DECODE_MEM_32, DECODE_MEM_64, DECODE_MEM_80, DECODE_MEM_FLOATENV, DECODE_MEM_FLOATSAVE, DECODE_FPUREG,
+		DECODE_FPUREG_ST0, DECODE_REGGROUP_NO_OPERANDS, DECODE_REGGROUP_AX, DECODE_CMPXCH8B, DECODE_MOVNTI,
+		DECODE_CRC32, DECODE_ARPL
+	};
+#ifndef __cplusplus
+	typedef enum DecoderKind DecoderKind;
+#endif
 
 
-// Instruction encodings, first is flags and second is decoder function
-#define ENC_INVALID 0, InvalidDecode
-#define ENC_TWO_BYTE 0, DecodeTwoByte
-#define ENC_FPU 0, DecodeFpu
-#define ENC_NO_OPERANDS 0, DecodeNoOperands
-#define ENC_OP_SIZE DEC_FLAG_OPERATION_OP_SIZE, DecodeNoOperands
-#define ENC_OP_SIZE_DEF64 DEC_FLAG_DEFAULT_TO_64BIT | DEC_FLAG_OPERATION_OP_SIZE, DecodeNoOperands
-#define ENC_OP_SIZE_NO64 DEC_FLAG_INVALID_IN_64BIT | DEC_FLAG_OPERATION_OP_SIZE, DecodeNoOperands
-#define ENC_REG_RM_8 DEC_FLAG_BYTE, DecodeRegRM
-#define ENC_RM_REG_8 DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS, DecodeRegRM
-#define ENC_RM_REG_8_LOCK DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_LOCK, DecodeRegRM
-#define ENC_RM_REG_16 DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_FORCE_16BIT, DecodeRegRM
-#define ENC_REG_RM_V 0, DecodeRegRM
-#define ENC_RM_REG_V DEC_FLAG_FLIP_OPERANDS, DecodeRegRM
-#define ENC_RM_REG_V_LOCK DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_LOCK, DecodeRegRM
-#define ENC_REG_RM2X_V DEC_FLAG_REG_RM_2X_SIZE, DecodeRegRM
-#define ENC_REG_RM_IMM_V 0, DecodeRegRMImm
-#define ENC_REG_RM_IMMSX_V DEC_FLAG_IMM_SX, DecodeRegRMImm
-#define ENC_REG_RM_0 DEC_FLAG_REG_RM_NO_SIZE, DecodeRegRM
-#define ENC_REG_RM_F DEC_FLAG_REG_RM_FAR_SIZE, DecodeRegRM
-#define ENC_RM_REG_DEF64 DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_DEFAULT_TO_64BIT, DecodeRegRM
-#define ENC_RM_REG_IMM8_V 0, DecodeRMRegImm8
-#define ENC_RM_REG_CL_V 0, DecodeRMRegCL
-#define ENC_EAX_IMM_8 DEC_FLAG_BYTE, DecodeEaxImm
-#define ENC_EAX_IMM_V 0, DecodeEaxImm
-#define ENC_PUSH_POP_SEG 0, DecodePushPopSeg
-#define ENC_OP_REG_V 0, DecodeOpReg
-#define ENC_OP_REG_V_DEF64 DEC_FLAG_DEFAULT_TO_64BIT, DecodeOpReg
-#define ENC_EAX_OP_REG_V 0, DecodeEaxOpReg
-#define ENC_OP_REG_IMM_8 DEC_FLAG_BYTE, DecodeOpRegImm
-#define ENC_OP_REG_IMM_V 0, DecodeOpRegImm
-#define ENC_NOP 0, DecodeNop
-#define ENC_IMM_V_DEF64 DEC_FLAG_DEFAULT_TO_64BIT, DecodeImm
-#define ENC_IMMSX_V_DEF64 DEC_FLAG_IMM_SX | DEC_FLAG_DEFAULT_TO_64BIT, DecodeImm
-#define ENC_IMM_8 DEC_FLAG_BYTE, DecodeImm
-#define ENC_IMM_16 DEC_FLAG_FORCE_16BIT, DecodeImm
-#define ENC_IMM16_IMM8 0, DecodeImm16Imm8
-#define ENC_EDI_DX_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeEdiDx
-#define ENC_EDI_DX_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeEdiDx
-#define ENC_DX_ESI_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeDxEsi
-#define ENC_DX_ESI_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeDxEsi
-#define ENC_RELIMM_8_DEF64 DEC_FLAG_BYTE | DEC_FLAG_DEFAULT_TO_64BIT, DecodeRelImm
-#define ENC_RELIMM_V_DEF64 DEC_FLAG_DEFAULT_TO_64BIT, DecodeRelImm
-#define ENC_RELIMM_8_ADDR_SIZE_DEF64 DEC_FLAG_BYTE | DEC_FLAG_DEFAULT_TO_64BIT, DecodeRelImmAddrSize
-#define ENC_GROUP_RM_8 DEC_FLAG_BYTE, DecodeGroupRM
-#define ENC_GROUP_RM_V 0, DecodeGroupRM
-#define ENC_GROUP_RM_8_LOCK DEC_FLAG_BYTE | DEC_FLAG_LOCK, DecodeGroupRM
-#define ENC_GROUP_RM_0 DEC_FLAG_REG_RM_NO_SIZE, DecodeGroupRM
-#define ENC_GROUP_RM_IMM_8 DEC_FLAG_BYTE, DecodeGroupRMImm
-#define ENC_GROUP_RM_IMM_8_LOCK DEC_FLAG_BYTE | DEC_FLAG_LOCK, DecodeGroupRMImm
-#define ENC_GROUP_RM_IMM_8_NO64_LOCK DEC_FLAG_BYTE | DEC_FLAG_INVALID_IN_64BIT | DEC_FLAG_LOCK, DecodeGroupRMImm
-#define ENC_GROUP_RM_IMM8_V 0, DecodeGroupRMImm8V
-#define ENC_GROUP_RM_IMM_V 0, DecodeGroupRMImm
-#define ENC_GROUP_RM_IMM_V_LOCK DEC_FLAG_LOCK, DecodeGroupRMImm
-#define ENC_GROUP_RM_IMMSX_V_LOCK DEC_FLAG_IMM_SX | DEC_FLAG_LOCK, DecodeGroupRMImm
-#define ENC_GROUP_RM_ONE_8 DEC_FLAG_BYTE, DecodeGroupRMOne
-#define ENC_GROUP_RM_ONE_V 0, DecodeGroupRMOne
-#define ENC_GROUP_RM_CL_8 DEC_FLAG_BYTE, DecodeGroupRMCl
-#define ENC_GROUP_RM_CL_V 0, DecodeGroupRMCl
-#define ENC_GROUP_F6 DEC_FLAG_BYTE | DEC_FLAG_LOCK, DecodeGroupF6F7
-#define ENC_GROUP_F7 DEC_FLAG_LOCK, DecodeGroupF6F7
-#define ENC_GROUP_FF DEC_FLAG_LOCK, DecodeGroupFF
-#define ENC_GROUP_0F00 0, DecodeGroup0F00
-#define ENC_GROUP_0F01 0, DecodeGroup0F01
-#define ENC_GROUP_0FAE 0, DecodeGroup0FAE
-#define ENC_0FB8 0, Decode0FB8
-#define ENC_RM_SREG_V 0, DecodeRMSRegV
-#define ENC_SREG_RM_V DEC_FLAG_FLIP_OPERANDS, DecodeRMSRegV
-#define ENC_RM_8 0, DecodeRM8
-#define ENC_RM_V_DEF64 DEC_FLAG_DEFAULT_TO_64BIT, DecodeRMV
-#define ENC_FAR_IMM_NO64 DEC_FLAG_INVALID_IN_64BIT, DecodeFarImm
-#define ENC_EAX_ADDR_8 DEC_FLAG_BYTE, DecodeEaxAddr
-#define ENC_EAX_ADDR_V 0, DecodeEaxAddr
-#define ENC_ADDR_EAX_8 DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS, DecodeEaxAddr
-#define ENC_ADDR_EAX_V DEC_FLAG_FLIP_OPERANDS, DecodeEaxAddr
-#define ENC_EDI_ESI_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeEdiEsi
-#define ENC_EDI_ESI_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeEdiEsi
-#define ENC_ESI_EDI_8_REPC DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP_COND, DecodeEdiEsi
-#define ENC_ESI_EDI_OP_SIZE_REPC DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP_COND, DecodeEdiEsi
-#define ENC_EDI_EAX_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeEdiEax
-#define ENC_EDI_EAX_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeEdiEax
-#define ENC_EAX_ESI_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeEaxEsi
-#define ENC_EAX_ESI_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DecodeEaxEsi
-#define ENC_EAX_EDI_8_REPC DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP_COND, DecodeEdiEax
-#define ENC_EAX_EDI_OP_SIZE_REPC DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP_COND, DecodeEdiEax
-#define ENC_AL_EBX_AL 0, DecodeAlEbxAl
-#define ENC_EAX_IMM8_8 DEC_FLAG_BYTE, DecodeEaxImm8
-#define ENC_EAX_IMM8_V 0, DecodeEaxImm8
-#define ENC_IMM8_EAX_8 DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS, DecodeEaxImm8
-#define ENC_IMM8_EAX_V DEC_FLAG_FLIP_OPERANDS, DecodeEaxImm8
-#define ENC_EAX_DX_8 DEC_FLAG_BYTE, DecodeEaxDx
-#define ENC_EAX_DX_V 0, DecodeEaxDx
-#define ENC_DX_EAX_8 DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS, DecodeEaxDx
-#define ENC_DX_EAX_V DEC_FLAG_FLIP_OPERANDS, DecodeEaxDx
-#define ENC_3DNOW 0, Decode3DNow
-#define ENC_SSE_TABLE 0, DecodeSSETable
-#define ENC_SSE_TABLE_FLIP DEC_FLAG_FLIP_OPERANDS, DecodeSSETable
-#define ENC_SSE_TABLE_IMM_8 0, DecodeSSETableImm8
-#define ENC_SSE_TABLE_IMM_8_FLIP DEC_FLAG_FLIP_OPERANDS, DecodeSSETableImm8
-#define ENC_SSE_TABLE_INCOP64 DEC_FLAG_INC_OPERATION_FOR_64, DecodeSSETable
-#define ENC_SSE_TABLE_INCOP64_FLIP DEC_FLAG_INC_OPERATION_FOR_64 | DEC_FLAG_FLIP_OPERANDS, DecodeSSETable
-#define ENC_SSE_TABLE_MEM8 0, DecodeSSETableMem8
-#define ENC_SSE_TABLE_MEM8_FLIP DEC_FLAG_FLIP_OPERANDS, DecodeSSETableMem8
-#define ENC_SSE 0, DecodeSSE
-#define ENC_SSE_SINGLE 0, DecodeSSESingle
-#define ENC_SSE_PACKED 0, DecodeSSEPacked
-#define ENC_MMX 0, DecodeMMX
-#define ENC_MMX_SSEONLY 0, DecodeMMXSSEOnly
-#define ENC_MMX_GROUP 0, DecodeMMXGroup
-#define ENC_PINSRW 0, DecodePinsrw
-#define ENC_REG_CR DEC_FLAG_DEFAULT_TO_64BIT | DEC_FLAG_LOCK, DecodeRegCR
-#define ENC_CR_REG DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_DEFAULT_TO_64BIT | DEC_FLAG_LOCK, DecodeRegCR
-#define ENC_MOVSXZX_8 0, DecodeMovSXZX8
-#define ENC_MOVSXZX_16 0, DecodeMovSXZX16
-#define ENC_MEM_16 0, DecodeMem16
-#define ENC_MEM_32 0, DecodeMem32
-#define ENC_MEM_64 0, DecodeMem64
-#define ENC_MEM_80 0, DecodeMem80
-#define ENC_MEM_FLOATENV 0, DecodeMemFloatEnv
-#define ENC_MEM_FLOATSAVE 0, DecodeMemFloatSave
-#define ENC_FPUREG 0, DecodeFPUReg
-#define ENC_ST0_FPUREG DEC_FLAG_FLIP_OPERANDS, DecodeFPURegST0
-#define ENC_FPUREG_ST0 0, DecodeFPURegST0
-#define ENC_REGGROUP_NO_OPERANDS 0, DecodeRegGroupNoOperands
-#define ENC_REGGROUP_AX 0, DecodeRegGroupAX
-#define ENC_CMPXCH8B 0, DecodeCmpXch8B
-#define ENC_MOVNTI 0, DecodeMovNti
-#define ENC_CRC32_8 DEC_FLAG_BYTE, DecodeCrc32
-#define ENC_CRC32_V 0, DecodeCrc32
-#define ENC_ARPL 0, DecodeArpl
+// Instruction encodings, first is flags and second is decoder kind and function
+#ifdef DECODER_KIND_DISPATCH
+#define DECODER(kind, func) DECODE_ ## kind
+#else
+#define DECODER(kind, func) DECODE_ ## kind, func
+#endif
+#define ENC_INVALID 0, DECODER(INVALID, InvalidDecode)
+#define ENC_TWO_BYTE 0, DECODER(TWO_BYTE, DecodeTwoByte)
+#define ENC_FPU 0, DECODER(FPU, DecodeFpu)
+#define ENC_NO_OPERANDS 0, DECODER(NO_OPERANDS, DecodeNoOperands)
+#define ENC_OP_SIZE DEC_FLAG_OPERATION_OP_SIZE, DECODER(NO_OPERANDS, DecodeNoOperands)
+#define ENC_OP_SIZE_DEF64 DEC_FLAG_DEFAULT_TO_64BIT | DEC_FLAG_OPERATION_OP_SIZE, DECODER(NO_OPERANDS, DecodeNoOperands)
+#define ENC_OP_SIZE_NO64 DEC_FLAG_INVALID_IN_64BIT | DEC_FLAG_OPERATION_OP_SIZE, DECODER(NO_OPERANDS, DecodeNoOperands)
+#define ENC_REG_RM_8 DEC_FLAG_BYTE, DECODER(REG_RM, DecodeRegRM)
+#define ENC_RM_REG_8 DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS, DECODER(REG_RM, DecodeRegRM)
+#define ENC_RM_REG_8_LOCK DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_LOCK, DECODER(REG_RM, DecodeRegRM)
+#define ENC_RM_REG_16 DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_FORCE_16BIT, DECODER(REG_RM, DecodeRegRM)
+#define ENC_REG_RM_V 0, DECODER(REG_RM, DecodeRegRM)
+#define ENC_RM_REG_V DEC_FLAG_FLIP_OPERANDS, DECODER(REG_RM, DecodeRegRM)
+#define ENC_RM_REG_V_LOCK DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_LOCK, DECODER(REG_RM, DecodeRegRM)
+#define ENC_REG_RM2X_V DEC_FLAG_REG_RM_2X_SIZE, DECODER(REG_RM, DecodeRegRM)
+#define ENC_REG_RM_IMM_V 0, DECODER(REG_RM_IMM, DecodeRegRMImm)
+#define ENC_REG_RM_IMMSX_V DEC_FLAG_IMM_SX, DECODER(REG_RM_IMM, DecodeRegRMImm)
+#define ENC_REG_RM_0 DEC_FLAG_REG_RM_NO_SIZE, DECODER(REG_RM, DecodeRegRM)
+#define ENC_REG_RM_F DEC_FLAG_REG_RM_FAR_SIZE, DECODER(REG_RM, DecodeRegRM)
+#define ENC_RM_REG_DEF64 DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_DEFAULT_TO_64BIT, DECODER(REG_RM, DecodeRegRM)
+#define ENC_RM_REG_IMM8_V 0, DECODER(RM_REG_IMM8, DecodeRMRegImm8)
+#define ENC_RM_REG_CL_V 0, DECODER(RM_REG_CL, DecodeRMRegCL)
+#define ENC_EAX_IMM_8 DEC_FLAG_BYTE, DECODER(EAX_IMM, DecodeEaxImm)
+#define ENC_EAX_IMM_V 0, DECODER(EAX_IMM, DecodeEaxImm)
+#define ENC_PUSH_POP_SEG 0, DECODER(PUSH_POP_SEG, DecodePushPopSeg)
+#define ENC_OP_REG_V 0, DECODER(OP_REG, DecodeOpReg)
+#define ENC_OP_REG_V_DEF64 DEC_FLAG_DEFAULT_TO_64BIT, DECODER(OP_REG, DecodeOpReg)
+#define ENC_EAX_OP_REG_V 0, DECODER(EAX_OP_REG, DecodeEaxOpReg)
+#define ENC_OP_REG_IMM_8 DEC_FLAG_BYTE, DECODER(OP_REG_IMM, DecodeOpRegImm)
+#define ENC_OP_REG_IMM_V 0, DECODER(OP_REG_IMM, DecodeOpRegImm)
+#define ENC_NOP 0, DECODER(NOP, DecodeNop)
+#define ENC_IMM_V_DEF64 DEC_FLAG_DEFAULT_TO_64BIT, DECODER(IMM, DecodeImm)
+#define ENC_IMMSX_V_DEF64 DEC_FLAG_IMM_SX | DEC_FLAG_DEFAULT_TO_64BIT, DECODER(IMM, DecodeImm)
+#define ENC_IMM_8 DEC_FLAG_BYTE, DECODER(IMM, DecodeImm)
+#define ENC_IMM_16 DEC_FLAG_FORCE_16BIT, DECODER(IMM, DecodeImm)
+#define ENC_IMM16_IMM8 0, DECODER(IMM16_IMM8, DecodeImm16Imm8)
+#define ENC_EDI_DX_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(EDI_DX, DecodeEdiDx)
+#define ENC_EDI_DX_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(EDI_DX, DecodeEdiDx)
+#define ENC_DX_ESI_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(DX_ESI, DecodeDxEsi)
+#define ENC_DX_ESI_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(DX_ESI, DecodeDxEsi)
+#define ENC_RELIMM_8_DEF64 DEC_FLAG_BYTE | DEC_FLAG_DEFAULT_TO_64BIT, DECODER(REL_IMM, DecodeRelImm)
+#define ENC_RELIMM_V_DEF64 DEC_FLAG_DEFAULT_TO_64BIT, DECODER(REL_IMM, DecodeRelImm)
+#define ENC_RELIMM_8_ADDR_SIZE_DEF64 DEC_FLAG_BYTE | DEC_FLAG_DEFAULT_TO_64BIT, DECODER(REL_IMM_ADDR_SIZE, DecodeRelImmAddrSize)
+#define ENC_GROUP_RM_8 DEC_FLAG_BYTE, DECODER(GROUP_RM, DecodeGroupRM)
+#define ENC_GROUP_RM_V 0, DECODER(GROUP_RM, DecodeGroupRM)
+#define ENC_GROUP_RM_8_LOCK DEC_FLAG_BYTE | DEC_FLAG_LOCK, DECODER(GROUP_RM, DecodeGroupRM)
+#define ENC_GROUP_RM_0 DEC_FLAG_REG_RM_NO_SIZE, DECODER(GROUP_RM, DecodeGroupRM)
+#define ENC_GROUP_RM_IMM_8 DEC_FLAG_BYTE, DECODER(GROUP_RM_IMM, DecodeGroupRMImm)
+#define ENC_GROUP_RM_IMM_8_LOCK DEC_FLAG_BYTE | DEC_FLAG_LOCK, DECODER(GROUP_RM_IMM, DecodeGroupRMImm)
+#define ENC_GROUP_RM_IMM_8_NO64_LOCK DEC_FLAG_BYTE | DEC_FLAG_INVALID_IN_64BIT | DEC_FLAG_LOCK, DECODER(GROUP_RM_IMM, DecodeGroupRMImm)
+#define ENC_GROUP_RM_IMM8_V 0, DECODER(GROUP_RM_IMM8_V, DecodeGroupRMImm8V)
+#define ENC_GROUP_RM_IMM_V 0, DECODER(GROUP_RM_IMM, DecodeGroupRMImm)
+#define ENC_GROUP_RM_IMM_V_LOCK DEC_FLAG_LOCK, DECODER(GROUP_RM_IMM, DecodeGroupRMImm)
+#define ENC_GROUP_RM_IMMSX_V_LOCK DEC_FLAG_IMM_SX | DEC_FLAG_LOCK, DECODER(GROUP_RM_IMM, DecodeGroupRMImm)
+#define ENC_GROUP_RM_ONE_8 DEC_FLAG_BYTE, DECODER(GROUP_RM_ONE, DecodeGroupRMOne)
+#define ENC_GROUP_RM_ONE_V 0, DECODER(GROUP_RM_ONE, DecodeGroupRMOne)
+#define ENC_GROUP_RM_CL_8 DEC_FLAG_BYTE, DECODER(GROUP_RM_CL, DecodeGroupRMCl)
+#define ENC_GROUP_RM_CL_V 0, DECODER(GROUP_RM_CL, DecodeGroupRMCl)
+#define ENC_GROUP_F6 DEC_FLAG_BYTE | DEC_FLAG_LOCK, DECODER(GROUP_F6F7, DecodeGroupF6F7)
+#define ENC_GROUP_F7 DEC_FLAG_LOCK, DECODER(GROUP_F6F7, DecodeGroupF6F7)
+#define ENC_GROUP_FF DEC_FLAG_LOCK, DECODER(GROUP_FF, DecodeGroupFF)
+#define ENC_GROUP_0F00 0, DECODER(GROUP_0F00, DecodeGroup0F00)
+#define ENC_GROUP_0F01 0, DECODER(GROUP_0F01, DecodeGroup0F01)
+#define ENC_GROUP_0FAE 0, DECODER(GROUP_0FAE, DecodeGroup0FAE)
+#define ENC_0FB8 0, DECODER(0FB8, Decode0FB8)
+#define ENC_RM_SREG_V 0, DECODER(RM_SREG_V, DecodeRMSRegV)
+#define ENC_SREG_RM_V DEC_FLAG_FLIP_OPERANDS, DECODER(RM_SREG_V, DecodeRMSRegV)
+#define ENC_RM_8 0, DECODER(RM_8, DecodeRM8)
+#define ENC_RM_V_DEF64 DEC_FLAG_DEFAULT_TO_64BIT, DECODER(RM_V, DecodeRMV)
+#define ENC_FAR_IMM_NO64 DEC_FLAG_INVALID_IN_64BIT, DECODER(FAR_IMM, DecodeFarImm)
+#define ENC_EAX_ADDR_8 DEC_FLAG_BYTE, DECODER(EAX_ADDR, DecodeEaxAddr)
+#define ENC_EAX_ADDR_V 0, DECODER(EAX_ADDR, DecodeEaxAddr)
+#define ENC_ADDR_EAX_8 DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS, DECODER(EAX_ADDR, DecodeEaxAddr)
+#define ENC_ADDR_EAX_V DEC_FLAG_FLIP_OPERANDS, DECODER(EAX_ADDR, DecodeEaxAddr)
+#define ENC_EDI_ESI_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(EDI_ESI, DecodeEdiEsi)
+#define ENC_EDI_ESI_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(EDI_ESI, DecodeEdiEsi)
+#define ENC_ESI_EDI_8_REPC DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP_COND, DECODER(EDI_ESI, DecodeEdiEsi)
+#define ENC_ESI_EDI_OP_SIZE_REPC DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP_COND, DECODER(EDI_ESI, DecodeEdiEsi)
+#define ENC_EDI_EAX_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(EDI_EAX, DecodeEdiEax)
+#define ENC_EDI_EAX_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(EDI_EAX, DecodeEdiEax)
+#define ENC_EAX_ESI_8_REP DEC_FLAG_BYTE | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(EAX_ESI, DecodeEaxEsi)
+#define ENC_EAX_ESI_OP_SIZE_REP DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP, DECODER(EAX_ESI, DecodeEaxEsi)
+#define ENC_EAX_EDI_8_REPC DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP_COND, DECODER(EDI_EAX, DecodeEdiEax)
+#define ENC_EAX_EDI_OP_SIZE_REPC DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_OPERATION_OP_SIZE | DEC_FLAG_REP_COND, DECODER(EDI_EAX, DecodeEdiEax)
+#define ENC_AL_EBX_AL 0, DECODER(AL_EBX_AL, DecodeAlEbxAl)
+#define ENC_EAX_IMM8_8 DEC_FLAG_BYTE, DECODER(EAX_IMM8, DecodeEaxImm8)
+#define ENC_EAX_IMM8_V 0, DECODER(EAX_IMM8, DecodeEaxImm8)
+#define ENC_IMM8_EAX_8 DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS, DECODER(EAX_IMM8, DecodeEaxImm8)
+#define ENC_IMM8_EAX_V DEC_FLAG_FLIP_OPERANDS, DECODER(EAX_IMM8, DecodeEaxImm8)
+#define ENC_EAX_DX_8 DEC_FLAG_BYTE, DECODER(EAX_DX, DecodeEaxDx)
+#define ENC_EAX_DX_V 0, DECODER(EAX_DX, DecodeEaxDx)
+#define ENC_DX_EAX_8 DEC_FLAG_BYTE | DEC_FLAG_FLIP_OPERANDS, DECODER(EAX_DX, DecodeEaxDx)
+#define ENC_DX_EAX_V DEC_FLAG_FLIP_OPERANDS, DECODER(EAX_DX, DecodeEaxDx)
+#define ENC_3DNOW 0, DECODER(3DNOW, Decode3DNow)
+#define ENC_SSE_TABLE 0, DECODER(SSE_TABLE, DecodeSSETable)
+#define ENC_SSE_TABLE_FLIP DEC_FLAG_FLIP_OPERANDS, DECODER(SSE_TABLE, DecodeSSETable)
+#define ENC_SSE_TABLE_IMM_8 0, DECODER(SSE_TABLE_IMM8, DecodeSSETableImm8)
+#define ENC_SSE_TABLE_IMM_8_FLIP DEC_FLAG_FLIP_OPERANDS, DECODER(SSE_TABLE_IMM8, DecodeSSETableImm8)
+#define ENC_SSE_TABLE_INCOP64 DEC_FLAG_INC_OPERATION_FOR_64, DECODER(SSE_TABLE, DecodeSSETable)
+#define ENC_SSE_TABLE_INCOP64_FLIP DEC_FLAG_INC_OPERATION_FOR_64 | DEC_FLAG_FLIP_OPERANDS, DECODER(SSE_TABLE, DecodeSSETable)
+#define ENC_SSE_TABLE_MEM8 0, DECODER(SSE_TABLE_MEM8, DecodeSSETableMem8)
+#define ENC_SSE_TABLE_MEM8_FLIP DEC_FLAG_FLIP_OPERANDS, DECODER(SSE_TABLE_MEM8, DecodeSSETableMem8)
+#define ENC_SSE 0, DECODER(SSE, DecodeSSE)
+#define ENC_SSE_SINGLE 0, DECODER(SSE_SINGLE, DecodeSSESingle)
+#define ENC_SSE_PACKED 0, DECODER(SSE_PACKED, DecodeSSEPacked)
+#define ENC_MMX 0, DECODER(MMX, DecodeMMX)
+#define ENC_MMX_SSEONLY 0, DECODER(MMX_SSE_ONLY, DecodeMMXSSEOnly)
+#define ENC_MMX_GROUP 0, DECODER(MMX_GROUP, DecodeMMXGroup)
+#define ENC_PINSRW 0, DECODER(PINSRW, DecodePinsrw)
+#define ENC_REG_CR DEC_FLAG_DEFAULT_TO_64BIT | DEC_FLAG_LOCK, DECODER(REG_CR, DecodeRegCR)
+#define ENC_CR_REG DEC_FLAG_FLIP_OPERANDS | DEC_FLAG_DEFAULT_TO_64BIT | DEC_FLAG_LOCK, DECODER(REG_CR, DecodeRegCR)
+#define ENC_MOVSXZX_8 0, DECODER(MOVSXZX_8, DecodeMovSXZX8)
+#define ENC_MOVSXZX_16 0, DECODER(MOVSXZX_16, DecodeMovSXZX16)
+#define ENC_MEM_16 0, DECODER(MEM_16, DecodeMem16)
+#define ENC_MEM_32 0, DECODER(MEM_32, DecodeMem32)
+#define ENC_MEM_64 0, DECODER(MEM_64, DecodeMem64)
+#define ENC_MEM_80 0, DECODER(MEM_80, DecodeMem80)
+#define ENC_MEM_FLOATENV 0, DECODER(MEM_FLOATENV, DecodeMemFloatEnv)
+#define ENC_MEM_FLOATSAVE 0, DECODER(MEM_FLOATSAVE, DecodeMemFloatSave)
+#define ENC_FPUREG 0, DECODER(FPUREG, DecodeFPUReg)
+#define ENC_ST0_FPUREG DEC_FLAG_FLIP_OPERANDS, DECODER(FPUREG_ST0, DecodeFPURegST0)
+#define ENC_FPUREG_ST0 0, DECODER(FPUREG_ST0, DecodeFPURegST0)
+#define ENC_REGGROUP_NO_OPERANDS 0, DECODER(REGGROUP_NO_OPERANDS, DecodeRegGroupNoOperands)
+#define ENC_REGGROUP_AX 0, DECODER(REGGROUP_AX, DecodeRegGroupAX)
+#define ENC_CMPXCH8B 0, DECODER(CMPXCH8B, DecodeCmpXch8B)
+#define ENC_MOVNTI 0, DECODER(MOVNTI, DecodeMovNti)
+#define ENC_CRC32_8 DEC_FLAG_BYTE, DECODER(CRC32, DecodeCrc32)
+#define ENC_CRC32_V 0, DECODER(CRC32, DecodeCrc32)
+#define ENC_ARPL 0, DECODER(ARPL, DecodeArpl)
 
 
 	struct InstructionEncoding
 	{
 		uint16_t operation;
 		uint16_t flags;
+		uint8_t kind;
+#ifndef DECODER_KIND_DISPATCH
 		DecodingFunction func;
-	};
-#ifndef __cplusplus
-	typedef struct InstructionEncoding InstructionEncoding;
 #endif
-
-	struct SparseInstructionEncoding
-	{
-		uint8_t opcode;
-		InstructionEncoding encoding;
 	};
 #ifndef __cplusplus
-	typedef struct SparseInstructionEncoding SparseInstructionEncoding;
+	typedef struct InstructionEncoding InstructionEncoding;
 #endif
 
 
@@ -442,33 +534,141 @@ namespace x86
 	};
 
 
-	static const SparseInstructionEncoding threeByte0F38Map[] =
-	{
-		{0x00, {PSHUFB, ENC_MMX}}, {0x01, {PHADDW, ENC_MMX}}, {0x02, {PHADDD, ENC_MMX}}, {0x03, {PHADDSW, ENC_MMX}},
-		{0x04, {PMADDUBSW, ENC_MMX}}, {0x05, {PHSUBW, ENC_MMX}}, {0x06, {PHSUBD, ENC_MMX}}, {0x07, {PHSUBSW, ENC_MMX}},
-		{0x08, {PSIGNB, ENC_MMX}}, {0x09, {PSIGNW, ENC_MMX}}, {0x0a, {PSIGND, ENC_MMX}}, {0x0b, {PMULHRSW, ENC_MMX}},
-		{0x10, {PBLENDVB, ENC_MMX_SSEONLY}}, {0x14, {BLENDVPS, ENC_MMX_SSEONLY}}, {0x15, {BLENDVPD, ENC_MMX_SSEONLY}},
-		{0x17, {PTEST, ENC_MMX_SSEONLY}}, {0x1c, {PABSB, ENC_MMX}}, {0x1d, {PABSW, ENC_MMX}}, {0x1e, {PABSD, ENC_MMX}},
-		{0x20, {37, ENC_SSE_TABLE}}, {0x21, {38, ENC_SSE_TABLE}}, {0x22, {39, ENC_SSE_TABLE}}, {0x23, {40, ENC_SSE_TABLE}},
-		{0x24, {41, ENC_SSE_TABLE}}, {0x25, {42, ENC_SSE_TABLE}}, {0x28, {PMULDQ, ENC_MMX_SSEONLY}}, {0x29, {PCMPEQQ, ENC_MMX_SSEONLY}},
-		{0x2a, {43, ENC_SSE_TABLE}}, {0x2b, {PACKUSDW, ENC_MMX_SSEONLY}}, {0x30, {44, ENC_SSE_TABLE}}, {0x31, {45, ENC_SSE_TABLE}},
-		{0x32, {46, ENC_SSE_TABLE}}, {0x33, {47, ENC_SSE_TABLE}}, {0x34, {48, ENC_SSE_TABLE}}, {0x35, {49, ENC_SSE_TABLE}},
-		{0x37, {PCMPGTQ, ENC_MMX_SSEONLY}}, {0x38, {PMINSB, ENC_MMX_SSEONLY}}, {0x39, {PMINSD, ENC_MMX_SSEONLY}},
-		{0x3a, {PMINUW, ENC_MMX_SSEONLY}}, {0x3b, {PMINUD, ENC_MMX_SSEONLY}}, {0x3c, {PMAXSB, ENC_MMX_SSEONLY}},
-		{0x3d, {PMAXSD, ENC_MMX_SSEONLY}}, {0x3e, {PMAXUW, ENC_MMX_SSEONLY}}, {0x3f, {PMAXUD, ENC_MMX_SSEONLY}},
-		{0x40, {PMULLD, ENC_MMX_SSEONLY}}, {0x41, {PHMINPOSUW, ENC_MMX_SSEONLY}}, {0xf0, {CRC32, ENC_CRC32_8}}, {0xf1, {CRC32, ENC_CRC32_V}}
+	static const InstructionEncoding threeByte0F38Map[256] =
+	{
+		{PSHUFB, ENC_MMX}, {PHADDW, ENC_MMX}, {PHADDD, ENC_MMX}, {PHADDSW, ENC_MMX}, // 0x00
+		{PMADDUBSW, ENC_MMX}, {PHSUBW, ENC_MMX}, {PHSUBD, ENC_MMX}, {PHSUBSW, ENC_MMX}, // 0x04
+		{PSIGNB, ENC_MMX}, {PSIGNW, ENC_MMX}, {PSIGND, ENC_MMX}, {PMULHRSW, ENC_MMX}, // 0x08
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x0c
+		{PBLENDVB, ENC_MMX_SSEONLY}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x10
+		{BLENDVPS, ENC_MMX_SSEONLY}, {BLENDVPD, ENC_MMX_SSEONLY}, {INVALID, ENC_INVALID}, {PTEST, ENC_MMX_SSEONLY}, // 0x14
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x18
+		{PABSB, ENC_MMX}, {PABSW, ENC_MMX}, {PABSD, ENC_MMX}, {INVALID, ENC_INVALID}, // 0x1c
+		{37, ENC_SSE_TABLE}, {38, ENC_SSE_TABLE}, {39, ENC_SSE_TABLE}, {40, ENC_SSE_TABLE}, // 0x20
+		{41, ENC_SSE_TABLE}, {42, ENC_SSE_TABLE}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x24
+		{PMULDQ, ENC_MMX_SSEONLY}, {PCMPEQQ, ENC_MMX_SSEONLY}, {43, ENC_SSE_TABLE}, {PACKUSDW, ENC_MMX_SSEONLY}, // 0x28
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x2c
+		{44, ENC_SSE_TABLE}, {45, ENC_SSE_TABLE}, {46, ENC_SSE_TABLE}, {47, ENC_SSE_TABLE}, // 0x30
+		{48, ENC_SSE_TABLE}, {49, ENC_SSE_TABLE}, {INVALID, ENC_INVALID}, {PCMPGTQ, ENC_MMX_SSEONLY}, // 0x34
+		{PMINSB, ENC_MMX_SSEONLY}, {PMINSD, ENC_MMX_SSEONLY}, {PMINUW, ENC_MMX_SSEONLY}, {PMINUD, ENC_MMX_SSEONLY}, // 0x38
+		{PMAXSB, ENC_MMX_SSEONLY}, {PMAXSD, ENC_MMX_SSEONLY}, {PMAXUW, ENC_MMX_SSEONLY}, {PMAXUD, ENC_MMX_SSEONLY}, // 0x3c
+		{PMULLD, ENC_MMX_SSEONLY}, {PHMINPOSUW, ENC_MMX_SSEONLY}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x40
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x44
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x48
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x4c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x50
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x54
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x58
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x5c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x60
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x64
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x68
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x6c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x70
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x74
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x78
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x7c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x80
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x84
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x88
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x8c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x90
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x94
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x98
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x9c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xa0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xa4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xa8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xac
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xb0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xb4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xb8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xbc
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xc0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xc4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xc8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xcc
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xd0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xd4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xd8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xdc
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xe0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xe4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xe8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xec
+		{CRC32, ENC_CRC32_8}, {CRC32, ENC_CRC32_V}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xf0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xf4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xf8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID} // 0xfc
 	};
 
 
-	static const SparseInstructionEncoding threeByte0F3AMap[] =
-	{
-		{0x08, {ROUNDPS, ENC_MMX_SSEONLY}}, {0x09, {ROUNDPD, ENC_MMX_SSEONLY}}, {0x0a, {50, ENC_SSE_TABLE}}, {0x0b, {51, ENC_SSE_TABLE}},
-		{0x0c, {BLENDPS, ENC_MMX_SSEONLY}}, {0x0d, {BLENDPD, ENC_MMX_SSEONLY}}, {0x0e, {PBLENDW, ENC_MMX_SSEONLY}}, {0x0f, {PALIGNR, ENC_MMX}},
-		{0x14, {52, ENC_SSE_TABLE_MEM8_FLIP}}, {0x15, {53, ENC_SSE_TABLE_FLIP}}, {0x16, {54, ENC_SSE_TABLE_INCOP64_FLIP}},
-		{0x17, {55, ENC_SSE_TABLE_FLIP}}, {0x20, {56, ENC_SSE_TABLE_MEM8}}, {0x21, {57, ENC_SSE_TABLE}}, {0x22, {58, ENC_SSE_TABLE_INCOP64}},
-		{0x40, {DPPS, ENC_MMX_SSEONLY}}, {0x41, {DPPD, ENC_MMX_SSEONLY}}, {0x42, {MPSADBW, ENC_MMX_SSEONLY}},
-		{0x60, {PCMPESTRM, ENC_MMX_SSEONLY}}, {0x61, {PCMPESTRI, ENC_MMX_SSEONLY}}, {0x62, {PCMPISTRM, ENC_MMX_SSEONLY}},
-		{0x63, {PCMPISTRI, ENC_MMX_SSEONLY}}
+	static const InstructionEncoding threeByte0F3AMap[256] =
+	{
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x00
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x04
+		{ROUNDPS, ENC_MMX_SSEONLY}, {ROUNDPD, ENC_MMX_SSEONLY}, {50, ENC_SSE_TABLE}, {51, ENC_SSE_TABLE}, // 0x08
+		{BLENDPS, ENC_MMX_SSEONLY}, {BLENDPD, ENC_MMX_SSEONLY}, {PBLENDW, ENC_MMX_SSEONLY}, {PALIGNR, ENC_MMX}, // 0x0c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x10
+		{52, ENC_SSE_TABLE_MEM8_FLIP}, {53, ENC_SSE_TABLE_FLIP}, {54, ENC_SSE_TABLE_INCOP64_FLIP}, {55, ENC_SSE_TABLE_FLIP}, // 0x14
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x18
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x1c
+		{56, ENC_SSE_TABLE_MEM8}, {57, ENC_SSE_TABLE}, {58, ENC_SSE_TABLE_INCOP64}, {INVALID, ENC_INVALID}, // 0x20
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x24
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x28
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x2c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x30
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x34
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x38
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x3c
+		{DPPS, ENC_MMX_SSEONLY}, {DPPD, ENC_MMX_SSEONLY}, {MPSADBW, ENC_MMX_SSEONLY}, {INVALID, ENC_INVALID}, // 0x40
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x44
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x48
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x4c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x50
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x54
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x58
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x5c
+		{PCMPESTRM, ENC_MMX_SSEONLY}, {PCMPESTRI, ENC_MMX_SSEONLY}, {PCMPISTRM, ENC_MMX_SSEONLY}, {PCMPISTRI, ENC_MMX_SSEONLY}, // 0x60
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x64
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x68
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x6c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x70
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x74
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x78
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x7c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x80
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x84
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x88
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x8c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x90
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x94
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x98
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0x9c
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xa0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xa4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xa8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xac
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xb0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xb4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xb8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xbc
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xc0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xc4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xc8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xcc
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xd0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xd4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xd8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xdc
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xe0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xe4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xe8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xec
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xf0
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xf4
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, // 0xf8
+		{INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID}, {INVALID, ENC_INVALID} // 0xfc
 	};
 
 
@@ -881,23 +1081,40 @@ namespace x86
 	};
 
 
-	struct SparseOpEntry
-	{
-		uint8_t opcode;
-		uint16_t operation;
-	};
-#ifndef __cplusplus
-	typedef struct SparseOpEntry SparseOpEntry;
-#endif
-
-	static const SparseOpEntry sparse3DNowOpcodes[] =
-	{
-		{0x0c, PI2FW}, {0x0d, PI2FD},
-		{0x1c, PF2IW}, {0x1d, PF2ID},
-		{0x86, PFRCPV}, {0x87, PFRSQRTV}, {0x8a, PFNACC}, {0x8e, PFPNACC},
-		{0x90, PFCMPGE}, {0x94, PFMIN}, {0x96, PFRCP}, {0x97, PFRSQRT}, {0x9a, PFSUB}, {0x9e, PFADD},
-		{0xa0, PFCMPGT}, {0xa4, PFMAX}, {0xa6, PFRCPIT1}, {0xa7, PFRSQIT1}, {0xaa, PFSUBR}, {0xae, PFACC},
-		{0xb0, PFCMPEQ}, {0xb4, PFMUL}, {0xb6, PFRCPIT2}, {0xb7, PMULHRW}, {0xbb, PSWAPD}, {0xbf, PAVGUSB}
+	static const uint16_t threeDNowOpcodeMap[256] =
+	{
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x00
+		INVALID, INVALID, INVALID, INVALID, PI2FW, PI2FD, INVALID, INVALID, // 0x08
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x10
+		INVALID, INVALID, INVALID, INVALID, PF2IW, PF2ID, INVALID, INVALID, // 0x18
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x20
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x28
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x30
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x38
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x40
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x48
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x50
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x58
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x60
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x68
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x70
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0x78
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, PFRCPV, PFRSQRTV, // 0x80
+		INVALID, INVALID, PFNACC, INVALID, INVALID, INVALID, PFPNACC, INVALID, // 0x88
+		PFCMPGE, INVALID, INVALID, INVALID, PFMIN, INVALID, PFRCP, PFRSQRT, // 0x90
+		INVALID, INVALID, PFSUB, INVALID, INVALID, INVALID, PFADD, INVALID, // 0x98
+		PFCMPGT, INVALID, INVALID, INVALID, PFMAX, INVALID, PFRCPIT1, PFRSQIT1, // 0xa0
+		INVALID, INVALID, PFSUBR, INVALID, INVALID, INVALID, PFACC, INVALID, // 0xa8
+		PFCMPEQ, INVALID, INVALID, INVALID, PFMUL, INVALID, PFRCPIT2, PMULHRW, // 0xb0
+		INVALID, INVALID, INVALID, PSWAPD, INVALID, INVALID, INVALID, PAVGUSB, // 0xb8
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0xc0
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0xc8
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0xd0
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0xd8
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0xe0
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0xe8
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, // 0xf0
+		INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID, INVALID // 0xf8
 	};
 
 
@@ -930,1583 +1147,2752 @@ namespace x86
 #endif
 
 
-	static const RegDef* GetByteRegList(DecodeState* state)
+	// Decoder core, either as a single decoder that checks the processor mode at runtime or as three
+	// copies that are each specialized for one processor mode. Each decoder is followed by its copy
+	// without bounds checks on reads.
+#ifdef ASMX86_MODE_SPECIALIZED
+#define __ASMX86DEC_16BIT
+#include "asmx86dec.h"
+#define __ASMX86DEC_UNCHECKED
+#include "asmx86dec.h"
+#undef __ASMX86DEC_UNCHECKED
+#undef __ASMX86DEC_16BIT
+
+#define __ASMX86DEC_32BIT
+#include "asmx86dec.h"
+#define __ASMX86DEC_UNCHECKED
+#include "asmx86dec.h"
+#undef __ASMX86DEC_UNCHECKED
+#undef __ASMX86DEC_32BIT
+
+#define __ASMX86DEC_64BIT
+#include "asmx86dec.h"
+#define __ASMX86DEC_UNCHECKED
+#include "asmx86dec.h"
+#undef __ASMX86DEC_UNCHECKED
+#undef __ASMX86DEC_64BIT
+
+#define DECODER_16(n) Mode16 ## n
+#define DECODER_32(n) Mode32 ## n
+#define DECODER_64(n) Mode64 ## n
+#else
+#include "asmx86dec.h"
+#define __ASMX86DEC_UNCHECKED
+#include "asmx86dec.h"
+#undef __ASMX86DEC_UNCHECKED
+
+#define DECODER_16(n) n
+#define DECODER_32(n) n
+#define DECODER_64(n) n
+#endif
+
+
+	bool Disassemble16(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result)
 	{
-		if (state->rex)
-			return reg8List64;
-		return reg8List;
+		DecodeState state;
+		state.result = result;
+		state.opcodeStart = opcode;
+		state.opcode = opcode;
+		state.addr = addr;
+		state.len = (maxLen > 15) ? 15 : maxLen;
+		state.addrSize = 2;
+		state.opSize = 2;
+		state.using64 = false;
+		return DECODER_16(DecodeInstruction)(&state);
 	}
 
 
-	static const RegDef* GetRegListForOpSize(DecodeState* state)
+	bool Disassemble32(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result)
 	{
-		switch (state->opSize)
-		{
-		case 2:
-			return reg16List;
-		case 4:
-			return reg32List;
-		case 8:
-			return reg64List;
-		default:
-			return NULL;
-		}
+		DecodeState state;
+		state.result = result;
+		state.opcodeStart = opcode;
+		state.opcode = opcode;
+		state.addr = addr;
+		state.len = (maxLen > 15) ? 15 : maxLen;
+		state.addrSize = 4;
+		state.opSize = 4;
+		state.using64 = false;
+		return DECODER_32(DecodeInstruction)(&state);
 	}
 
 
-	static const RegDef* GetRegListForFinalOpSize(DecodeState* state)
+	bool Disassemble64(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result)
 	{
-		switch (state->finalOpSize)
-		{
-		case 1:
-			return GetByteRegList(state);
-		case 2:
-			return reg16List;
-		case 4:
-			return reg32List;
-		case 8:
-			return reg64List;
-		default:
-			return NULL;
-		}
+		DecodeState state;
+		state.result = result;
+		state.opcodeStart = opcode;
+		state.opcode = opcode;
+		state.addr = addr;
+		state.len = (maxLen > 15) ? 15 : maxLen;
+		state.addrSize = 8;
+		state.opSize = 4;
+		state.using64 = true;
+		return DECODER_64(DecodeInstruction)(&state);
 	}
 
 
-	static const RegDef* GetRegListForAddrSize(DecodeState* state)
+	// Finds the parts of a decoded instruction from the positions recorded by the decoder. The parts
+	// always appear in the order prefixes, opcode, ModRM, SIB, displacement, immediate, so only the
+	// start of the opcode and the extent of the ModRM bytes need to be known.
+	static void GetEncodingInfo(const DecodeState* state, InstructionEncodingInfo* encoding)
 	{
-		switch (state->addrSize)
+		const Instruction* instr = state->result;
+		const uint8_t* start = state->opcodeStart;
+		size_t opcodeOffset = (size_t)(state->body - start);
+		size_t immStart, immEnd = instr->length;
+
+		memset(encoding, 0, sizeof(InstructionEncodingInfo));
+		encoding->prefixLength = (uint8_t)opcodeOffset;
+		if (state->rex)
 		{
-		case 2:
-			return reg16List;
-		case 4:
-			return reg32List;
-		case 8:
-			return reg64List;
-		default:
-			return NULL;
+			encoding->flags |= X86_ENCODING_REX;
+			encoding->rex = state->body[-1];
 		}
-	}
 
+		encoding->opcodeMap = X86_OPCODE_MAP_PRIMARY;
+		if (start[opcodeOffset] == 0x0f)
+		{
+			switch (start[opcodeOffset + 1])
+			{
+			case 0x38:
+				encoding->opcodeMap = X86_OPCODE_MAP_0F38;
+				opcodeOffset += 2;
+				break;
+			case 0x3a:
+				encoding->opcodeMap = X86_OPCODE_MAP_0F3A;
+				opcodeOffset += 2;
+				break;
+			case 0x0f:
+				// 3DNow! operations are selected by the last byte of the instruction
+				encoding->opcodeMap = X86_OPCODE_MAP_3DNOW;
+				opcodeOffset = instr->length - 1;
+				immEnd = opcodeOffset;
+				break;
+			default:
+				encoding->opcodeMap = X86_OPCODE_MAP_0F;
+				opcodeOffset++;
+				break;
+			}
+		}
+		encoding->opcodeOffset = (uint8_t)opcodeOffset;
+		encoding->opcode = start[opcodeOffset];
+		immStart = (encoding->opcodeMap == X86_OPCODE_MAP_3DNOW) ? (encoding->prefixLength + 2) : (opcodeOffset + 1);
 
-	static uint16_t GetFinalOpSize(DecodeState* state)
-	{
-		if (state->flags & DEC_FLAG_BYTE)
-			return 1;
-		return state->opSize;
-	}
-
+		if (state->modRM)
+		{
+			encoding->flags |= X86_ENCODING_MODRM;
+			encoding->modRMOffset = (uint8_t)(state->modRM - start);
+			immStart = encoding->modRMOffset + 1;
 
-	static uint8_t Read8(DecodeState* state)
-	{
-		uint8_t val;
+			// Instructions that only use the ModRM byte to select registers do not record its end
+			if (state->modRMEnd)
+			{
+				uint8_t modRM = *state->modRM;
+				size_t dispStart = immStart;
+				if (((modRM & 0xc0) != 0xc0) && ((modRM & 7) == 4) && (state->addrSize != 2))
+				{
+					encoding->flags |= X86_ENCODING_SIB;
+					encoding->sibOffset = (uint8_t)dispStart++;
+				}
+				immStart = (size_t)(state->modRMEnd - start);
+				if (immStart > dispStart)
+				{
+					encoding->displacementOffset = (uint8_t)dispStart;
+					encoding->displacementSize = (uint8_t)(immStart - dispStart);
+				}
+			}
+		}
+		else
+		{
+			// Moves between the accumulator and a fixed address have the address in place of the
+			// immediate, and it is a displacement
+			for (size_t i = 0; i < 2; i++)
+			{
+				if ((instr->operands[i].operand == MEM) && (instr->operands[i].components[0] == NONE))
+				{
+					encoding->displacementOffset = (uint8_t)immStart;
+					encoding->displacementSize = (uint8_t)(immEnd - immStart);
+					immStart = immEnd;
+					break;
+				}
+			}
+		}
 
-		if (state->len < 1)
+		if (immEnd > immStart)
 		{
-			// Read past end of buffer, returning 0xcc from now on will guarantee exit
-			state->invalid = true;
-			state->insufficientLength = true;
-			state->len = 0;
-			return 0xcc;
+			encoding->immediateOffset = (uint8_t)immStart;
+			encoding->immediateSize = (uint8_t)(immEnd - immStart);
 		}
 
-		val = *(state->opcode++);
-		state->len--;
-		return val;
+		for (size_t i = 0; i < 3; i++)
+		{
+			if (instr->operands[i].relative)
+				encoding->flags |= X86_ENCODING_RIP_RELATIVE;
+		}
+		if ((X86OperationAttributes[instr->operation] & (X86_OP_BRANCH | X86_OP_CALL)) &&
+			(instr->operation != JMPF) && (instr->operation != CALLF) && (instr->operands[0].operand == IMM))
+			encoding->flags |= X86_ENCODING_RELATIVE_BRANCH;
 	}
 
 
-	static uint8_t Peek8(DecodeState* state)
+	bool DisassembleWithEncoding16(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result,
+		InstructionEncodingInfo* encoding)
 	{
-		uint8_t val;
-
-		if (state->len < 1)
+		DecodeState state;
+		state.result = result;
+		state.opcodeStart = opcode;
+		state.opcode = opcode;
+		state.addr = addr;
+		state.len = (maxLen > 15) ? 15 : maxLen;
+		state.addrSize = 2;
+		state.opSize = 2;
+		state.using64 = false;
+		if (!DECODER_16(DecodeInstruction)(&state))
 		{
-			// Read past end of buffer, returning 0xcc from now on will guarantee exit
-			state->invalid = true;
-			state->insufficientLength = true;
-			state->len = 0;
-			return 0xcc;
+			memset(encoding, 0, sizeof(InstructionEncodingInfo));
+			return false;
 		}
-
-		val = *state->opcode;
-		return val;
+		GetEncodingInfo(&state, encoding);
+		return true;
 	}
 
 
-	static uint16_t Read16(DecodeState* state)
+	bool DisassembleWithEncoding32(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result,
+		InstructionEncodingInfo* encoding)
 	{
-		uint16_t val;
-
-		if (state->len < 2)
+		DecodeState state;
+		state.result = result;
+		state.opcodeStart = opcode;
+		state.opcode = opcode;
+		state.addr = addr;
+		state.len = (maxLen > 15) ? 15 : maxLen;
+		state.addrSize = 4;
+		state.opSize = 4;
+		state.using64 = false;
+		if (!DECODER_32(DecodeInstruction)(&state))
 		{
-			// Read past end of buffer
-			state->invalid = true;
-			state->insufficientLength = true;
-			state->len = 0;
-			return 0;
+			memset(encoding, 0, sizeof(InstructionEncodingInfo));
+			return false;
 		}
-
-		val = *((uint16_t*)state->opcode);
-		state->opcode += 2;
-		state->len -= 2;
-		return val;
+		GetEncodingInfo(&state, encoding);
+		return true;
 	}
 
 
-	static uint32_t Read32(DecodeState* state)
+	bool DisassembleWithEncoding64(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result,
+		InstructionEncodingInfo* encoding)
 	{
-		uint32_t val;
-
-		if (state->len < 4)
+		DecodeState state;
+		state.result = result;
+		state.opcodeStart = opcode;
+		state.opcode = opcode;
+		state.addr = addr;
+		state.len = (maxLen > 15) ? 15 : maxLen;
+		state.addrSize = 8;
+		state.opSize = 4;
+		state.using64 = true;
+		if (!DECODER_64(DecodeInstruction)(&state))
 		{
-			// Read past end of buffer
-			state->invalid = true;
-			state->insufficientLength = true;
-			state->len = 0;
-			return 0;
+			memset(encoding, 0, sizeof(InstructionEncodingInfo));
+			return false;
 		}
-
-		val = *((uint32_t*)state->opcode);
-		state->opcode += 4;
-		state->len -= 4;
-		return val;
+		GetEncodingInfo(&state, encoding);
+		return true;
 	}
 
 
-	static uint64_t Read64(DecodeState* state)
+	typedef bool (*DecodeInstructionFunction)(DecodeState* state);
+
+	static size_t DisassembleBlock(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+		size_t maxCount, size_t* nextOffset, uint16_t addrSize, uint16_t opSize, bool using64,
+		DecodeInstructionFunction decode)
 	{
-		uint64_t val;
+		DecodeState state;
+		size_t offset = 0;
+		size_t count = 0;
 
-		if (state->len < 8)
+		state.using64 = using64;
+		while ((count < maxCount) && (offset < len))
 		{
-			// Read past end of buffer
-			state->invalid = true;
-			state->insufficientLength = true;
-			state->len = 0;
-			return 0;
+			size_t remaining = len - offset;
+			state.result = &results[count];
+			state.opcodeStart = &opcode[offset];
+			state.opcode = state.opcodeStart;
+			state.addr = addr + offset;
+			state.len = (remaining > 15) ? 15 : remaining;
+			state.addrSize = addrSize;
+			state.opSize = opSize;
+			if (!decode(&state))
+				break;
+
+			offset += state.result->length;
+			count++;
 		}
 
-		val = *((uint64_t*)state->opcode);
-		state->opcode += 8;
-		state->len -= 8;
-		return val;
+		if (nextOffset)
+			*nextOffset = offset;
+		return count;
 	}
 
 
-	static int64_t ReadSigned8(DecodeState* state)
+	size_t DisassembleBlock16(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+		size_t maxCount, size_t* nextOffset)
 	{
-		return (int64_t)(int8_t)Read8(state);
+		return DisassembleBlock(opcode, addr, len, results, maxCount, nextOffset, 2, 2, false, DECODER_16(DecodeInstruction));
 	}
 
 
-	static int64_t ReadSigned16(DecodeState* state)
+	size_t DisassembleBlock32(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+		size_t maxCount, size_t* nextOffset)
 	{
-		return (int64_t)(int16_t)Read16(state);
+		return DisassembleBlock(opcode, addr, len, results, maxCount, nextOffset, 4, 4, false, DECODER_32(DecodeInstruction));
 	}
 
 
-	static int64_t ReadSigned32(DecodeState* state)
+	size_t DisassembleBlock64(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+		size_t maxCount, size_t* nextOffset)
 	{
-		return (int64_t)(int32_t)Read32(state);
+		return DisassembleBlock(opcode, addr, len, results, maxCount, nextOffset, 8, 4, true, DECODER_64(DecodeInstruction));
 	}
 
 
-	static int64_t ReadFinalOpSize(DecodeState* state)
+	static void InitDecoder(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len, uint8_t mode)
 	{
-		if (state->flags & DEC_FLAG_IMM_SX)
-			return ReadSigned8(state);
-		switch (state->finalOpSize)
-		{
-		case 1:
-			return Read8(state);
-		case 2:
-			return Read16(state);
-		case 4:
-			return Read32(state);
-		case 8:
-			return ReadSigned32(state);
-		}
-		return 0;
+		decoder->mode = mode;
+		decoder->lastResult = NULL;
+		SetDecoderPosition(decoder, opcode, addr, len);
 	}
 
 
-	static int64_t ReadAddrSize(DecodeState* state)
+	void InitDecoder16(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len)
 	{
-		switch (state->addrSize)
-		{
-		case 2:
-			return Read16(state);
-		case 4:
-		case 8:
-			return Read32(state);
-		}
-		return 0;
+		InitDecoder(decoder, opcode, addr, len, 16);
 	}
 
 
-	static int64_t ReadSignedFinalOpSize(DecodeState* state)
+	void InitDecoder32(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len)
 	{
-		switch (state->finalOpSize)
-		{
-		case 1:
-			return ReadSigned8(state);
-		case 2:
-			return ReadSigned16(state);
-		case 4:
-		case 8:
-			return ReadSigned32(state);
-		}
-		return 0;
+		InitDecoder(decoder, opcode, addr, len, 32);
 	}
 
 
-	static void UpdateOperationForAddrSize(DecodeState* state)
+	void InitDecoder64(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len)
 	{
-		if (state->addrSize == 4)
-			state->result->operation = (InstructionOperation)(state->result->operation + 1);
-		else if (state->addrSize == 8)
-			state->result->operation = (InstructionOperation)(state->result->operation + 2);
+		InitDecoder(decoder, opcode, addr, len, 64);
 	}
 
 
-	static void ProcessEncoding(DecodeState* state, const InstructionEncoding* encoding)
+	void SetDecoderPosition(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len)
 	{
-		state->result->operation = (InstructionOperation)encoding->operation;
-
-		state->flags = encoding->flags;
-		if (state->using64 && (state->flags & DEC_FLAG_INVALID_IN_64BIT))
-		{
-			state->invalid = true;
-			return;
-		}
-		if (state->using64 && (state->flags & DEC_FLAG_DEFAULT_TO_64BIT))
-			state->opSize = state->opPrefix ? 4 : 8;
-		state->finalOpSize = GetFinalOpSize(state);
-
-		if (state->flags & DEC_FLAG_FLIP_OPERANDS)
-		{
-			state->operand0 = &state->result->operands[1];
-			state->operand1 = &state->result->operands[0];
-		}
-		else
-		{
-			state->operand0 = &state->result->operands[0];
-			state->operand1 = &state->result->operands[1];
-		}
+		decoder->opcode = opcode;
+		decoder->addr = addr;
+		decoder->len = len;
+	}
 
-		if (state->flags & DEC_FLAG_FORCE_16BIT)
-			state->finalOpSize = 2;
 
-		if (state->flags & DEC_FLAG_OPERATION_OP_SIZE)
-		{
-			if (state->finalOpSize == 4)
-				state->result->operation = (InstructionOperation)(state->result->operation + 1);
-			else if (state->finalOpSize == 8)
-				state->result->operation = (InstructionOperation)(state->result->operation + 2);
-		}
+	bool DecodeNext(X86Decoder* decoder, Instruction* result)
+	{
+		DecodeState state;
+		bool reused = (result == decoder->lastResult);
+		bool valid;
 
-		if (state->flags & DEC_FLAG_REP)
-		{
-			if (state->rep != REP_PREFIX_NONE)
-				state->result->flags |= X86_FLAG_REP;
-		}
-		else if (state->flags & DEC_FLAG_REP_COND)
+		state.result = result;
+		state.opcodeStart = decoder->opcode;
+		state.opcode = decoder->opcode;
+		state.addr = decoder->addr;
+		state.len = (decoder->len > 15) ? 15 : decoder->len;
+		switch (decoder->mode)
 		{
-			if (state->rep == REP_PREFIX_REPNE)
-				state->result->flags |= X86_FLAG_REPNE;
-			else if (state->rep == REP_PREFIX_REPE)
-				state->result->flags |= X86_FLAG_REPE;
+		case 16:
+			state.addrSize = 2;
+			state.opSize = 2;
+			state.using64 = false;
+			valid = reused ? DECODER_16(DecodeNextInstruction)(&state) : DECODER_16(DecodeInstruction)(&state);
+			break;
+		case 32:
+			state.addrSize = 4;
+			state.opSize = 4;
+			state.using64 = false;
+			valid = reused ? DECODER_32(DecodeNextInstruction)(&state) : DECODER_32(DecodeInstruction)(&state);
+			break;
+		default:
+			state.addrSize = 8;
+			state.opSize = 4;
+			state.using64 = true;
+			valid = reused ? DECODER_64(DecodeNextInstruction)(&state) : DECODER_64(DecodeInstruction)(&state);
+			break;
 		}
+		decoder->lastResult = result;
 
-		encoding->func(state);
-
-		if (state->result->operation == INVALID)
-			state->invalid = true;
-
-		if (state->result->flags & X86_FLAG_LOCK)
+		if (valid)
 		{
-			// Ensure instruction allows lock and it has proper semantics
-			if (!(state->flags & DEC_FLAG_LOCK))
-				state->invalid = true;
-			else if (state->result->operation == CMP)
-				state->invalid = true;
-			else if ((state->result->operands[0].operand != MEM) && (state->result->operands[1].operand != MEM))
-				state->invalid = true;
+			decoder->opcode += result->length;
+			decoder->addr += result->length;
+			decoder->len -= result->length;
 		}
+		return valid;
 	}
 
 
-	static void ProcessOpcode(DecodeState* state, const InstructionEncoding* map, uint8_t opcode)
+	static void InitStreamDecoder(X86StreamDecoder* decoder, uint64_t addr, uint8_t mode)
 	{
-		ProcessEncoding(state, &map[opcode]);
+		decoder->input = NULL;
+		decoder->inputLen = 0;
+		decoder->addr = addr;
+		decoder->pendingLen = 0;
+		decoder->mode = mode;
 	}
 
 
-	static void ProcessSparseOpcode(DecodeState* state, const SparseInstructionEncoding* map, size_t mapSize, uint8_t opcode)
+	void InitStreamDecoder16(X86StreamDecoder* decoder, uint64_t addr)
 	{
-		int i, min, max;
-		state->result->operation = INVALID;
-		for (min = 0, max = (int)mapSize - 1, i = (min + max) / 2;
-			min <= max; i = (min + max) / 2)
-		{
-			if (opcode > map[i].opcode)
-				min = i + 1;
-			else if (opcode < map[i].opcode)
-				max = i - 1;
-			else
-			{
-				ProcessEncoding(state, &map[i].encoding);
-				break;
-			}
-		}
+		InitStreamDecoder(decoder, addr, 16);
 	}
 
 
-	static SegmentRegister GetFinalSegment(DecodeState* state, SegmentRegister seg)
+	void InitStreamDecoder32(X86StreamDecoder* decoder, uint64_t addr)
 	{
-		return (state->result->segment == SEG_DEFAULT) ? seg : state->result->segment;
+		InitStreamDecoder(decoder, addr, 32);
 	}
 
 
-	static void SetMemOperand(DecodeState* state, InstructionOperand* oper, const RMDef* def, int64_t immed)
+	void InitStreamDecoder64(X86StreamDecoder* decoder, uint64_t addr)
 	{
-		oper->operand = MEM;
-		oper->components[0] = def->first;
-		oper->components[1] = def->second;
-		oper->immediate = immed;
-		oper->segment = GetFinalSegment(state, def->segment);
+		InitStreamDecoder(decoder, addr, 64);
 	}
 
 
-	static void DecodeRM(DecodeState* state, InstructionOperand* rmOper, const RegDef* regList, uint16_t rmSize, uint8_t* regOper)
+	void SetStreamInput(X86StreamDecoder* decoder, const uint8_t* chunk, size_t len)
 	{
-		uint8_t rmByte = Read8(state);
-		uint8_t mod = rmByte >> 6;
-		uint8_t rm = rmByte & 7;
-		InstructionOperand temp;
-
-		if (regOper)
-			*regOper = (rmByte >> 3) & 7;
+		decoder->input = chunk;
+		decoder->inputLen = len;
+	}
 
-		if (!rmOper)
-			rmOper = &temp;
 
-		rmOper->size = rmSize;
-		if (state->addrSize == 2)
+	static bool DecodeStreamInstruction(uint8_t mode, const uint8_t* opcode, uint64_t addr, size_t len,
+		Instruction* result)
+	{
+		switch (mode)
 		{
-			static const RMDef rm16Components[9] = {{REG_BX, REG_SI, SEG_DS}, {REG_BX, REG_DI, SEG_DS},
-				{REG_BP, REG_SI, SEG_SS}, {REG_BP, REG_DI, SEG_SS}, {REG_SI, NONE, SEG_DS},
-				{REG_DI, NONE, SEG_DS}, {REG_BP, NONE, SEG_SS}, {REG_BX, NONE, SEG_DS},
-				{NONE, NONE, SEG_DS}};
-			switch (mod)
-			{
-			case 0:
-				if (rm == 6)
-				{
-					rm = 8;
-					SetMemOperand(state, rmOper, &rm16Components[rm], Read16(state));
-				}
-				else
-					SetMemOperand(state, rmOper, &rm16Components[rm], 0);
-				break;
-			case 1:
-				SetMemOperand(state, rmOper, &rm16Components[rm], ReadSigned8(state));
-				break;
-			case 2:
-				SetMemOperand(state, rmOper, &rm16Components[rm], ReadSigned16(state));
-				break;
-			case 3:
-				rmOper->operand = (OperandType)regList[rm];
-				break;
-			}
-			if (rmOper->components[0] == NONE)
-				rmOper->immediate &= 0xffff;
+		case 16:
+			return Disassemble16(opcode, addr, len, result);
+		case 32:
+			return Disassemble32(opcode, addr, len, result);
+		default:
+			return Disassemble64(opcode, addr, len, result);
 		}
-		else
+	}
+
+
+	size_t DecodeStream(X86StreamDecoder* decoder, Instruction* results, uint64_t* addrs, size_t maxCount,
+		bool* invalid)
+	{
+		size_t count = 0;
+
+		if (invalid)
+			*invalid = false;
+		while (count < maxCount)
 		{
-			const RegDef* addrRegList = GetRegListForAddrSize(state);
-			uint8_t rmReg1Offset = state->rexRM1 ? 8 : 0;
-			uint8_t rmReg2Offset = state->rexRM2 ? 8 : 0;
-			SegmentRegister seg = SEG_DEFAULT;
-			rmOper->operand = MEM;
-			if ((mod != 3) && (rm == 4))
+			Instruction* result = &results[count];
+			uint8_t joined[X86_MAX_INSTRUCTION_LENGTH];
+			const uint8_t* opcode;
+			size_t available;
+			size_t fromInput;
+
+			if (decoder->pendingLen != 0)
 			{
-				// SIB byte present
-				uint8_t sibByte = Read8(state);
-				uint8_t base = sibByte & 7;
-				uint8_t index = (sibByte >> 3) & 7;
-				rmOper->scale = 1 << (sibByte >> 6);
-				if ((mod != 0) || (base != 5))
-					rmOper->components[0] = (OperandType)addrRegList[base + rmReg1Offset];
-				if ((index + rmReg2Offset) != 4)
-					rmOper->components[1] = (OperandType)addrRegList[index + rmReg2Offset];
-				switch (mod)
-				{
-				case 0:
-					if (base == 5)
-						rmOper->immediate = ReadSigned32(state);
-					break;
-				case 1:
-					rmOper->immediate = ReadSigned8(state);
-					break;
-				case 2:
-					rmOper->immediate = ReadSigned32(state);
-					break;
-				}
-				if (((base + rmReg1Offset) == 4) || ((base + rmReg1Offset) == 5))
-					seg = SEG_SS;
-				else
-					seg = SEG_DS;
+				// The instruction starts in the bytes left over from the previous chunk, so join them
+				// with the start of this chunk
+				fromInput = X86_MAX_INSTRUCTION_LENGTH - decoder->pendingLen;
+				if (fromInput > decoder->inputLen)
+					fromInput = decoder->inputLen;
+				memcpy(joined, decoder->pending, decoder->pendingLen);
+				memcpy(&joined[decoder->pendingLen], decoder->input, fromInput);
+				opcode = joined;
+				available = decoder->pendingLen + fromInput;
 			}
 			else
 			{
-				switch (mod)
-				{
-				case 0:
-					if (rm == 5)
-					{
-						rmOper->immediate = ReadSigned32(state);
-						if (state->addrSize == 8)
-						{
-							state->ripRelFixup = &rmOper->immediate;
-							rmOper->relative = true;
-						}
-					}
-					else
-						rmOper->components[0] = (OperandType)addrRegList[rm + rmReg1Offset];
-					seg = SEG_DS;
-					break;
-				case 1:
-					rmOper->components[0] = (OperandType)addrRegList[rm + rmReg1Offset];
-					rmOper->immediate = ReadSigned8(state);
-					seg = (rm == 5) ? SEG_SS : SEG_DS;
+				if (decoder->inputLen == 0)
 					break;
-				case 2:
-					rmOper->components[0] = (OperandType)addrRegList[rm + rmReg1Offset];
-					rmOper->immediate = ReadSigned32(state);
-					seg = (rm == 5) ? SEG_SS : SEG_DS;
-					break;
-				case 3:
-					rmOper->operand = (OperandType)regList[rm + rmReg1Offset];
+				opcode = decoder->input;
+				available = decoder->inputLen;
+				fromInput = (available > X86_MAX_INSTRUCTION_LENGTH) ? X86_MAX_INSTRUCTION_LENGTH : available;
+			}
+
+			if (!DecodeStreamInstruction(decoder->mode, opcode, decoder->addr, available, result))
+			{
+				if ((result->flags & X86_FLAG_INSUFFICIENT_LENGTH) && (fromInput == decoder->inputLen))
+				{
+					// The rest of the instruction is in the next chunk. Keep the bytes that are here
+					// until it arrives.
+					memcpy(&decoder->pending[decoder->pendingLen], decoder->input, decoder->inputLen);
+					decoder->pendingLen += (uint8_t)decoder->inputLen;
+					decoder->input += decoder->inputLen;
+					decoder->inputLen = 0;
 					break;
 				}
-			}
-			if (seg != SEG_DEFAULT)
-				rmOper->segment = GetFinalSegment(state, seg);
-		}
-	}
 
+				if (invalid)
+					*invalid = true;
+				break;
+			}
 
-	static void DecodeRMReg(DecodeState* state, InstructionOperand* rmOper, const RegDef* rmRegList, uint16_t rmSize,
-		InstructionOperand* regOper, const RegDef* regList, uint16_t regSize)
-	{
-		uint8_t reg;
-		DecodeRM(state, rmOper, rmRegList, rmSize, &reg);
-		if (regOper)
-		{
-			uint8_t regOffset = state->rexReg ? 8 : 0;
-			regOper->size = regSize;
-			regOper->operand = (OperandType)regList[reg + regOffset];
+			if (addrs)
+				addrs[count] = decoder->addr;
+			decoder->addr += result->length;
+			if (result->length < decoder->pendingLen)
+			{
+				decoder->pendingLen -= (uint8_t)result->length;
+				memmove(decoder->pending, &decoder->pending[result->length], decoder->pendingLen);
+			}
+			else
+			{
+				fromInput = result->length - decoder->pendingLen;
+				decoder->pendingLen = 0;
+				decoder->input += fromInput;
+				decoder->inputLen -= fromInput;
+			}
+			count++;
 		}
-	}
 
-
-	static void SetOperandToEsEdi(DecodeState* state, InstructionOperand* oper, uint16_t size)
-	{
-		const RegDef* addrRegList = GetRegListForAddrSize(state);
-		oper->operand = MEM;
-		oper->components[0] = (OperandType)addrRegList[7];
-		oper->size = size;
-		oper->segment = SEG_ES;
-	}
-
-
-	static void SetOperandToDsEsi(DecodeState* state, InstructionOperand* oper, uint16_t size)
-	{
-		const RegDef* addrRegList = GetRegListForAddrSize(state);
-		oper->operand = MEM;
-		oper->components[0] = (OperandType)addrRegList[6];
-		oper->size = size;
-		oper->segment = GetFinalSegment(state, SEG_DS);
-	}
-
-
-	static void SetOperandToImmAddr(DecodeState* state, InstructionOperand* oper)
-	{
-		oper->operand = MEM;
-		oper->immediate = ReadAddrSize(state);
-		oper->segment = GetFinalSegment(state, SEG_DS);
-		oper->size = state->finalOpSize;
+		return count;
 	}
 
 
-	static void SetOperandToEaxFinalOpSize(DecodeState* state, InstructionOperand* oper)
+	void SkipStreamBytes(X86StreamDecoder* decoder, size_t count)
 	{
-		const RegDef* regList = GetRegListForFinalOpSize(state);
-		oper->operand = (OperandType)regList[0];
-		oper->size = state->finalOpSize;
-	}
-
+		size_t fromPending = (count > decoder->pendingLen) ? decoder->pendingLen : count;
+		size_t fromInput = count - fromPending;
 
-	static void SetOperandToOpReg(DecodeState* state, InstructionOperand* oper)
-	{
-		const RegDef* regList = GetRegListForFinalOpSize(state);
-		uint8_t regOffset = state->rexRM1 ? 8 : 0;
-		oper->operand = (OperandType)regList[(state->opcode[-1] & 7) + regOffset];
-		oper->size = state->finalOpSize;
+		if (fromInput > decoder->inputLen)
+			fromInput = decoder->inputLen;
+		decoder->pendingLen -= (uint8_t)fromPending;
+		memmove(decoder->pending, &decoder->pending[fromPending], decoder->pendingLen);
+		decoder->input += fromInput;
+		decoder->inputLen -= fromInput;
+		decoder->addr += fromPending + fromInput;
 	}
 
 
-	static void SetOperandToImm(DecodeState* state, InstructionOperand* oper)
+	void InitDecodeCache(X86DecodeCache* cache, X86DecodeCacheEntry* entries, size_t entryCount)
 	{
-		oper->operand = IMM;
-		oper->size = state->finalOpSize;
-		oper->immediate = ReadFinalOpSize(state);
+		// Round down to a power of two so that the entry index is a mask of the address
+		while (entryCount & (entryCount - 1))
+			entryCount &= entryCount - 1;
+		cache->entries = entries;
+		cache->entryCount = entryCount;
+		cache->mode = 0;
+		cache->hits = 0;
+		cache->misses = 0;
+		ClearDecodeCache(cache);
 	}
 
 
-	static void SetOperandToImm8(DecodeState* state, InstructionOperand* oper)
+	void ClearDecodeCache(X86DecodeCache* cache)
 	{
-		oper->operand = IMM;
-		oper->size = 1;
-		oper->immediate = Read8(state);
+		for (size_t i = 0; i < cache->entryCount; i++)
+			cache->entries[i].instr.length = 0;
 	}
 
 
-	static void SetOperandToImm16(DecodeState* state, InstructionOperand* oper)
+	void InvalidateDecodeCacheRange(X86DecodeCache* cache, uint64_t addr, size_t len)
 	{
-		oper->operand = IMM;
-		oper->size = 2;
-		oper->immediate = Read16(state);
-	}
+		// Instructions starting up to one byte short of the maximum length before the range can
+		// still overlap it
+		uint64_t start = (addr > X86_MAX_INSTRUCTION_LENGTH) ? (addr - (X86_MAX_INSTRUCTION_LENGTH - 1)) : 0;
+		uint64_t end = addr + len;
+		if (end < addr)
+			end = UINT64_MAX;
 
-
-	static uint8_t DecodeSSEPrefix(DecodeState* state)
-	{
-		if (state->opPrefix)
-		{
-			state->opPrefix = false;
-			return 1;
-		}
-		else if (state->rep == REP_PREFIX_REPNE)
+		if ((end - start) < cache->entryCount)
 		{
-			state->rep = REP_PREFIX_NONE;
-			return 2;
+			// Only the entries that these addresses map to can hold an overlapping instruction
+			for (uint64_t cur = start; cur < end; cur++)
+			{
+				X86DecodeCacheEntry* entry = &cache->entries[cur & (cache->entryCount - 1)];
+				if ((entry->addr < end) && ((entry->addr + entry->instr.length) > addr))
+					entry->instr.length = 0;
+			}
 		}
-		else if (state->rep == REP_PREFIX_REPE)
+		else
 		{
-			state->rep = REP_PREFIX_NONE;
-			return 3;
+			for (size_t i = 0; i < cache->entryCount; i++)
+			{
+				X86DecodeCacheEntry* entry = &cache->entries[i];
+				if ((entry->addr < end) && ((entry->addr + entry->instr.length) > addr))
+					entry->instr.length = 0;
+			}
 		}
-		return 0;
 	}
 
 
-	static uint16_t GetSizeForSSEType(uint8_t type)
+	void InvalidateDecodeCachePage(X86DecodeCache* cache, uint64_t addr)
 	{
-		if (type == 2)
-			return 8;
-		if (type == 3)
-			return 4;
-		return 16;
+		InvalidateDecodeCacheRange(cache, addr & ~(uint64_t)(X86_DECODE_CACHE_PAGE_SIZE - 1),
+			X86_DECODE_CACHE_PAGE_SIZE);
 	}
 
 
-	static InstructionOperand* GetOperandForSSEEntryType(DecodeState* state, uint16_t type, uint8_t operandIndex)
+	static bool CachedDisassemble(X86DecodeCache* cache, const uint8_t* opcode, uint64_t addr, size_t maxLen,
+		Instruction* result, uint8_t mode)
 	{
-		if (type == SSE_128_FLIP)
-			operandIndex = 1 - operandIndex;
-		if (operandIndex == 0)
-			return state->operand0;
-		return state->operand1;
-	}
+		X86DecodeCacheEntry* entry;
 
-
-	static const RegDef* GetRegListForSSEEntryType(DecodeState* state, uint16_t type)
-	{
-		switch (type)
+		if (cache->entryCount == 0)
 		{
-		case MMX_32:
-		case MMX_64:
-			return mmxRegList;
-		case GPR_32_OR_64:
-			return (state->opSize == 8) ? reg64List : reg32List;
-		default:
-			return xmmRegList;
+			cache->misses++;
+			return DecodeStreamInstruction(mode, opcode, addr, maxLen, result);
 		}
-	}
-
 
-	static uint16_t GetSizeForSSEEntryType(DecodeState* state, uint16_t type)
-	{
-		switch (type)
+		// Entries decoded in a different processor mode are not valid in this one
+		if (cache->mode != mode)
 		{
-		case SSE_16:
-			return 2;
-		case SSE_32:
-		case MMX_32:
-			return 4;
-		case SSE_64:
-		case MMX_64:
-			return 8;
-		case GPR_32_OR_64:
-			return (state->opSize == 8) ? 8 : 4;
-		default:
-			return 16;
+			ClearDecodeCache(cache);
+			cache->mode = mode;
 		}
-	}
 
+		entry = &cache->entries[addr & (cache->entryCount - 1)];
+		if ((entry->addr == addr) && (entry->instr.length != 0) && (entry->instr.length <= maxLen))
+		{
+			cache->hits++;
+			*result = entry->instr;
+			return true;
+		}
 
-	static void UpdateOperationForSSEEntryType(DecodeState* state, uint16_t type)
-	{
-		if ((type == GPR_32_OR_64) && (state->opSize == 8))
-			state->result->operation = (InstructionOperation)((int)state->result->operation + 1);
+		cache->misses++;
+		if (!DecodeStreamInstruction(mode, opcode, addr, maxLen, result))
+			return false;
+		entry->addr = addr;
+		entry->instr = *result;
+		return true;
 	}
 
 
-	static void InvalidDecode(DecodeState* state)
+	bool CachedDisassemble16(X86DecodeCache* cache, const uint8_t* opcode, uint64_t addr, size_t maxLen,
+		Instruction* result)
 	{
-		state->invalid = true;
+		return CachedDisassemble(cache, opcode, addr, maxLen, result, 16);
 	}
 
 
-	static void DecodeTwoByte(DecodeState* state)
+	bool CachedDisassemble32(X86DecodeCache* cache, const uint8_t* opcode, uint64_t addr, size_t maxLen,
+		Instruction* result)
 	{
-		uint8_t opcode = Read8(state);
-		if (opcode == 0x38)
-			ProcessSparseOpcode(state, threeByte0F38Map, sizeof(threeByte0F38Map) / sizeof(SparseInstructionEncoding), Read8(state));
-		else if (opcode == 0x3a)
-		{
-			ProcessSparseOpcode(state, threeByte0F3AMap, sizeof(threeByte0F3AMap) / sizeof(SparseInstructionEncoding), Read8(state));
-			SetOperandToImm8(state, &state->result->operands[2]);
-		}
-		else
-			ProcessOpcode(state, twoByteOpcodeMap, opcode);
+		return CachedDisassemble(cache, opcode, addr, maxLen, result, 32);
 	}
 
 
-	static void DecodeFpu(DecodeState* state)
+	bool CachedDisassemble64(X86DecodeCache* cache, const uint8_t* opcode, uint64_t addr, size_t maxLen,
+		Instruction* result)
 	{
-		uint8_t modRM = Peek8(state);
-		uint8_t reg = (modRM >> 3) & 7;
-		uint8_t op = (uint8_t)state->result->operation;
-
-		const InstructionEncoding* map;
-		if ((modRM & 0xc0) == 0xc0)
-			map = fpuRegOpcodeMap[op];
-		else
-			map = fpuMemOpcodeMap[op];
-		ProcessEncoding(state, &map[reg]);
+		return CachedDisassemble(cache, opcode, addr, maxLen, result, 64);
 	}
 
 
-	static void DecodeNoOperands(DecodeState* state)
-	{
-	}
+	// Operand sizes produced by the decoder, indexed by the 4-bit size codes of a packed instruction.
+	// Sizes not in this table are stored in the value table instead.
+	static const uint16_t packedOperandSizes[] = {0, 1, 2, 4, 6, 8, 10, 14, 16, 28, 94, 108, 512};
 
+	// Size codes of the sizes below 32 bytes, which are nearly all operands, so that they are found
+	// without searching packedOperandSizes
+#define PACKED_SIZE_CODE_NONE		0xff
+#define PACKED_SMALL_SIZE_LIMIT		32
+#define PACKED_FIRST_LARGE_SIZE		10
+	static const uint8_t packedSmallSizeCodes[PACKED_SMALL_SIZE_LIMIT] =
+	{
+		0, 1, 2, PACKED_SIZE_CODE_NONE, 3, PACKED_SIZE_CODE_NONE, 4, PACKED_SIZE_CODE_NONE,
+		5, PACKED_SIZE_CODE_NONE, 6, PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE, 7,
+		PACKED_SIZE_CODE_NONE, 8, PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE,
+		PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE,
+		PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE, 9,
+		PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE, PACKED_SIZE_CODE_NONE
+	};
 
-	static void DecodeRegRM(DecodeState* state)
+	static bool GetPackedSizeCode(uint16_t size, uint16_t* code)
 	{
-		uint16_t size = state->finalOpSize;
-		const RegDef* regList = GetRegListForFinalOpSize(state);
-		switch (state->flags & DEC_FLAG_REG_RM_SIZE_MASK)
+		if (size < PACKED_SMALL_SIZE_LIMIT)
 		{
-		case 0:
-			break;
-		case DEC_FLAG_REG_RM_2X_SIZE:
-			size *= 2;
-			break;
-		case DEC_FLAG_REG_RM_FAR_SIZE:
-			size += 2;
-			break;
-		case DEC_FLAG_REG_RM_NO_SIZE:
-			size = 0;
-			break;
+			if (packedSmallSizeCodes[size] == PACKED_SIZE_CODE_NONE)
+				return false;
+			*code = packedSmallSizeCodes[size];
+			return true;
 		}
-
-		DecodeRMReg(state, state->operand1, regList, size, state->operand0, regList, state->finalOpSize);
-
-		if ((size != state->finalOpSize) && (state->operand1->operand != MEM))
-			state->invalid = true;
-	}
-
-
-	static void DecodeRegRMImm(DecodeState* state)
-	{
-		const RegDef* regList = GetRegListForFinalOpSize(state);
-		DecodeRMReg(state, state->operand1, regList, state->finalOpSize, state->operand0, regList, state->finalOpSize);
-		SetOperandToImm(state, &state->result->operands[2]);
+		for (uint16_t i = PACKED_FIRST_LARGE_SIZE; i < sizeof(packedOperandSizes) / sizeof(packedOperandSizes[0]); i++)
+		{
+			if (packedOperandSizes[i] == size)
+			{
+				*code = i;
+				return true;
+			}
+		}
+		return false;
 	}
 
 
-	static void DecodeRMRegImm8(DecodeState* state)
+	static bool GetPackedScale(uint8_t scale, uint8_t* result)
 	{
-		const RegDef* regList = GetRegListForFinalOpSize(state);
-		DecodeRMReg(state, state->operand0, regList, state->finalOpSize, state->operand1, regList, state->finalOpSize);
-		SetOperandToImm8(state, &state->result->operands[2]);
+		switch (scale)
+		{
+		case 1:
+			*result = 0;
+			return true;
+		case 2:
+			*result = 1;
+			return true;
+		case 4:
+			*result = 2;
+			return true;
+		case 8:
+			*result = 3;
+			return true;
+		default:
+			return false;
+		}
 	}
 
 
-	static void DecodeRMRegCL(DecodeState* state)
+	static bool PackMemoryOperand(const InstructionOperand* oper, uint8_t* components, uint8_t* memory)
 	{
-		const RegDef* regList = GetRegListForFinalOpSize(state);
-		DecodeRMReg(state, state->operand0, regList, state->finalOpSize, state->operand1, regList, state->finalOpSize);
-		state->result->operands[2].operand = REG_CL;
-		state->result->operands[2].size = 1;
+		uint8_t scale;
+		if (!GetPackedScale(oper->scale, &scale))
+			return false;
+		components[0] = (uint8_t)oper->components[0];
+		components[1] = (uint8_t)oper->components[1];
+		*memory = scale | (uint8_t)((oper->segment & 7) << PACKED_MEM_SEGMENT_SHIFT);
+		if (oper->relative)
+			*memory |= PACKED_MEM_RELATIVE;
+		return true;
 	}
 
 
-	static void DecodeEaxImm(DecodeState* state)
+	static void UnpackMemoryOperand(InstructionOperand* oper, const uint8_t* components, uint8_t memory)
 	{
-		SetOperandToEaxFinalOpSize(state, state->operand0);
-		SetOperandToImm(state, state->operand1);
+		oper->components[0] = (OperandType)components[0];
+		oper->components[1] = (OperandType)components[1];
+		oper->scale = (uint8_t)(1 << (memory & PACKED_MEM_SCALE_MASK));
+		oper->segment = (SegmentRegister)((memory >> PACKED_MEM_SEGMENT_SHIFT) & 7);
+		oper->relative = (memory & PACKED_MEM_RELATIVE) != 0;
 	}
 
 
-	static void DecodePushPopSeg(DecodeState* state)
-	{
-		int8_t offset = 0;
-		if (state->opcode[-1] >= 0xa0) // FS/GS
-			offset = -16;
-		state->operand0->operand = (OperandType)(REG_ES + (state->opcode[-1] >> 3) + offset);
-		state->operand0->size = state->opSize;
-	}
+	bool PackInstruction(const Instruction* instr, PackedInstruction* packed, int64_t* values, size_t maxValues,
+		size_t* valueCount)
+	{
+		int64_t extra[2];
+		size_t extraCount = 0;
+		size_t valueIndex = *valueCount;
+		size_t needed = 0;
+		uint16_t sizes = 0;
+		uint64_t rawSizes = 0;
+		bool sizesInValues = false;
+		bool foundMem = false;
+
+		if ((instr->length > PACKED_LENGTH_MASK) || (instr->operation > 0xffff) ||
+			(instr->flags & ~(PACKED_PREFIX_FLAGS_MASK | X86_FLAG_INSUFFICIENT_LENGTH)))
+			return false;
+
+		packed->operation = (uint16_t)instr->operation;
+		packed->length = (uint8_t)instr->length | (uint8_t)((instr->segment & 7) << PACKED_SEGMENT_SHIFT);
+		if (instr->flags & X86_FLAG_INSUFFICIENT_LENGTH)
+			packed->length |= PACKED_INSUFFICIENT_LENGTH;
+		packed->flags = (uint8_t)(instr->flags & PACKED_PREFIX_FLAGS_MASK);
+		packed->components[0] = NONE;
+		packed->components[1] = NONE;
+		packed->memory = 0;
+
+		for (size_t i = 0; i < 3; i++)
+		{
+			const InstructionOperand* oper = &instr->operands[i];
+			uint16_t code = 0;
 
+			packed->operands[i] = (uint8_t)oper->operand;
+			if (oper->operand == NONE)
+				continue;
 
-	static void DecodeOpReg(DecodeState* state)
-	{
-		SetOperandToOpReg(state, state->operand0);
-	}
+			if ((oper->operand != MEM) && ((oper->components[0] != NONE) || (oper->components[1] != NONE) ||
+				(oper->scale != 1) || oper->relative))
+				return false;
 
+			if (oper->operand == MEM)
+			{
+				if (!foundMem)
+				{
+					if (!PackMemoryOperand(oper, packed->components, &packed->memory))
+						return false;
+					foundMem = true;
+				}
+				else
+				{
+					// A second memory operand (only used by string instructions) is stored in the value table
+					uint8_t components[2];
+					uint8_t memory;
+					if (packed->flags & PACKED_MEM2_IN_VALUES)
+						return false;
+					if (!PackMemoryOperand(oper, components, &memory))
+						return false;
+					packed->flags |= PACKED_MEM2_IN_VALUES;
+					extra[extraCount++] = (int64_t)(components[0] | ((uint32_t)components[1] << 8) |
+						((uint32_t)memory << 16));
+				}
+			}
 
-	static void DecodeEaxOpReg(DecodeState* state)
-	{
-		SetOperandToEaxFinalOpSize(state, state->operand0);
-		SetOperandToOpReg(state, state->operand1);
-	}
+			if (!GetPackedSizeCode(oper->size, &code))
+				sizesInValues = true;
+			sizes |= (uint16_t)(code << (i * PACKED_SIZE_CODE_BITS));
+			rawSizes |= (uint64_t)oper->size << (i * 16);
 
+			if (((oper->operand == IMM) || (oper->operand == MEM)) && (oper->immediate != 0))
+			{
+				sizes |= (uint16_t)(1 << (PACKED_VALUE_PRESENT_SHIFT + i));
+				needed++;
+			}
+		}
 
-	static void DecodeOpRegImm(DecodeState* state)
-	{
-		SetOperandToOpReg(state, state->operand0);
-		state->operand1->operand = IMM;
-		state->operand1->size = state->finalOpSize;
-		state->operand1->immediate = (state->opSize == 8) ? Read64(state) : ReadFinalOpSize(state);
-	}
+		if (sizesInValues)
+		{
+			// Sizes come first in the value table, before the second memory operand
+			if (extraCount)
+				extra[1] = extra[0];
+			extra[0] = (int64_t)rawSizes;
+			extraCount++;
+			packed->flags |= PACKED_SIZES_IN_VALUES;
+			sizes &= ~((1 << PACKED_VALUE_PRESENT_SHIFT) - 1);
+		}
+		packed->sizes = sizes;
 
+		needed += extraCount;
+		if ((valueIndex > maxValues) || (needed > (maxValues - valueIndex)) || ((valueIndex + needed) > 0xffffffff))
+			return false;
 
-	static void DecodeNop(DecodeState* state)
-	{
-		if (state->rexRM1)
+		packed->values = (uint32_t)valueIndex;
+		for (size_t i = 0; i < extraCount; i++)
+			values[valueIndex++] = extra[i];
+		for (size_t i = 0; i < 3; i++)
 		{
-			state->result->operation = XCHG;
-			DecodeEaxOpReg(state);
+			if (sizes & (1 << (PACKED_VALUE_PRESENT_SHIFT + i)))
+				values[valueIndex++] = instr->operands[i].immediate;
 		}
+		*valueCount = valueIndex;
+		return true;
 	}
 
 
-	static void DecodeImm(DecodeState* state)
+	void UnpackInstruction(const PackedInstruction* packed, const int64_t* values, Instruction* result)
 	{
-		SetOperandToImm(state, state->operand0);
-	}
-
+		const int64_t* value = &values[packed->values];
+		uint64_t rawSizes = 0;
+		bool foundMem = false;
 
-	static void DecodeImm16Imm8(DecodeState* state)
-	{
-		SetOperandToImm16(state, state->operand0);
-		SetOperandToImm8(state, state->operand1);
-	}
+		result->operation = (InstructionOperation)packed->operation;
+		result->length = packed->length & PACKED_LENGTH_MASK;
+		result->segment = (SegmentRegister)((packed->length >> PACKED_SEGMENT_SHIFT) & 7);
+		result->flags = packed->flags & PACKED_PREFIX_FLAGS_MASK;
+		if (packed->length & PACKED_INSUFFICIENT_LENGTH)
+			result->flags |= X86_FLAG_INSUFFICIENT_LENGTH;
 
+		if (packed->flags & PACKED_SIZES_IN_VALUES)
+			rawSizes = (uint64_t)*(value++);
 
-	static void DecodeEdiDx(DecodeState* state)
-	{
-		SetOperandToEsEdi(state, state->operand0, state->finalOpSize);
-		state->operand1->operand = REG_DX;
-		state->operand1->size = 2;
-	}
+		for (size_t i = 0; i < 3; i++)
+		{
+			InstructionOperand* oper = &result->operands[i];
+			oper->operand = (OperandType)packed->operands[i];
+			oper->components[0] = NONE;
+			oper->components[1] = NONE;
+			oper->scale = 1;
+			oper->immediate = 0;
+			oper->segment = SEG_DEFAULT;
+			oper->relative = false;
+			if (oper->operand == NONE)
+			{
+				oper->size = 0;
+				continue;
+			}
 
+			if (packed->flags & PACKED_SIZES_IN_VALUES)
+				oper->size = (uint16_t)(rawSizes >> (i * 16));
+			else
+				oper->size = packedOperandSizes[(packed->sizes >> (i * PACKED_SIZE_CODE_BITS)) & PACKED_SIZE_CODE_MASK];
 
-	static void DecodeDxEsi(DecodeState* state)
-	{
-		state->operand0->operand = REG_DX;
-		state->operand0->size = 2;
-		SetOperandToDsEsi(state, state->operand1, state->finalOpSize);
-	}
+			if (oper->operand == MEM)
+			{
+				if (!foundMem)
+				{
+					UnpackMemoryOperand(oper, packed->components, packed->memory);
+					foundMem = true;
+				}
+				else
+				{
+					uint8_t components[2];
+					uint64_t mem = (uint64_t)*(value++);
+					components[0] = (uint8_t)mem;
+					components[1] = (uint8_t)(mem >> 8);
+					UnpackMemoryOperand(oper, components, (uint8_t)(mem >> 16));
+				}
+			}
+		}
 
+		for (size_t i = 0; i < 3; i++)
+		{
+			if (packed->sizes & (1 << (PACKED_VALUE_PRESENT_SHIFT + i)))
+				result->operands[i].immediate = *(value++);
+		}
 
-	static void DecodeRelImm(DecodeState* state)
-	{
-		state->operand0->operand = IMM;
-		state->operand0->size = state->opSize;
-		state->operand0->immediate = ReadSignedFinalOpSize(state);
-		state->operand0->immediate += state->addr + (state->opcode - state->opcodeStart);
+		// Operand access is not stored, as it follows from the operation and operands
+		SetOperandAccess(result);
 	}
 
 
-	static void DecodeRelImmAddrSize(DecodeState* state)
+	static size_t DisassemblePackedBlock(const uint8_t* opcode, uint64_t addr, size_t len, PackedInstruction* results,
+		size_t maxCount, int64_t* values, size_t maxValues, size_t* valueCount, size_t* nextOffset,
+		uint16_t addrSize, uint16_t opSize, bool using64, DecodeInstructionFunction decode,
+		DecodeInstructionFunction decodeNext)
 	{
-		DecodeRelImm(state);
-		UpdateOperationForAddrSize(state);
-	}
-
+		Instruction instr;
+		DecodeState state;
+		size_t offset = 0;
+		size_t count = 0;
 
-	static void DecodeGroupRM(DecodeState* state)
-	{
-		const RegDef* regList = GetRegListForFinalOpSize(state);
-		uint8_t regField;
-		DecodeRM(state, state->operand0, regList, state->finalOpSize, &regField);
-		state->result->operation = (InstructionOperation)groupOperations[(int)state->result->operation][regField];
-	}
+		// Instructions are decoded into the same scratch Instruction, which stays in cache, and then packed
+		state.result = &instr;
+		state.using64 = using64;
+		while ((count < maxCount) && (offset < len))
+		{
+			size_t remaining = len - offset;
+			state.opcodeStart = &opcode[offset];
+			state.opcode = state.opcodeStart;
+			state.addr = addr + offset;
+			state.len = (remaining > 15) ? 15 : remaining;
+			state.addrSize = addrSize;
+			state.opSize = opSize;
+			if (!((count == 0) ? decode(&state) : decodeNext(&state)))
+				break;
+			if (!PackInstruction(&instr, &results[count], values, maxValues, valueCount))
+				break;
 
+			offset += instr.length;
+			count++;
+		}
 
-	static void DecodeGroupRMImm(DecodeState* state)
-	{
-		DecodeGroupRM(state);
-		SetOperandToImm(state, state->operand1);
+		if (nextOffset)
+			*nextOffset = offset;
+		return count;
 	}
 
 
-	static void DecodeGroupRMImm8V(DecodeState* state)
+	size_t DisassemblePackedBlock16(const uint8_t* opcode, uint64_t addr, size_t len, PackedInstruction* results,
+		size_t maxCount, int64_t* values, size_t maxValues, size_t* valueCount, size_t* nextOffset)
 	{
-		DecodeGroupRM(state);
-		SetOperandToImm8(state, state->operand1);
+		return DisassemblePackedBlock(opcode, addr, len, results, maxCount, values, maxValues, valueCount, nextOffset,
+			2, 2, false, DECODER_16(DecodeInstruction), DECODER_16(DecodeNextInstruction));
 	}
 
 
-	static void DecodeGroupRMOne(DecodeState* state)
+	size_t DisassemblePackedBlock32(const uint8_t* opcode, uint64_t addr, size_t len, PackedInstruction* results,
+		size_t maxCount, int64_t* values, size_t maxValues, size_t* valueCount, size_t* nextOffset)
 	{
-		DecodeGroupRM(state);
-		state->operand1->operand = IMM;
-		state->operand1->size = 1;
-		state->operand1->immediate = 1;
+		return DisassemblePackedBlock(opcode, addr, len, results, maxCount, values, maxValues, valueCount, nextOffset,
+			4, 4, false, DECODER_32(DecodeInstruction), DECODER_32(DecodeNextInstruction));
 	}
 
 
-	static void DecodeGroupRMCl(DecodeState* state)
+	size_t DisassemblePackedBlock64(const uint8_t* opcode, uint64_t addr, size_t len, PackedInstruction* results,
+		size_t maxCount, int64_t* values, size_t maxValues, size_t* valueCount, size_t* nextOffset)
 	{
-		DecodeGroupRM(state);
-		state->operand1->operand = REG_CL;
-		state->operand1->size = 1;
+		return DisassemblePackedBlock(opcode, addr, len, results, maxCount, values, maxValues, valueCount, nextOffset,
+			8, 4, true, DECODER_64(DecodeInstruction), DECODER_64(DecodeNextInstruction));
 	}
 
 
-	static void DecodeGroupF6F7(DecodeState* state)
+	uint64_t GetRegisterMask(OperandType reg)
 	{
-		DecodeGroupRM(state);
-		if (state->result->operation == TEST)
-			SetOperandToImm(state, state->operand1);
-		// Check for valid locking semantics
-		if ((state->result->flags & X86_FLAG_LOCK) && (state->result->operation != NOT) && (state->result->operation != NEG))
-			state->invalid = true;
+		if (((size_t)reg >= sizeof(operandRegisterBit)) || (operandRegisterBit[reg] == 0xff))
+			return 0;
+		return (uint64_t)1 << operandRegisterBit[reg];
 	}
 
 
-	static void DecodeGroupFF(DecodeState* state)
+	void GetRegisterMasks(const Instruction* instr, X86RegisterMasks* masks)
 	{
-		if (state->using64)
+		InstructionOperation operation = instr->operation;
+		uint64_t read;
+		uint64_t written;
+
+		// The string forms of movsd and cmpsd have two memory operands, and use the implicit registers
+		// of the other sizes of string operation
+		if ((instr->operands[0].operand == MEM) && (instr->operands[1].operand == MEM))
 		{
-			// Default to 64-bit for jumps and calls
-			uint8_t rm = Peek8(state);
-			uint8_t regField = (rm >> 3) & 7;
-			if ((regField >= 2) && (regField <= 5))
-				state->finalOpSize = state->opSize = state->opPrefix ? 4 : 8;
-			else if (regField == 6)
-				state->finalOpSize = state->opSize = 8; // Prefix doesn't matter for 64 bit push
+			if (operation == MOVSD)
+				operation = MOVSB;
+			else if (operation == CMPSD)
+				operation = CMPSB;
 		}
-		DecodeGroupRM(state);
-		// Check for valid far jump/call semantics
-		if ((state->result->operation == CALLF) || (state->result->operation == JMPF))
+
+		read = implicitRegisterMasks[operationImplicitRegisters[operation]].read;
+		written = implicitRegisterMasks[operationImplicitRegisters[operation]].written;
+
+		switch (operation)
 		{
-			if (state->operand0->operand != MEM)
-				state->invalid = true;
-			state->operand0->size += 2;
+		case IMUL:
+			if (instr->operands[1].operand != NONE)
+			{
+				// Two and three operand forms only have explicit operands
+				read = 0;
+				written = X86_REG_MASK_FLAGS;
+				break;
+			}
+			// Fall through
+		case MUL:
+		case DIV:
+		case IDIV:
+			// The byte sized forms use ax alone
+			if (instr->operands[0].size == 1)
+			{
+				read &= ~X86_REG_MASK_RDX;
+				written &= ~X86_REG_MASK_RDX;
+			}
+			break;
+		default:
+			break;
 		}
-		// Check for valid locking semantics
-		if ((state->result->flags & X86_FLAG_LOCK) && (state->result->operation != INC) && (state->result->operation != DEC))
-			state->invalid = true;
-	}
 
+		if ((instr->flags & X86_FLAG_ANY_REP) && (X86OperationAttributes[operation] & X86_OP_STRING))
+		{
+			read |= X86_REG_MASK_RCX;
+			written |= X86_REG_MASK_RCX;
+		}
 
-	static void DecodeGroup0F00(DecodeState* state)
-	{
-		uint8_t rm = Peek8(state);
-		uint8_t regField = (rm >> 3) & 7;
-		if (regField >= 2)
-			state->opSize = 2;
-		DecodeGroupRM(state);
-	}
+		for (size_t i = 0; i < 3; i++)
+		{
+			const InstructionOperand* oper = &instr->operands[i];
+			uint64_t mask;
 
+			if (oper->operand == MEM)
+			{
+				// Address registers are read no matter how the memory is accessed
+				read |= GetRegisterMask(oper->components[0]) | GetRegisterMask(oper->components[1]);
+				if (oper->relative)
+					read |= X86_REG_MASK_RIP;
+				continue;
+			}
 
-	static void DecodeGroup0F01(DecodeState* state)
-	{
-		uint8_t rm = Peek8(state);
-		uint8_t modField = (rm >> 6) & 3;
-		uint8_t regField = (rm >> 3) & 7;
-		uint8_t rmField = rm & 7;
+			mask = GetRegisterMask(oper->operand);
+			if (oper->access & X86_ACCESS_READ)
+				read |= mask;
+			if (oper->access & X86_ACCESS_WRITE)
+			{
+				written |= mask;
 
-		if ((modField == 3) && (regField != 4) && (regField != 6))
-		{
-			state->result->operation = (InstructionOperation)group0F01RegOperations[regField][rmField];
-			Read8(state);
-			return;
+				// Writing a byte or word register keeps the rest of the register, so the old value is
+				// still needed. Writes to 32-bit registers replace the whole register. Partial writes of
+				// XMM registers are already marked as read and written by their operand access.
+				if ((oper->size < 4) && (mask & 0xffff))
+					read |= mask;
+			}
 		}
 
-		if (regField < 4)
-			state->opSize = state->using64 ? 10 : 6;
-		else if (regField != 7)
-			state->opSize = 2;
-		else
-			state->opSize = 1;
-		DecodeGroupRM(state);
+		masks->read = read;
+		masks->written = written;
 	}
 
 
-	static void DecodeGroup0FAE(DecodeState* state)
+	void GetInstructionFlags(const Instruction* instr, X86FlagMasks* flags)
 	{
-		uint8_t rm = Peek8(state);
-		uint8_t modField = (rm >> 6) & 3;
-		uint8_t regField = (rm >> 3) & 7;
+		InstructionOperation operation = instr->operation;
+		const InstructionOperand* count = NULL;
 
-		if (((rm & 0xf8) == 0xe8) || ((rm & 0xf8) == 0xef8))
+		// The string forms of movsd and cmpsd use the flags like the other sizes of string operation,
+		// while the SSE operations of the same name do not use the flags at all
+		if ((instr->operands[0].operand == MEM) && (instr->operands[1].operand == MEM))
 		{
-			state->result->operation = (InstructionOperation)groupOperations[(int)state->result->operation + 1][regField];
-			Read8(state);
-			return;
+			if (operation == MOVSD)
+				operation = MOVSB;
+			else if (operation == CMPSD)
+				operation = CMPSB;
 		}
 
-		if (modField == 3)
+		*flags = X86OperationFlags[operation];
+
+		// A repeated string operation does nothing when the count in rcx is zero, so the flags it changes
+		// may also keep their earlier values
+		if ((instr->flags & X86_FLAG_ANY_REP) && (X86OperationAttributes[operation] & X86_OP_STRING))
 		{
-			state->result->operation = (InstructionOperation)groupOperations[(int)state->result->operation + 1][regField];
+			flags->read |= flags->written | flags->undefined;
 			return;
 		}
 
-		if ((regField & 2) == 0)
-			state->opSize = 512;
-		else if ((regField & 6) == 2)
-			state->opSize = 4;
-		else
-			state->opSize = 1;
-		DecodeGroupRM(state);
-	}
-
-
-	static void Decode0FB8(DecodeState* state)
-	{
-		if (state->rep != REP_PREFIX_REPE)
+		switch (operation)
 		{
-			if (state->using64)
-				state->opSize = state->opPrefix ? 4 : 8;
-			state->finalOpSize = GetFinalOpSize(state);
-			DecodeRelImm(state);
+		case SHL:
+		case SHR:
+		case SAR:
+		case ROL:
+		case ROR:
+		case RCL:
+		case RCR:
+			count = &instr->operands[1];
+			break;
+		case SHLD:
+		case SHRD:
+			count = &instr->operands[2];
+			break;
+		default:
 			return;
 		}
 
-		DecodeRegRM(state);
-	}
-
-
-	static void DecodeRMSRegV(DecodeState* state)
-	{
-		const RegDef* regList = GetRegListForOpSize(state);
-		uint8_t regField;
-		DecodeRM(state, state->operand0, regList, state->opSize, &regField);
-		if (regField >= 6)
-			state->invalid = true;
-		state->operand1->operand = (OperandType)(REG_ES + regField);
-		state->operand1->size = 2;
-		if (state->result->operands[0].operand == REG_CS)
-			state->invalid = true;
-	}
+		if (count->operand == IMM)
+		{
+			// A count that is zero after masking leaves the flags unchanged
+			if ((count->immediate & ((instr->operands[0].size == 8) ? 0x3f : 0x1f)) == 0)
+			{
+				flags->read = 0;
+				flags->written = 0;
+				flags->undefined = 0;
+				return;
+			}
+			if (count->immediate == 1)
+				return;
+		}
 
+		// The overflow flag is only defined for a count of one
+		flags->written &= ~X86_EFLAGS_OF;
+		flags->undefined |= X86_EFLAGS_OF;
 
-	static void DecodeRM8(DecodeState* state)
-	{
-		const RegDef* regList = GetByteRegList(state);
-		DecodeRM(state, state->operand0, regList, 1, NULL);
+		// A count in a register can be zero at run time, which leaves the flags unchanged, so the flags
+		// the operation changes may also keep their earlier values
+		if (count->operand != IMM)
+			flags->read |= flags->written | flags->undefined;
 	}
 
 
-	static void DecodeRMV(DecodeState* state)
+	static void WriteColumns(const Instruction* instr, const InstructionColumns* columns, uint32_t columnMask,
+		size_t i)
 	{
-		const RegDef* regList = GetRegListForOpSize(state);
-		DecodeRM(state, state->operand0, regList, state->opSize, NULL);
-	}
+		const InstructionOperand* mem = NULL;
+		const InstructionOperand* imm = NULL;
 
+		if (columnMask & X86_COLUMN_OPERATION)
+			columns->operation[i] = (uint16_t)instr->operation;
+		if (columnMask & X86_COLUMN_LENGTH)
+			columns->length[i] = (uint8_t)instr->length;
+		if (columnMask & X86_COLUMN_FLAGS)
+			columns->flags[i] = instr->flags;
+		if (columnMask & X86_COLUMN_OPERANDS)
+		{
+			columns->operands[i * 3] = (uint8_t)instr->operands[0].operand;
+			columns->operands[(i * 3) + 1] = (uint8_t)instr->operands[1].operand;
+			columns->operands[(i * 3) + 2] = (uint8_t)instr->operands[2].operand;
+		}
+		if (columnMask & (X86_COLUMN_REGS_READ | X86_COLUMN_REGS_WRITTEN))
+		{
+			X86RegisterMasks masks;
+			GetRegisterMasks(instr, &masks);
+			if (columnMask & X86_COLUMN_REGS_READ)
+				columns->regsRead[i] = masks.read;
+			if (columnMask & X86_COLUMN_REGS_WRITTEN)
+				columns->regsWritten[i] = masks.written;
+		}
 
-	static void DecodeFarImm(DecodeState* state)
-	{
-		SetOperandToImm(state, state->operand1);
-		SetOperandToImm16(state, state->operand0);
-	}
+		if (!(columnMask & (X86_COLUMN_BASE | X86_COLUMN_INDEX | X86_COLUMN_DISPLACEMENT | X86_COLUMN_IMMEDIATE)))
+			return;
 
+		// The memory columns describe the first memory operand, and the immediate column the first
+		// immediate operand
+		for (size_t j = 0; j < 3; j++)
+		{
+			if ((instr->operands[j].operand == MEM) && (!mem))
+				mem = &instr->operands[j];
+			else if ((instr->operands[j].operand == IMM) && (!imm))
+				imm = &instr->operands[j];
+		}
 
-	static void DecodeEaxAddr(DecodeState* state)
-	{
-		SetOperandToEaxFinalOpSize(state, state->operand0);
-		SetOperandToImmAddr(state, state->operand1);
+		if (columnMask & X86_COLUMN_BASE)
+			columns->base[i] = mem ? (uint8_t)mem->components[0] : NONE;
+		if (columnMask & X86_COLUMN_INDEX)
+			columns->index[i] = mem ? (uint8_t)mem->components[1] : NONE;
+		if (columnMask & X86_COLUMN_DISPLACEMENT)
+			columns->displacement[i] = mem ? mem->immediate : 0;
+		if (columnMask & X86_COLUMN_IMMEDIATE)
+			columns->immediate[i] = imm ? imm->immediate : 0;
 	}
 
 
-	static void DecodeEdiEsi(DecodeState* state)
+	static size_t DisassembleColumns(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionColumns* columns,
+		uint32_t columnMask, size_t maxCount, size_t* nextOffset, uint16_t addrSize, uint16_t opSize, bool using64,
+		DecodeInstructionFunction decode, DecodeInstructionFunction decodeNext)
 	{
-		SetOperandToEsEdi(state, state->operand0, state->finalOpSize);
-		SetOperandToDsEsi(state, state->operand1, state->finalOpSize);
-	}
-
+		Instruction instr;
+		DecodeState state;
+		size_t offset = 0;
+		size_t count = 0;
 
-	static void DecodeEdiEax(DecodeState* state)
-	{
-		SetOperandToEsEdi(state, state->operand0, state->finalOpSize);
-		SetOperandToEaxFinalOpSize(state, state->operand1);
-	}
+		state.result = &instr;
+		state.using64 = using64;
+		while ((count < maxCount) && (offset < len))
+		{
+			size_t remaining = len - offset;
+			state.opcodeStart = &opcode[offset];
+			state.opcode = state.opcodeStart;
+			state.addr = addr + offset;
+			state.len = (remaining > 15) ? 15 : remaining;
+			state.addrSize = addrSize;
+			state.opSize = opSize;
+			if (!((count == 0) ? decode(&state) : decodeNext(&state)))
+				break;
 
+			WriteColumns(&instr, columns, columnMask, count);
+			offset += instr.length;
+			count++;
+		}
 
-	static void DecodeEaxEsi(DecodeState* state)
-	{
-		SetOperandToEaxFinalOpSize(state, state->operand0);
-		SetOperandToDsEsi(state, state->operand1, state->finalOpSize);
+		if (nextOffset)
+			*nextOffset = offset;
+		return count;
 	}
 
 
-	static void DecodeAlEbxAl(DecodeState* state)
+	size_t DisassembleColumns16(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionColumns* columns,
+		uint32_t columnMask, size_t maxCount, size_t* nextOffset)
 	{
-		const RegDef* regList = GetRegListForAddrSize(state);
-		state->operand0->operand = REG_AL;
-		state->operand0->size = 1;
-		state->operand1->operand = MEM;
-		state->operand1->components[0] = (OperandType)regList[3];
-		state->operand1->components[1] = REG_AL;
-		state->operand1->size = 1;
-		state->operand1->segment = GetFinalSegment(state, SEG_DS);
+		return DisassembleColumns(opcode, addr, len, columns, columnMask, maxCount, nextOffset, 2, 2, false,
+			DECODER_16(DecodeInstruction), DECODER_16(DecodeNextInstruction));
 	}
 
 
-	static void DecodeEaxImm8(DecodeState* state)
+	size_t DisassembleColumns32(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionColumns* columns,
+		uint32_t columnMask, size_t maxCount, size_t* nextOffset)
 	{
-		SetOperandToEaxFinalOpSize(state, state->operand0);
-		SetOperandToImm8(state, state->operand1);
+		return DisassembleColumns(opcode, addr, len, columns, columnMask, maxCount, nextOffset, 4, 4, false,
+			DECODER_32(DecodeInstruction), DECODER_32(DecodeNextInstruction));
 	}
 
 
-	static void DecodeEaxDx(DecodeState* state)
+	size_t DisassembleColumns64(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionColumns* columns,
+		uint32_t columnMask, size_t maxCount, size_t* nextOffset)
 	{
-		SetOperandToEaxFinalOpSize(state, state->operand0);
-		state->operand1->operand = REG_DX;
-		state->operand1->size = 2;
+		return DisassembleColumns(opcode, addr, len, columns, columnMask, maxCount, nextOffset, 8, 4, true,
+			DECODER_64(DecodeInstruction), DECODER_64(DecodeNextInstruction));
 	}
 
 
-	static void Decode3DNow(DecodeState* state)
+	struct LengthState
 	{
-		uint8_t op;
-		int i, min, max;
-		DecodeRMReg(state, state->operand1, mmxRegList, 8, state->operand0, mmxRegList, 8);
-		op = Read8(state);
-		state->result->operation = INVALID;
-		for (min = 0, max = (int)(sizeof(sparse3DNowOpcodes) / sizeof(SparseOpEntry)) - 1, i = (min + max) / 2;
-			min <= max; i = (min + max) / 2)
+		const uint8_t* opcode;
+		size_t len;
+		uint16_t operation;
+		uint16_t opSize, finalOpSize, addrSize;
+		uint16_t flags;
+		bool invalid;
+		bool opPrefix;
+		bool lock;
+		bool memOperand;
+		RepPrefix rep;
+		bool using64;
+	};
+#ifndef __cplusplus
+	typedef struct LengthState LengthState;
+#endif
+
+
+	static uint8_t LengthRead8(LengthState* state)
+	{
+		if (state->len < 1)
 		{
-			if (op > sparse3DNowOpcodes[i].opcode)
-				min = i + 1;
-			else if (op < sparse3DNowOpcodes[i].opcode)
-				max = i - 1;
-			else
-			{
-				state->result->operation = (InstructionOperation)sparse3DNowOpcodes[i].operation;
-				break;
-			}
+			// Read past end of buffer, returning 0xcc from now on will guarantee exit
+			state->invalid = true;
+			state->len = 0;
+			return 0xcc;
 		}
+
+		state->len--;
+		return *(state->opcode++);
 	}
 
 
-	static void DecodeSSETable(DecodeState* state)
+	static uint8_t LengthPeek8(LengthState* state)
 	{
-		uint8_t type = DecodeSSEPrefix(state);
-		uint8_t rm = Peek8(state);
-		uint8_t modField = (rm >> 6) & 3;
-
-		const SSETableEntry* entry = &sseTable[(int)state->result->operation];
-		const SSETableOperationEntry* opEntry;
+		if (state->len < 1)
+		{
+			// Read past end of buffer, returning 0xcc from now on will guarantee exit
+			state->invalid = true;
+			state->len = 0;
+			return 0xcc;
+		}
 
-		if (modField == 3)
-			opEntry = &entry->regOps[type];
-		else
-			opEntry = &entry->memOps[type];
+		return *state->opcode;
+	}
 
-		state->result->operation = (InstructionOperation)opEntry->operation;
-		DecodeRMReg(state, GetOperandForSSEEntryType(state, opEntry->rmType, 1), GetRegListForSSEEntryType(state, opEntry->rmType),
-			GetSizeForSSEEntryType(state, opEntry->rmType), GetOperandForSSEEntryType(state, opEntry->regType, 0),
-			GetRegListForSSEEntryType(state, opEntry->regType), GetSizeForSSEEntryType(state, opEntry->regType));
 
-		if (state->flags & DEC_FLAG_INC_OPERATION_FOR_64)
+	static void LengthSkip(LengthState* state, size_t size)
+	{
+		if (state->len < size)
 		{
-			UpdateOperationForSSEEntryType(state, opEntry->regType);
-			UpdateOperationForSSEEntryType(state, opEntry->rmType);
+			// Read past end of buffer
+			state->invalid = true;
+			state->len = 0;
+			return;
 		}
+
+		state->opcode += size;
+		state->len -= size;
 	}
 
 
-	static void DecodeSSETableImm8(DecodeState* state)
+	static void LengthSkipFinalOpSize(LengthState* state)
 	{
-		DecodeSSETable(state);
-		SetOperandToImm8(state, &state->result->operands[2]);
+		if (state->flags & DEC_FLAG_IMM_SX)
+		{
+			LengthSkip(state, 1);
+			return;
+		}
+		switch (state->finalOpSize)
+		{
+		case 1:
+			LengthSkip(state, 1);
+			break;
+		case 2:
+			LengthSkip(state, 2);
+			break;
+		case 4:
+		case 8:
+			LengthSkip(state, 4);
+			break;
+		}
 	}
 
 
-	static void DecodeSSETableMem8(DecodeState* state)
+	static void LengthSkipSignedFinalOpSize(LengthState* state)
 	{
-		DecodeSSETable(state);
-		if (state->operand0->operand == MEM)
-			state->operand0->size = 1;
-		if (state->operand1->operand == MEM)
-			state->operand1->size = 1;
+		switch (state->finalOpSize)
+		{
+		case 1:
+			LengthSkip(state, 1);
+			break;
+		case 2:
+			LengthSkip(state, 2);
+			break;
+		case 4:
+		case 8:
+			LengthSkip(state, 4);
+			break;
+		}
 	}
 
 
-	static void DecodeSSE(DecodeState* state)
+	static uint8_t LengthSkipRM(LengthState* state)
 	{
-		uint8_t type = DecodeSSEPrefix(state);
-		uint8_t rm = Peek8(state);
-		uint8_t modField = (rm >> 6) & 3;
-		uint16_t size;
+		uint8_t rmByte = LengthRead8(state);
+		uint8_t mod = rmByte >> 6;
+		uint8_t rm = rmByte & 7;
+
+		if (mod == 3)
+			return rmByte;
 
-		state->result->operation = (InstructionOperation)((int)state->result->operation + type);
-		if (modField == 3)
-			size = 16;
+		state->memOperand = true;
+		if (state->addrSize == 2)
+		{
+			if ((mod == 0) && (rm == 6))
+				LengthSkip(state, 2);
+			else if (mod == 1)
+				LengthSkip(state, 1);
+			else if (mod == 2)
+				LengthSkip(state, 2);
+		}
 		else
-			size = GetSizeForSSEType(type);
-		DecodeRMReg(state, state->operand1, xmmRegList, size, state->operand0, xmmRegList, 16);
+		{
+			if (rm == 4)
+			{
+				// SIB byte present
+				uint8_t sibByte = LengthRead8(state);
+				if ((mod == 0) && ((sibByte & 7) == 5))
+					LengthSkip(state, 4);
+			}
+			else if ((mod == 0) && (rm == 5))
+				LengthSkip(state, 4);
+			if (mod == 1)
+				LengthSkip(state, 1);
+			else if (mod == 2)
+				LengthSkip(state, 4);
+		}
+		return rmByte;
 	}
 
 
-	static void DecodeSSESingle(DecodeState* state)
+	static uint8_t LengthSkipGroupRM(LengthState* state)
 	{
-		uint8_t type = DecodeSSEPrefix(state);
+		uint8_t regField = (LengthSkipRM(state) >> 3) & 7;
+		state->operation = groupOperations[state->operation][regField];
+		return regField;
+	}
+
 
-		if ((type == 1) || (type == 2))
+	static uint8_t LengthSSEPrefix(LengthState* state)
+	{
+		if (state->opPrefix)
 		{
-			state->invalid = true;
-			return;
+			state->opPrefix = false;
+			return 1;
 		}
+		else if (state->rep == REP_PREFIX_REPNE)
+		{
+			state->rep = REP_PREFIX_NONE;
+			return 2;
+		}
+		else if (state->rep == REP_PREFIX_REPE)
+		{
+			state->rep = REP_PREFIX_NONE;
+			return 3;
+		}
+		return 0;
+	}
+
 
-		state->result->operation = (InstructionOperation)((int)state->result->operation + (type & 1));
-		DecodeRMReg(state, state->operand1, xmmRegList, 16, state->operand0, xmmRegList, 16);
+	static void LengthSkipSSETable(LengthState* state)
+	{
+		uint8_t type = LengthSSEPrefix(state);
+		uint8_t rm = LengthPeek8(state);
+		const SSETableEntry* entry = &sseTable[state->operation];
+
+		if (((rm >> 6) & 3) == 3)
+			state->operation = entry->regOps[type].operation;
+		else
+			state->operation = entry->memOps[type].operation;
+		LengthSkipRM(state);
 	}
 
 
-	static void DecodeSSEPacked(DecodeState* state)
+	static void LengthProcessEncoding(LengthState* state, const InstructionEncoding* encoding)
 	{
-		uint8_t type = DecodeSSEPrefix(state);
+		uint8_t opcode, rm, regField, type;
+
+		state->operation = encoding->operation;
 
-		if ((type == 2) || (type == 3))
+		state->flags = encoding->flags;
+		if (state->using64 && (state->flags & DEC_FLAG_INVALID_IN_64BIT))
 		{
 			state->invalid = true;
 			return;
 		}
+		if (state->using64 && (state->flags & DEC_FLAG_DEFAULT_TO_64BIT))
+			state->opSize = state->opPrefix ? 4 : 8;
+		state->finalOpSize = (state->flags & DEC_FLAG_BYTE) ? 1 : state->opSize;
+		if (state->flags & DEC_FLAG_FORCE_16BIT)
+			state->finalOpSize = 2;
 
-		state->result->operation = (InstructionOperation)((int)state->result->operation + (type & 1));
-		DecodeRMReg(state, state->operand1, xmmRegList, 16, state->operand0, xmmRegList, 16);
+		// Only the fields that determine the instruction length and validity are decoded
+		switch (encoding->kind)
+		{
+		case DECODE_TWO_BYTE:
+			opcode = LengthRead8(state);
+			if (opcode == 0x38)
+				LengthProcessEncoding(state, &threeByte0F38Map[LengthRead8(state)]);
+			else if (opcode == 0x3a)
+			{
+				LengthProcessEncoding(state, &threeByte0F3AMap[LengthRead8(state)]);
+				LengthSkip(state, 1);
+			}
+			else
+				LengthProcessEncoding(state, &twoByteOpcodeMap[opcode]);
+			break;
+		case DECODE_FPU:
+			rm = LengthPeek8(state);
+			if ((rm & 0xc0) == 0xc0)
+				LengthProcessEncoding(state, &fpuRegOpcodeMap[state->operation][(rm >> 3) & 7]);
+			else
+				LengthProcessEncoding(state, &fpuMemOpcodeMap[state->operation][(rm >> 3) & 7]);
+			break;
+		case DECODE_NO_OPERANDS:
+		case DECODE_PUSH_POP_SEG:
+		case DECODE_OP_REG:
+		case DECODE_EAX_OP_REG:
+		case DECODE_NOP:
+		case DECODE_EDI_DX:
+		case DECODE_DX_ESI:
+		case DECODE_EDI_ESI:
+		case DECODE_EDI_EAX:
+		case DECODE_EAX_ESI:
+		case DECODE_AL_EBX_AL:
+		case DECODE_EAX_DX:
+			break;
+		case DECODE_REG_RM:
+			rm = LengthSkipRM(state);
+			if ((state->flags & DEC_FLAG_REG_RM_SIZE_MASK) && ((rm & 0xc0) == 0xc0))
+				state->invalid = true;
+			break;
+		case DECODE_REG_RM_IMM:
+			LengthSkipRM(state);
+			LengthSkipFinalOpSize(state);
+			break;
+		case DECODE_RM_REG_IMM8:
+		case DECODE_SSE_TABLE_IMM8:
+		case DECODE_PINSRW:
+			if (encoding->kind == DECODE_RM_REG_IMM8)
+				LengthSkipRM(state);
+			else
+				LengthSkipSSETable(state);
+			LengthSkip(state, 1);
+			break;
+		case DECODE_RM_REG_CL:
+		case DECODE_RM_8:
+		case DECODE_RM_V:
+		case DECODE_SSE:
+		case DECODE_MMX:
+		case DECODE_MOVSXZX_8:
+		case DECODE_MOVSXZX_16:
+		case DECODE_FPUREG:
+		case DECODE_FPUREG_ST0:
+		case DECODE_CRC32:
+		case DECODE_ARPL:
+			LengthSkipRM(state);
+			break;
+		case DECODE_EAX_IMM:
+		case DECODE_IMM:
+			LengthSkipFinalOpSize(state);
+			break;
+		case DECODE_OP_REG_IMM:
+			if (state->opSize == 8)
+				LengthSkip(state, 8);
+			else
+				LengthSkipFinalOpSize(state);
+			break;
+		case DECODE_IMM16_IMM8:
+			LengthSkip(state, 3);
+			break;
+		case DECODE_REL_IMM:
+		case DECODE_REL_IMM_ADDR_SIZE:
+			LengthSkipSignedFinalOpSize(state);
+			break;
+		case DECODE_GROUP_RM:
+		case DECODE_GROUP_RM_ONE:
+		case DECODE_GROUP_RM_CL:
+		case DECODE_GROUP_0F00:
+			LengthSkipGroupRM(state);
+			break;
+		case DECODE_GROUP_RM_IMM:
+			LengthSkipGroupRM(state);
+			LengthSkipFinalOpSize(state);
+			break;
+		case DECODE_GROUP_RM_IMM8_V:
+			LengthSkipGroupRM(state);
+			LengthSkip(state, 1);
+			break;
+		case DECODE_GROUP_F6F7:
+			LengthSkipGroupRM(state);
+			if (state->operation == TEST)
+				LengthSkipFinalOpSize(state);
+			if (state->lock && (state->operation != NOT) && (state->operation != NEG))
+				state->invalid = true;
+			break;
+		case DECODE_GROUP_FF:
+			LengthSkipGroupRM(state);
+			if (((state->operation == CALLF) || (state->operation == JMPF)) && !state->memOperand)
+				state->invalid = true;
+			if (state->lock && (state->operation != INC) && (state->operation != DEC))
+				state->invalid = true;
+			break;
+		case DECODE_GROUP_0F01:
+			rm = LengthPeek8(state);
+			regField = (rm >> 3) & 7;
+			if (((rm & 0xc0) == 0xc0) && (regField != 4) && (regField != 6))
+			{
+				state->operation = group0F01RegOperations[regField][rm & 7];
+				LengthRead8(state);
+			}
+			else
+				LengthSkipGroupRM(state);
+			break;
+		case DECODE_GROUP_0FAE:
+			rm = LengthPeek8(state);
+			regField = (rm >> 3) & 7;
+			if (((rm & 0xf8) == 0xe8) || ((rm & 0xf8) == 0xf8))
+			{
+				state->operation = groupOperations[state->operation + 1][regField];
+				LengthRead8(state);
+			}
+			else if ((rm & 0xc0) == 0xc0)
+				state->operation = groupOperations[state->operation + 1][regField];
+			else
+				LengthSkipGroupRM(state);
+			break;
+		case DECODE_0FB8:
+			if (state->rep != REP_PREFIX_REPE)
+			{
+				if (state->using64)
+					state->opSize = state->opPrefix ? 4 : 8;
+				state->finalOpSize = (state->flags & DEC_FLAG_BYTE) ? 1 : state->opSize;
+				LengthSkipSignedFinalOpSize(state);
+			}
+			else
+				LengthSkipRM(state);
+			break;
+		case DECODE_RM_SREG_V:
+			regField = (LengthSkipRM(state) >> 3) & 7;
+			if (regField >= 6)
+				state->invalid = true;
+			if ((state->flags & DEC_FLAG_FLIP_OPERANDS) && (regField == (REG_CS - REG_ES)))
+				state->invalid = true;
+			break;
+		case DECODE_FAR_IMM:
+			LengthSkipFinalOpSize(state);
+			LengthSkip(state, 2);
+			break;
+		case DECODE_EAX_ADDR:
+			LengthSkip(state, (state->addrSize == 2) ? 2 : 4);
+			break;
+		case DECODE_EAX_IMM8:
+			LengthSkip(state, 1);
+			break;
+		case DECODE_3DNOW:
+			LengthSkipRM(state);
+			state->operation = threeDNowOpcodeMap[LengthRead8(state)];
+			break;
+		case DECODE_SSE_TABLE:
+		case DECODE_SSE_TABLE_MEM8:
+			LengthSkipSSETable(state);
+			break;
+		case DECODE_SSE_SINGLE:
+		case DECODE_SSE_PACKED:
+			type = LengthSSEPrefix(state);
+			if ((encoding->kind == DECODE_SSE_SINGLE) ? ((type == 1) || (type == 2)) : ((type == 2) || (type == 3)))
+			{
+				state->invalid = true;
+				break;
+			}
+			LengthSkipRM(state);
+			break;
+		case DECODE_MMX_SSE_ONLY:
+			if (state->opPrefix)
+				LengthSkipRM(state);
+			else
+				state->invalid = true;
+			break;
+		case DECODE_MMX_GROUP:
+			regField = (LengthSkipRM(state) >> 3) & 7;
+			state->operation = mmxGroupOperations[state->operation][regField][state->opPrefix ? 1 : 0];
+			LengthSkip(state, 1);
+			break;
+		case DECODE_REG_CR:
+			// The operation in the table is the first register of the kind that is moved
+			LengthRead8(state);
+			state->lock = false;
+			state->operation = MOV;
+			break;
+		case DECODE_MEM_16:
+		case DECODE_MEM_32:
+		case DECODE_MEM_64:
+		case DECODE_MEM_80:
+		case DECODE_MEM_FLOATENV:
+		case DECODE_MEM_FLOATSAVE:
+		case DECODE_MOVNTI:
+			if ((LengthSkipRM(state) & 0xc0) == 0xc0)
+				state->invalid = true;
+			break;
+		case DECODE_REGGROUP_NO_OPERANDS:
+		case DECODE_REGGROUP_AX:
+			state->operation = groupOperations[state->operation][LengthRead8(state) & 7];
+			break;
+		case DECODE_CMPXCH8B:
+			regField = (LengthPeek8(state) >> 3) & 7;
+			if ((regField != 1) && (regField != 6) && (regField != 7))
+			{
+				state->invalid = true;
+				break;
+			}
+			if ((LengthSkipRM(state) & 0xc0) == 0xc0)
+				state->invalid = true;
+			break;
+		default:
+			state->invalid = true;
+			break;
+		}
+
+		if (state->operation == INVALID)
+			state->invalid = true;
+
+		if (state->lock)
+		{
+			// Ensure instruction allows lock and it has proper semantics
+			if (!(state->flags & DEC_FLAG_LOCK))
+				state->invalid = true;
+			else if (state->operation == CMP)
+				state->invalid = true;
+			else if (!state->memOperand)
+				state->invalid = true;
+		}
 	}
 
 
-	static void DecodeMMX(DecodeState* state)
+	static void LengthProcessPrefixes(LengthState* state)
 	{
+		uint8_t rex = 0;
+		bool addrPrefix = false;
+
+		while (!state->invalid)
+		{
+			uint8_t prefix = LengthRead8(state);
+			if ((prefix >= 0x26) && (prefix <= 0x3e) && ((prefix & 7) == 6))
+			{
+				// Segment prefix
+			}
+			else if ((prefix == 0x64) || (prefix == 0x65))
+			{
+				// FS/GS prefix
+			}
+			else if (prefix == 0x66)
+				state->opPrefix = true;
+			else if (prefix == 0x67)
+				addrPrefix = true;
+			else if (prefix == 0xf0)
+				state->lock = true;
+			else if (prefix == 0xf2)
+				state->rep = REP_PREFIX_REPNE;
+			else if (prefix == 0xf3)
+				state->rep = REP_PREFIX_REPE;
+			else if (state->using64 && (prefix >= 0x40) && (prefix <= 0x4f))
+			{
+				// REX prefix
+				rex = prefix;
+				continue;
+			}
+			else
+			{
+				// Not a prefix, continue instruction processing
+				state->opcode--;
+				state->len++;
+				break;
+			}
+
+			// Force ignore REX unless it is the last prefix
+			rex = 0;
+		}
+
 		if (state->opPrefix)
-			DecodeRMReg(state, state->operand1, xmmRegList, 16, state->operand0, xmmRegList, 16);
-		else
-			DecodeRMReg(state, state->operand1, mmxRegList, 8, state->operand0, mmxRegList, 8);
+			state->opSize = (state->opSize == 2) ? 4 : 2;
+		if (addrPrefix)
+			state->addrSize = (state->addrSize == 4) ? 2 : 4;
+		if (rex & 8)
+			state->opSize = 8;
 	}
 
 
-	static void DecodeMMXSSEOnly(DecodeState* state)
+	// Decodes the length of an instruction. The operation is left in the state, before any change for
+	// the operand size, address size or SSE prefix, which add at most three to it.
+	static size_t LengthDecode(LengthState* state, const uint8_t* opcode, size_t maxLen, uint16_t addrSize,
+		uint16_t opSize, bool using64)
 	{
-		if (state->opPrefix)
-			DecodeRMReg(state, state->operand1, xmmRegList, 16, state->operand0, xmmRegList, 16);
-		else
-			state->invalid = true;
+		state->opcode = opcode;
+		state->len = (maxLen > 15) ? 15 : maxLen;
+		state->addrSize = addrSize;
+		state->opSize = opSize;
+		state->using64 = using64;
+		state->invalid = false;
+		state->opPrefix = false;
+		state->lock = false;
+		state->memOperand = false;
+		state->rep = REP_PREFIX_NONE;
+
+		LengthProcessPrefixes(state);
+		if (state->invalid)
+			return 0;
+		LengthProcessEncoding(state, &mainOpcodeMap[LengthRead8(state)]);
+		if (state->invalid)
+			return 0;
+		return state->opcode - opcode;
 	}
 
 
-	static void DecodeMMXGroup(DecodeState* state)
+	static size_t InstructionLength(const uint8_t* opcode, size_t maxLen, uint16_t addrSize, uint16_t opSize, bool using64)
 	{
-		uint8_t regField;
-		if (state->opPrefix)
-		{
-			DecodeRM(state, state->operand0, xmmRegList, 16, &regField);
-			state->result->operation = (InstructionOperation)mmxGroupOperations[(int)state->result->operation][regField][1];
-		}
-		else
+		LengthState state;
+		return LengthDecode(&state, opcode, maxLen, addrSize, opSize, using64);
+	}
+
+
+	size_t InstructionLength16(const uint8_t* opcode, size_t maxLen)
+	{
+		return InstructionLength(opcode, maxLen, 2, 2, false);
+	}
+
+
+	size_t InstructionLength32(const uint8_t* opcode, size_t maxLen)
+	{
+		return InstructionLength(opcode, maxLen, 4, 4, false);
+	}
+
+
+	size_t InstructionLength64(const uint8_t* opcode, size_t maxLen)
+	{
+		return InstructionLength(opcode, maxLen, 8, 4, true);
+	}
+
+
+	static size_t InstructionLengthBlock(const uint8_t* opcode, size_t len, uint8_t* lengths, size_t maxCount,
+		size_t* nextOffset, uint16_t addrSize, uint16_t opSize, bool using64)
+	{
+		size_t offset = 0;
+		size_t count = 0;
+
+		while ((count < maxCount) && (offset < len))
 		{
-			DecodeRM(state, state->operand0, mmxRegList, 8, &regField);
-			state->result->operation = (InstructionOperation)mmxGroupOperations[(int)state->result->operation][regField][0];
+			size_t instrLen = InstructionLength(&opcode[offset], len - offset, addrSize, opSize, using64);
+			if (instrLen == 0)
+				break;
+			lengths[count++] = (uint8_t)instrLen;
+			offset += instrLen;
 		}
-		SetOperandToImm8(state, state->operand1);
+
+		if (nextOffset)
+			*nextOffset = offset;
+		return count;
+	}
+
+
+	size_t InstructionLengthBlock16(const uint8_t* opcode, size_t len, uint8_t* lengths, size_t maxCount, size_t* nextOffset)
+	{
+		return InstructionLengthBlock(opcode, len, lengths, maxCount, nextOffset, 2, 2, false);
 	}
 
 
-	static void DecodePinsrw(DecodeState* state)
+	size_t InstructionLengthBlock32(const uint8_t* opcode, size_t len, uint8_t* lengths, size_t maxCount, size_t* nextOffset)
 	{
-		DecodeSSETableImm8(state);
-		if (state->operand1->operand == MEM)
-			state->operand1->size = 2;
+		return InstructionLengthBlock(opcode, len, lengths, maxCount, nextOffset, 4, 4, false);
 	}
 
 
-	static void DecodeRegCR(DecodeState* state)
+	size_t InstructionLengthBlock64(const uint8_t* opcode, size_t len, uint8_t* lengths, size_t maxCount, size_t* nextOffset)
 	{
-		const RegDef* regList;
-		uint8_t reg;
-		if (state->opSize == 2)
-			state->opSize = 4;
-		regList = GetRegListForOpSize(state);
-		reg = Read8(state);
-		if (state->result->flags & X86_FLAG_LOCK)
+		return InstructionLengthBlock(opcode, len, lengths, maxCount, nextOffset, 8, 4, true);
+	}
+
+
+	// Finds the operations that the length decoder can report for instructions with an operation in the
+	// filter. These are the operations up to three before each one in the filter, and the few
+	// encodings that the full decoder replaces with a different operation.
+	static void GetVisitCandidates(const X86OperationFilter* filter, X86OperationFilter* candidates)
+	{
+		for (size_t i = 0; i < X86_OPERATION_FILTER_WORDS; i++)
 		{
-			state->result->flags &= ~X86_FLAG_LOCK;
-			state->rexReg = true;
+			uint64_t bits = filter->bits[i];
+			uint64_t next = (i < (X86_OPERATION_FILTER_WORDS - 1)) ? filter->bits[i + 1] : 0;
+			candidates->bits[i] = bits | (bits >> 1) | (bits >> 2) | (bits >> 3) | (next << 63) | (next << 62) |
+				(next << 61);
 		}
-		state->operand0->operand = regList[(reg & 7) + (state->rexRM1 ? 8 : 0)];
-		state->operand0->size = state->opSize;
-		state->operand1->operand = (OperandType)((int)state->result->operation + ((reg >> 3) & 7) +
-			(state->rexReg ? 8 : 0));
-		state->operand1->size = state->opSize;
-		state->result->operation = MOV;
+
+		if (IsOperationInFilter(filter, XCHG))
+			AddOperationToFilter(candidates, NOP);
+		if (IsOperationInFilter(filter, MOVSXD))
+			AddOperationToFilter(candidates, ARPL);
+		if (IsOperationInFilter(filter, CMPXCH16B) || IsOperationInFilter(filter, VMCLEAR) ||
+			IsOperationInFilter(filter, VMXON) || IsOperationInFilter(filter, VMPTRLD) ||
+			IsOperationInFilter(filter, VMPTRST))
+			AddOperationToFilter(candidates, CMPXCH8B);
 	}
 
 
-	static void DecodeMovSXZX8(DecodeState* state)
+	static size_t DecodeRangeVisit(const uint8_t* opcode, uint64_t addr, size_t len, const X86OperationFilter* filter,
+		X86InstructionVisitor visitor, void* context, size_t* nextOffset, uint16_t addrSize, uint16_t opSize,
+		bool using64, DecodeInstructionFunction decode)
 	{
-		DecodeRMReg(state, state->operand1, GetByteRegList(state), 1, state->operand0, GetRegListForOpSize(state), state->opSize);
+		X86OperationFilter candidates;
+		LengthState lengthState;
+		DecodeState state;
+		Instruction instr;
+		size_t offset = 0;
+		size_t count = 0;
+
+		GetVisitCandidates(filter, &candidates);
+
+		// Instructions are measured with the length decoder, and only decoded in full when the
+		// operation that it finds could become one in the filter
+		state.result = &instr;
+		state.using64 = using64;
+		while (offset < len)
+		{
+			size_t instrLen = LengthDecode(&lengthState, &opcode[offset], len - offset, addrSize, opSize, using64);
+			if (instrLen == 0)
+				break;
+
+			if (IsOperationInFilter(&candidates, (InstructionOperation)lengthState.operation))
+			{
+				size_t remaining = len - offset;
+				state.opcodeStart = &opcode[offset];
+				state.opcode = state.opcodeStart;
+				state.addr = addr + offset;
+				state.len = (remaining > 15) ? 15 : remaining;
+				state.addrSize = addrSize;
+				state.opSize = opSize;
+				if (!decode(&state))
+					break;
+				if (IsOperationInFilter(filter, instr.operation) && !visitor(context, &instr, offset))
+				{
+					offset += instrLen;
+					count++;
+					break;
+				}
+			}
+
+			offset += instrLen;
+			count++;
+		}
+
+		if (nextOffset)
+			*nextOffset = offset;
+		return count;
 	}
 
 
-	static void DecodeMovSXZX16(DecodeState* state)
+	size_t DecodeRangeVisit16(const uint8_t* opcode, uint64_t addr, size_t len, const X86OperationFilter* filter,
+		X86InstructionVisitor visitor, void* context, size_t* nextOffset)
 	{
-		DecodeRMReg(state, state->operand1, reg16List, 2, state->operand0, GetRegListForOpSize(state), state->opSize);
+		return DecodeRangeVisit(opcode, addr, len, filter, visitor, context, nextOffset, 2, 2, false,
+			DECODER_16(DecodeInstruction));
 	}
 
 
-	static void DecodeMem16(DecodeState* state)
+	size_t DecodeRangeVisit32(const uint8_t* opcode, uint64_t addr, size_t len, const X86OperationFilter* filter,
+		X86InstructionVisitor visitor, void* context, size_t* nextOffset)
 	{
-		DecodeRM(state, state->operand0, reg32List, 2, NULL);
-		if (state->operand0->operand != MEM)
-			state->invalid = true;
+		return DecodeRangeVisit(opcode, addr, len, filter, visitor, context, nextOffset, 4, 4, false,
+			DECODER_32(DecodeInstruction));
 	}
 
 
-	static void DecodeMem32(DecodeState* state)
+	size_t DecodeRangeVisit64(const uint8_t* opcode, uint64_t addr, size_t len, const X86OperationFilter* filter,
+		X86InstructionVisitor visitor, void* context, size_t* nextOffset)
 	{
-		DecodeRM(state, state->operand0, reg32List, 4, NULL);
-		if (state->operand0->operand != MEM)
-			state->invalid = true;
+		return DecodeRangeVisit(opcode, addr, len, filter, visitor, context, nextOffset, 8, 4, true,
+			DECODER_64(DecodeInstruction));
 	}
 
 
-	static void DecodeMem64(DecodeState* state)
+	typedef struct
 	{
-		DecodeRM(state, state->operand0, reg32List, 8, NULL);
-		if (state->operand0->operand != MEM)
-			state->invalid = true;
+		const uint8_t* opcode;
+		uint64_t addr;
+		size_t len;
+		Instruction* results;
+		X86SweepChunk* chunks;
+		uint16_t addrSize;
+		uint16_t opSize;
+		bool using64;
+		DecodeInstructionFunction decode;
+	} SweepContext;
+
+
+	// Walks instruction boundaries with the length decoder from start, which may not be on the path of
+	// a serial sweep. Boundaries near the start of the chunk are recorded in head, and the path is
+	// followed past the end of the chunk to record the boundaries in the start of the next chunk in tail.
+	static void ScanSweepChunk(const SweepContext* ctx, X86SweepChunk* chunk, size_t start)
+	{
+		size_t offset = start;
+		size_t limit = chunk->end + X86_SWEEP_SYNC_WINDOW;
+
+		if (limit > ctx->len)
+			limit = ctx->len;
+		memset(chunk->head, 0, sizeof(chunk->head));
+		memset(chunk->tail, 0, sizeof(chunk->tail));
+		chunk->count = 0;
+		while (offset < limit)
+		{
+			size_t instrLen = InstructionLength(&ctx->opcode[offset], ctx->len - offset, ctx->addrSize, ctx->opSize,
+				ctx->using64);
+			if (offset < chunk->end)
+			{
+				size_t bit = offset - chunk->base;
+				if (bit < X86_SWEEP_SYNC_WINDOW)
+					chunk->head[bit / 64] |= (uint64_t)1 << (bit % 64);
+				chunk->count++;
+			}
+			else
+			{
+				size_t bit = offset - chunk->end;
+				chunk->tail[bit / 64] |= (uint64_t)1 << (bit % 64);
+			}
+
+			// Invalid bytes are skipped one at a time, as in the decoding pass
+			offset += (instrLen != 0) ? instrLen : 1;
+		}
 	}
 
 
-	static void DecodeMem80(DecodeState* state)
+	static void ScanSweepTask(void* arg, size_t index)
 	{
-		DecodeRM(state, state->operand0, reg32List, 10, NULL);
-		if (state->operand0->operand != MEM)
-			state->invalid = true;
+		const SweepContext* ctx = (const SweepContext*)arg;
+		ScanSweepChunk(ctx, &ctx->chunks[index], ctx->chunks[index].base);
 	}
 
 
-	static void DecodeMemFloatEnv(DecodeState* state)
+	static void DecodeSweepTask(void* arg, size_t index)
 	{
-		DecodeRM(state, state->operand0, reg32List, (state->opSize == 2) ? 14 : 28, NULL);
-		if (state->operand0->operand != MEM)
-			state->invalid = true;
+		const SweepContext* ctx = (const SweepContext*)arg;
+		X86SweepChunk* chunk = &ctx->chunks[index];
+		DecodeState state;
+		size_t offset = chunk->start;
+
+		state.using64 = ctx->using64;
+		for (size_t i = 0; i < chunk->count; i++)
+		{
+			Instruction* result = &ctx->results[chunk->firstResult + i];
+			size_t remaining = ctx->len - offset;
+			state.result = result;
+			state.opcodeStart = &ctx->opcode[offset];
+			state.opcode = state.opcodeStart;
+			state.addr = ctx->addr + offset;
+			state.len = (remaining > 15) ? 15 : remaining;
+			state.addrSize = ctx->addrSize;
+			state.opSize = ctx->opSize;
+			if (ctx->decode(&state))
+			{
+				offset += result->length;
+				continue;
+			}
+
+			// A byte that does not start a valid instruction is given an entry of its own, which does
+			// not depend on how far the decoder got
+			memset(result, 0, sizeof(Instruction));
+			result->operation = INVALID;
+			result->segment = SEG_DEFAULT;
+			for (size_t j = 0; j < 3; j++)
+			{
+				result->operands[j].operand = NONE;
+				result->operands[j].scale = 1;
+				result->operands[j].segment = SEG_DEFAULT;
+			}
+			result->length = 1;
+			offset++;
+		}
+		chunk->nextOffset = offset;
 	}
 
 
-	static void DecodeMemFloatSave(DecodeState* state)
+	// Number of bits set in the window below the given bit
+	static size_t CountSweepBits(const uint64_t* bits, size_t end)
 	{
-		DecodeRM(state, state->operand0, reg32List, (state->opSize == 2) ? 94 : 108, NULL);
-		if (state->operand0->operand != MEM)
-			state->invalid = true;
+		size_t count = 0;
+		for (size_t i = 0; i < end; i++)
+		{
+			if (bits[i / 64] & ((uint64_t)1 << (i % 64)))
+				count++;
+		}
+		return count;
 	}
 
 
-	static void DecodeFPUReg(DecodeState* state)
+	// Lowest bit set in both windows, or X86_SWEEP_SYNC_WINDOW if there is none
+	static size_t FindSweepSync(const uint64_t* a, const uint64_t* b)
 	{
-		DecodeRM(state, state->operand0, fpuRegList, 10, NULL);
+		for (size_t i = 0; i < X86_SWEEP_SYNC_WINDOW; i++)
+		{
+			if ((a[i / 64] & b[i / 64]) & ((uint64_t)1 << (i % 64)))
+				return i;
+		}
+		return X86_SWEEP_SYNC_WINDOW;
 	}
 
 
-	static void DecodeFPURegST0(DecodeState* state)
+	static void RunSweepTasks(X86TaskRunner runner, void* runnerContext, X86TaskFunction func, SweepContext* ctx,
+		size_t count)
 	{
-		DecodeFPUReg(state);
-		state->operand1->operand = REG_ST0;
-		state->operand1->size = 10;
+		if (runner)
+		{
+			runner(runnerContext, func, ctx, count);
+			return;
+		}
+		for (size_t i = 0; i < count; i++)
+			func(ctx, i);
 	}
 
 
-	static void DecodeRegGroupNoOperands(DecodeState* state)
+	static size_t ParallelSweep(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+		size_t maxCount, X86SweepChunk* chunks, size_t chunkCount, X86TaskRunner runner, void* runnerContext,
+		size_t* nextOffset, uint16_t addrSize, uint16_t opSize, bool using64, DecodeInstructionFunction decode)
+	{
+		SweepContext ctx;
+		size_t chunkSize;
+		size_t total = 0;
+		size_t end = 0;
+
+		ctx.opcode = opcode;
+		ctx.addr = addr;
+		ctx.len = len;
+		ctx.results = results;
+		ctx.chunks = chunks;
+		ctx.addrSize = addrSize;
+		ctx.opSize = opSize;
+		ctx.using64 = using64;
+		ctx.decode = decode;
+
+		// Chunks must be larger than the window where adjacent chunks are matched up
+		if (chunkCount > (len / (X86_SWEEP_SYNC_WINDOW * 2)))
+			chunkCount = len / (X86_SWEEP_SYNC_WINDOW * 2);
+		if (chunkCount == 0)
+			chunkCount = 1;
+		chunkSize = len / chunkCount;
+		for (size_t i = 0; i < chunkCount; i++)
+		{
+			chunks[i].base = i * chunkSize;
+			chunks[i].end = (i == (chunkCount - 1)) ? len : ((i + 1) * chunkSize);
+			chunks[i].start = chunks[i].base;
+		}
+
+		// Each chunk is scanned speculatively from its own start
+		RunSweepTasks(runner, runnerContext, ScanSweepTask, &ctx, chunkCount);
+
+		// The scan of the first chunk is on the serial path, and so is the scan of every following chunk
+		// from the first boundary that it shares with the previous chunk. If the paths do not meet within
+		// the window, the chunk is scanned again from the first boundary of the previous chunk.
+		for (size_t i = 1; i < chunkCount; i++)
+		{
+			size_t sync = FindSweepSync(chunks[i - 1].tail, chunks[i].head);
+			if (sync == X86_SWEEP_SYNC_WINDOW)
+			{
+				sync = FindSweepSync(chunks[i - 1].tail, chunks[i - 1].tail);
+				ScanSweepChunk(&ctx, &chunks[i], chunks[i].base + sync);
+			}
+			chunks[i].start = chunks[i].base + sync;
+		}
+
+		// Instructions in the head of a chunk before its start belong to the previous chunk, and are
+		// counted from its tail instead
+		for (size_t i = 0; i < chunkCount; i++)
+		{
+			size_t count = chunks[i].count - CountSweepBits(chunks[i].head, chunks[i].start - chunks[i].base);
+			if (i < (chunkCount - 1))
+				count += CountSweepBits(chunks[i].tail, chunks[i + 1].start - chunks[i + 1].base);
+			if (count > (maxCount - total))
+				count = maxCount - total;
+			chunks[i].count = count;
+			chunks[i].firstResult = total;
+			total += count;
+		}
+
+		RunSweepTasks(runner, runnerContext, DecodeSweepTask, &ctx, chunkCount);
+
+		for (size_t i = 0; i < chunkCount; i++)
+		{
+			if (chunks[i].count != 0)
+				end = chunks[i].nextOffset;
+		}
+		if (nextOffset)
+			*nextOffset = end;
+		return total;
+	}
+
+
+	size_t ParallelSweep16(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results, size_t maxCount,
+		X86SweepChunk* chunks, size_t chunkCount, X86TaskRunner runner, void* runnerContext, size_t* nextOffset)
 	{
-		uint8_t rmByte = Read8(state);
-		state->result->operation = (InstructionOperation)groupOperations[(int)state->result->operation][rmByte & 7];
+		return ParallelSweep(opcode, addr, len, results, maxCount, chunks, chunkCount, runner, runnerContext,
+			nextOffset, 2, 2, false, DECODER_16(DecodeInstruction));
 	}
 
 
-	static void DecodeRegGroupAX(DecodeState* state)
+	size_t ParallelSweep32(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results, size_t maxCount,
+		X86SweepChunk* chunks, size_t chunkCount, X86TaskRunner runner, void* runnerContext, size_t* nextOffset)
 	{
-		DecodeRegGroupNoOperands(state);
-		state->operand0->operand = REG_AX;
-		state->operand0->size = 2;
+		return ParallelSweep(opcode, addr, len, results, maxCount, chunks, chunkCount, runner, runnerContext,
+			nextOffset, 4, 4, false, DECODER_32(DecodeInstruction));
 	}
 
 
-	static void DecodeCmpXch8B(DecodeState* state)
+	size_t ParallelSweep64(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results, size_t maxCount,
+		X86SweepChunk* chunks, size_t chunkCount, X86TaskRunner runner, void* runnerContext, size_t* nextOffset)
 	{
-		uint8_t rm = Peek8(state);
-		uint8_t regField = (rm >> 3) & 7;
+		return ParallelSweep(opcode, addr, len, results, maxCount, chunks, chunkCount, runner, runnerContext,
+			nextOffset, 8, 4, true, DECODER_64(DecodeInstruction));
+	}
+
+
+#define CFG_INSTRUCTION                 1
+#define CFG_LEADER                      2
+#define CFG_QUEUED                      4
+
+#define CFG_FLOW_NEXT                   0
+#define CFG_FLOW_CALL                   1
+#define CFG_FLOW_JUMP                   2
+#define CFG_FLOW_CONDITIONAL            3
+#define CFG_FLOW_INDIRECT               4
+#define CFG_FLOW_RETURN                 5
+
+// Instructions traced by each task of a parallel traversal before the remaining work is shared out again
+#define CFG_TASK_BUDGET                 4096
 
-		if (regField == 1)
+	typedef struct
+	{
+		const uint8_t* opcode;
+		uint64_t addr;
+		size_t len;
+		uint8_t* flags;
+		uint32_t* worklist;
+		size_t worklistCount;
+		size_t worklistMax;
+		bool overflow;
+		bool parallel;
+		Instruction instr;
+		bool decoded;
+		uint16_t addrSize;
+		uint16_t opSize;
+		bool using64;
+		DecodeInstructionFunction decode;
+		DecodeInstructionFunction decodeNext;
+
+		// Work assigned to a task of a parallel traversal
+		const uint32_t* frontier;
+		size_t frontierStart;
+		size_t frontierEnd;
+		X86ControlFlowGraph* cfg;
+		size_t firstBlock;
+		size_t lastBlock;
+	} CfgContext;
+
+
+	// Sets bits in the state of a byte of code and returns the previous state. Tasks of a parallel
+	// traversal share the state, and use an atomic update so that exactly one of them decodes each
+	// instruction.
+	static uint8_t MarkCfg(CfgContext* ctx, size_t offset, uint8_t bits)
+	{
+		uint8_t prev;
+		if (ctx->parallel)
 		{
-			if (state->opSize == 2)
-				state->opSize = 4;
-			else if (state->opSize == 8)
-				state->result->operation = CMPXCH16B;
-			DecodeRM(state, state->operand0, GetRegListForOpSize(state), state->opSize * 2, NULL);
+#ifdef _MSC_VER
+			return (uint8_t)_InterlockedOr8((volatile char*)&ctx->flags[offset], (char)bits);
+#else
+			return __sync_fetch_and_or(&ctx->flags[offset], bits);
+#endif
 		}
-		else if (regField == 6)
+		prev = ctx->flags[offset];
+		ctx->flags[offset] = prev | bits;
+		return prev;
+	}
+
+
+	static bool DecodeCfgInstruction(CfgContext* ctx, size_t offset)
+	{
+		DecodeState state;
+		size_t remaining = ctx->len - offset;
+
+		// All instructions are decoded into the same Instruction, so only the first needs a full clear
+		state.result = &ctx->instr;
+		state.opcodeStart = &ctx->opcode[offset];
+		state.opcode = state.opcodeStart;
+		state.addr = ctx->addr + offset;
+		state.len = (remaining > 15) ? 15 : remaining;
+		state.addrSize = ctx->addrSize;
+		state.opSize = ctx->opSize;
+		state.using64 = ctx->using64;
+		if (!ctx->decoded)
 		{
-			if (state->opPrefix)
-				state->result->operation = VMCLEAR;
-			else if (state->rep == REP_PREFIX_REPE)
-				state->result->operation = VMXON;
-			else
-				state->result->operation = VMPTRLD;
-			DecodeRM(state, state->operand0, reg64List, 8, NULL);
+			ctx->decoded = true;
+			return ctx->decode(&state);
 		}
-		else if (regField == 7)
+		return ctx->decodeNext(&state);
+	}
+
+
+	static uint8_t GetCfgFlow(const Instruction* instr)
+	{
+		switch (instr->operation)
 		{
-			state->result->operation = VMPTRST;
-			DecodeRM(state, state->operand0, reg64List, 8, NULL);
+		case CALL:
+			return (instr->operands[0].operand == IMM) ? CFG_FLOW_CALL : CFG_FLOW_NEXT;
+		case JMP:
+			return (instr->operands[0].operand == IMM) ? CFG_FLOW_JUMP : CFG_FLOW_INDIRECT;
+		case JO: case JNO: case JB: case JAE: case JE: case JNE: case JBE: case JA:
+		case JS: case JNS: case JPE: case JPO: case JL: case JGE: case JLE: case JG:
+		case JCXZ: case JECXZ: case JRCXZ: case LOOP: case LOOPE: case LOOPNE:
+			return CFG_FLOW_CONDITIONAL;
+		case JMPF:
+			return CFG_FLOW_INDIRECT;
+		case RETN: case RETF: case IRET: case SYSRET: case SYSEXIT: case RSM: case HLT: case UD2:
+			return CFG_FLOW_RETURN;
+		default:
+			return CFG_FLOW_NEXT;
 		}
-		else
-			state->invalid = true;
-
-		if (state->operand0->operand != MEM)
-			state->invalid = true;
 	}
 
 
-	static void DecodeMovNti(DecodeState* state)
+	// Marks the start of a basic block at target, and queues it for decoding if it has not been seen.
+	// Targets outside of the range are ignored here, and flagged when the graph is built.
+	static void AddCfgLeader(CfgContext* ctx, uint64_t target)
 	{
-		if (state->opSize == 2)
-			state->opSize = 4;
-		DecodeRMReg(state, state->operand0, GetRegListForOpSize(state), state->opSize, state->operand1, GetRegListForOpSize(state), state->opSize);
-		if (state->operand0->operand != MEM)
-			state->invalid = true;
+		size_t offset;
+		if ((target < ctx->addr) || ((target - ctx->addr) >= ctx->len))
+			return;
+
+		offset = (size_t)(target - ctx->addr);
+		if (MarkCfg(ctx, offset, CFG_LEADER | CFG_QUEUED) & (CFG_INSTRUCTION | CFG_QUEUED))
+			return;
+		if (ctx->worklistCount >= ctx->worklistMax)
+		{
+			ctx->overflow = true;
+			return;
+		}
+		ctx->worklist[ctx->worklistCount++] = (uint32_t)offset;
 	}
 
 
-	static void DecodeCrc32(DecodeState* state)
+	// Decodes the code reachable from a queued block start, marking the instructions and the starts
+	// of the blocks that branches lead to. Returns the number of instructions decoded.
+	static size_t TraceCfgCode(CfgContext* ctx, size_t offset)
 	{
-		const RegDef* srcRegList = GetRegListForFinalOpSize(state);
-		const RegDef* destRegList = (state->opSize == 8) ? reg64List : reg32List;
-		uint16_t destSize = (state->opSize == 8) ? 8 : 4;
-		DecodeRMReg(state, state->operand1, srcRegList, state->finalOpSize, state->operand0, destRegList, destSize);
+		size_t count = 0;
+		while (offset < ctx->len)
+		{
+			uint8_t flow;
+
+			// Code that was already decoded is entered, so a block starts there. Which trace gets to an
+			// instruction first does not change the graph, as the block starts either way.
+			if (MarkCfg(ctx, offset, CFG_INSTRUCTION) & CFG_INSTRUCTION)
+			{
+				MarkCfg(ctx, offset, CFG_LEADER);
+				break;
+			}
+			count++;
+			if (!DecodeCfgInstruction(ctx, offset))
+				break;
+
+			flow = GetCfgFlow(&ctx->instr);
+			if ((flow == CFG_FLOW_CALL) || (flow == CFG_FLOW_JUMP) || (flow == CFG_FLOW_CONDITIONAL))
+				AddCfgLeader(ctx, (uint64_t)ctx->instr.operands[0].immediate);
+			offset += ctx->instr.length;
+
+			if (flow == CFG_FLOW_CONDITIONAL)
+			{
+				AddCfgLeader(ctx, ctx->addr + offset);
+				break;
+			}
+			if ((flow == CFG_FLOW_JUMP) || (flow == CFG_FLOW_INDIRECT) || (flow == CFG_FLOW_RETURN))
+				break;
+		}
+		return count;
 	}
 
 
-	static void DecodeArpl(DecodeState* state)
+	static size_t FindCfgBlock(const X86BasicBlock* blocks, size_t count, uint64_t addr)
 	{
-		if (state->using64)
+		size_t low = 0;
+		size_t high = count;
+		while (low < high)
 		{
-			// In 64-bit ARPL is repurposed to MOVSXD
-			const RegDef* regList = GetRegListForFinalOpSize(state);
-			state->result->operation = MOVSXD;
-			DecodeRMReg(state, state->operand1, reg32List, 4, state->operand0, regList, state->finalOpSize);
+			size_t mid = low + ((high - low) / 2);
+			if (blocks[mid].addr < addr)
+				low = mid + 1;
+			else
+				high = mid;
 		}
-		else
+		return low;
+	}
+
+
+	static void AddCfgSuccessor(const X86ControlFlowGraph* cfg, X86BasicBlock* block, uint32_t* successors,
+		uint64_t target)
+	{
+		size_t index = FindCfgBlock(cfg->blocks, cfg->blockCount, target);
+		if ((index >= cfg->blockCount) || (cfg->blocks[index].addr != target))
 		{
-			// ARPL instruction
-			state->operand0 = &state->result->operands[1];
-			state->operand1 = &state->result->operands[0];
-			state->finalOpSize = 2;
-			DecodeRegRM(state);
+			block->flags |= X86_BLOCK_EXTERNAL;
+			return;
 		}
+		if ((block->successorCount == 1) && (successors[0] == (uint32_t)index))
+			return;
+		successors[block->successorCount++] = (uint32_t)index;
 	}
 
 
-	static void ProcessPrefixes(DecodeState* state)
+	// Walks the instructions of a block again to find how it ends and connect it to its successors,
+	// which are written to successors
+	static void BuildCfgBlock(CfgContext* ctx, const X86ControlFlowGraph* cfg, X86BasicBlock* block,
+		uint32_t* successors)
 	{
-		uint8_t rex = 0;
-		bool addrPrefix = false;
+		size_t start = (size_t)(block->addr - ctx->addr);
+		size_t offset = start;
 
-		while (!state->invalid)
+		while (true)
 		{
-			uint8_t prefix = Read8(state);
-			if ((prefix >= 0x26) && (prefix <= 0x3e) && ((prefix & 7) == 6))
+			uint8_t flow;
+
+			if (!DecodeCfgInstruction(ctx, offset))
 			{
-				// Segment prefix
-				state->result->segment = (SegmentRegister)(SEG_ES + ((prefix >> 3) - 4));
+				block->flags |= X86_BLOCK_INVALID;
+				break;
 			}
-			else if ((prefix == 0x64) || (prefix == 0x65))
+			block->instructionCount++;
+			flow = GetCfgFlow(&ctx->instr);
+			offset += ctx->instr.length;
+
+			if ((flow == CFG_FLOW_JUMP) || (flow == CFG_FLOW_CONDITIONAL))
 			{
-				// FS/GS prefix
-				state->result->segment = (SegmentRegister)(SEG_ES + (prefix - 0x60));
+				block->flags |= X86_BLOCK_BRANCH;
+				AddCfgSuccessor(cfg, block, successors, (uint64_t)ctx->instr.operands[0].immediate);
+				if (flow == CFG_FLOW_CONDITIONAL)
+					AddCfgSuccessor(cfg, block, successors, ctx->addr + offset);
+				break;
 			}
-			else if (prefix == 0x66)
+			if (flow == CFG_FLOW_INDIRECT)
 			{
-				state->opPrefix = true;
-				state->result->flags |= X86_FLAG_OPSIZE;
+				block->flags |= X86_BLOCK_INDIRECT;
+				break;
 			}
-			else if (prefix == 0x67)
+			if (flow == CFG_FLOW_RETURN)
 			{
-				addrPrefix = true;
-				state->result->flags |= X86_FLAG_ADDRSIZE;
+				block->flags |= X86_BLOCK_RETURN;
+				break;
 			}
-			else if (prefix == 0xf0)
-				state->result->flags |= X86_FLAG_LOCK;
-			else if (prefix == 0xf2)
-				state->rep = REP_PREFIX_REPNE;
-			else if (prefix == 0xf3)
-				state->rep = REP_PREFIX_REPE;
-			else if (state->using64 && (prefix >= 0x40) && (prefix <= 0x4f))
+
+			if (offset >= ctx->len)
 			{
-				// REX prefix
-				rex = prefix;
-				continue;
+				// Code runs off the end of the range
+				block->flags |= X86_BLOCK_INVALID;
+				break;
 			}
-			else
+			if (ctx->flags[offset] & CFG_LEADER)
 			{
-				// Not a prefix, continue instruction processing
-				state->opcode--;
-				state->len++;
+				AddCfgSuccessor(cfg, block, successors, ctx->addr + offset);
+				break;
+			}
+		}
+		block->length = (uint32_t)(offset - start);
+	}
+
+
+	// Takes size bytes from the front of the memory, aligned for any of the structures
+	static void* TakeCfgMemory(uint8_t** memory, size_t* memorySize, size_t size)
+	{
+		size_t align = (size_t)(-(intptr_t)*memory) & 7;
+		void* result;
+		if ((align > *memorySize) || (size > (*memorySize - align)))
+			return NULL;
+		result = *memory + align;
+		*memory += align + size;
+		*memorySize -= align + size;
+		return result;
+	}
+
+
+	static void InitCfgContext(CfgContext* ctx, const uint8_t* opcode, uint64_t addr, size_t len, uint16_t addrSize,
+		uint16_t opSize, bool using64, DecodeInstructionFunction decode, DecodeInstructionFunction decodeNext)
+	{
+		ctx->opcode = opcode;
+		ctx->addr = addr;
+		ctx->len = len;
+		ctx->flags = NULL;
+		ctx->worklist = NULL;
+		ctx->worklistCount = 0;
+		ctx->worklistMax = 0;
+		ctx->overflow = false;
+		ctx->parallel = false;
+		ctx->decoded = false;
+		ctx->addrSize = addrSize;
+		ctx->opSize = opSize;
+		ctx->using64 = using64;
+		ctx->decode = decode;
+		ctx->decodeNext = decodeNext;
+		ctx->frontier = NULL;
+		ctx->frontierStart = 0;
+		ctx->frontierEnd = 0;
+		ctx->cfg = NULL;
+		ctx->firstBlock = 0;
+		ctx->lastBlock = 0;
+	}
+
+
+	// Creates a block at every leader that has been decoded, in address order, from the given memory.
+	// Each block is given room for two successors.
+	static bool AllocateCfgBlocks(const CfgContext* ctx, X86ControlFlowGraph* cfg, uint8_t* memory, size_t memorySize)
+	{
+		size_t blockCount = 0;
+
+		for (size_t i = 0; i < ctx->len; i++)
+		{
+			if ((ctx->flags[i] & (CFG_LEADER | CFG_INSTRUCTION)) == (CFG_LEADER | CFG_INSTRUCTION))
+				blockCount++;
+		}
+
+		cfg->blocks = (X86BasicBlock*)TakeCfgMemory(&memory, &memorySize, blockCount * sizeof(X86BasicBlock));
+		cfg->successors = (uint32_t*)TakeCfgMemory(&memory, &memorySize, blockCount * 2 * sizeof(uint32_t));
+		if ((!cfg->blocks) || (!cfg->successors))
+		{
+			cfg->blocks = NULL;
+			cfg->successors = NULL;
+			return false;
+		}
+
+		for (size_t i = 0; i < ctx->len; i++)
+		{
+			if ((ctx->flags[i] & (CFG_LEADER | CFG_INSTRUCTION)) == (CFG_LEADER | CFG_INSTRUCTION))
+			{
+				X86BasicBlock* block = &cfg->blocks[cfg->blockCount++];
+				block->addr = ctx->addr + i;
+				block->length = 0;
+				block->instructionCount = 0;
+				block->firstSuccessor = 0;
+				block->successorCount = 0;
+				block->flags = 0;
+			}
+		}
+		return true;
+	}
+
+
+	static void ClearCfg(X86ControlFlowGraph* cfg)
+	{
+		cfg->blocks = NULL;
+		cfg->blockCount = 0;
+		cfg->successors = NULL;
+		cfg->successorCount = 0;
+	}
+
+
+	static bool BuildControlFlowGraph(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86ControlFlowGraph* cfg, uint16_t addrSize,
+		uint16_t opSize, bool using64, DecodeInstructionFunction decode, DecodeInstructionFunction decodeNext)
+	{
+		CfgContext ctx;
+		uint8_t* cursor = (uint8_t*)memory;
+		uint8_t* worklistStart;
+		size_t worklistSize;
+
+		ClearCfg(cfg);
+		if (len > 0xffffffff)
+			return false;
+		InitCfgContext(&ctx, opcode, addr, len, addrSize, opSize, using64, decode, decodeNext);
+
+		// There is a byte of state for each byte of code. The worklist uses the rest of the memory, which
+		// is given to the graph once the code has been traced.
+		ctx.flags = (uint8_t*)TakeCfgMemory(&cursor, &memorySize, len);
+		if (!ctx.flags)
+			return false;
+		memset(ctx.flags, 0, len);
+		worklistStart = cursor;
+		worklistSize = memorySize;
+		ctx.worklist = (uint32_t*)TakeCfgMemory(&cursor, &memorySize, 0);
+		if (!ctx.worklist)
+			return false;
+		ctx.worklistMax = memorySize / sizeof(uint32_t);
+
+		for (size_t i = 0; i < entryCount; i++)
+			AddCfgLeader(&ctx, entries[i]);
+		while ((ctx.worklistCount > 0) && (!ctx.overflow))
+			TraceCfgCode(&ctx, ctx.worklist[--ctx.worklistCount]);
+		if (ctx.overflow)
+			return false;
+
+		if (!AllocateCfgBlocks(&ctx, cfg, worklistStart, worklistSize))
+			return false;
+		for (size_t i = 0; i < cfg->blockCount; i++)
+		{
+			X86BasicBlock* block = &cfg->blocks[i];
+			block->firstSuccessor = (uint32_t)cfg->successorCount;
+			BuildCfgBlock(&ctx, cfg, block, &cfg->successors[cfg->successorCount]);
+			cfg->successorCount += block->successorCount;
+		}
+		return true;
+	}
+
+
+	static void TraceCfgTask(void* arg, size_t index)
+	{
+		CfgContext* ctx = &((CfgContext*)arg)[index];
+		size_t traced = 0;
+
+		// New block starts are traced depth first from the task's own worklist, and the task takes more
+		// from its part of the shared frontier when that runs out
+		while ((traced < CFG_TASK_BUDGET) && (!ctx->overflow))
+		{
+			size_t offset;
+			if (ctx->worklistCount > 0)
+				offset = ctx->worklist[--ctx->worklistCount];
+			else if (ctx->frontierStart < ctx->frontierEnd)
+				offset = ctx->frontier[ctx->frontierStart++];
+			else
 				break;
+			traced += TraceCfgCode(ctx, offset);
+		}
+	}
+
+
+	static void BuildCfgTask(void* arg, size_t index)
+	{
+		CfgContext* ctx = &((CfgContext*)arg)[index];
+
+		// Successors are written to fixed slots for each block, and packed together afterwards
+		for (size_t i = ctx->firstBlock; i < ctx->lastBlock; i++)
+			BuildCfgBlock(ctx, ctx->cfg, &ctx->cfg->blocks[i], &ctx->cfg->successors[i * 2]);
+	}
+
+
+	static void RunCfgTasks(X86TaskRunner runner, void* runnerContext, X86TaskFunction func, CfgContext* tasks,
+		size_t count)
+	{
+		if (runner)
+		{
+			runner(runnerContext, func, tasks, count);
+			return;
+		}
+		for (size_t i = 0; i < count; i++)
+			func(tasks, i);
+	}
+
+
+	static bool BuildControlFlowGraphParallel(const uint8_t* opcode, uint64_t addr, size_t len,
+		const uint64_t* entries, size_t entryCount, void* memory, size_t memorySize, X86TaskRunner runner,
+		void* runnerContext, size_t taskCount, X86ControlFlowGraph* cfg, uint16_t addrSize, uint16_t opSize,
+		bool using64, DecodeInstructionFunction decode, DecodeInstructionFunction decodeNext)
+	{
+		CfgContext ctx;
+		CfgContext* tasks;
+		uint8_t* cursor = (uint8_t*)memory;
+		uint8_t* workStart;
+		size_t workSize;
+		uint32_t* frontier[2];
+		size_t frontierCount;
+		size_t current = 0;
+		size_t bufferMax;
+
+		ClearCfg(cfg);
+		if (len > 0xffffffff)
+			return false;
+		if (taskCount == 0)
+			taskCount = 1;
+		InitCfgContext(&ctx, opcode, addr, len, addrSize, opSize, using64, decode, decodeNext);
+
+		ctx.flags = (uint8_t*)TakeCfgMemory(&cursor, &memorySize, len);
+		tasks = (CfgContext*)TakeCfgMemory(&cursor, &memorySize, taskCount * sizeof(CfgContext));
+		if ((!ctx.flags) || (!tasks))
+			return false;
+		memset(ctx.flags, 0, len);
+
+		// The rest of the memory is split between two frontier buffers and a worklist for each task
+		workStart = cursor;
+		workSize = memorySize;
+		bufferMax = ((memorySize / (taskCount + 2)) & ~(size_t)7) / sizeof(uint32_t);
+		if (bufferMax < 2)
+			return false;
+		frontier[0] = (uint32_t*)TakeCfgMemory(&cursor, &memorySize, bufferMax * sizeof(uint32_t));
+		frontier[1] = (uint32_t*)TakeCfgMemory(&cursor, &memorySize, bufferMax * sizeof(uint32_t));
+		for (size_t i = 0; i < taskCount; i++)
+		{
+			tasks[i] = ctx;
+			tasks[i].parallel = true;
+			tasks[i].worklist = (uint32_t*)TakeCfgMemory(&cursor, &memorySize, bufferMax * sizeof(uint32_t));
+			tasks[i].worklistMax = bufferMax;
+			if (!tasks[i].worklist)
+				return false;
+		}
+		if ((!frontier[0]) || (!frontier[1]))
+			return false;
+
+		ctx.worklist = frontier[0];
+		ctx.worklistMax = bufferMax;
+		for (size_t i = 0; i < entryCount; i++)
+			AddCfgLeader(&ctx, entries[i]);
+		if (ctx.overflow)
+			return false;
+		frontierCount = ctx.worklistCount;
+
+		// Each round splits the frontier evenly between the tasks. A task stops after a fixed amount of
+		// work, and whatever it has not traced is gathered into the frontier for the next round, so that
+		// work found by one task is spread across all of them.
+		while (frontierCount > 0)
+		{
+			uint32_t* next = frontier[current ^ 1];
+			size_t nextCount = 0;
+
+			for (size_t i = 0; i < taskCount; i++)
+			{
+				tasks[i].frontier = frontier[current];
+				tasks[i].frontierStart = (i * frontierCount) / taskCount;
+				tasks[i].frontierEnd = ((i + 1) * frontierCount) / taskCount;
+				tasks[i].worklistCount = 0;
 			}
+			RunCfgTasks(runner, runnerContext, TraceCfgTask, tasks, taskCount);
 
-			// Force ignore REX unless it is the last prefix
-			rex = 0;
+			for (size_t i = 0; i < taskCount; i++)
+			{
+				size_t remaining = tasks[i].frontierEnd - tasks[i].frontierStart;
+				if (tasks[i].overflow || ((remaining + tasks[i].worklistCount) > (bufferMax - nextCount)))
+					return false;
+				memcpy(&next[nextCount], &tasks[i].frontier[tasks[i].frontierStart], remaining * sizeof(uint32_t));
+				nextCount += remaining;
+				memcpy(&next[nextCount], tasks[i].worklist, tasks[i].worklistCount * sizeof(uint32_t));
+				nextCount += tasks[i].worklistCount;
+			}
+			current ^= 1;
+			frontierCount = nextCount;
 		}
 
-		if (state->opPrefix)
-			state->opSize = (state->opSize == 2) ? 4 : 2;
-		if (addrPrefix)
-			state->addrSize = (state->addrSize == 4) ? 2 : 4;
+		if (!AllocateCfgBlocks(&ctx, cfg, workStart, workSize))
+			return false;
+		for (size_t i = 0; i < taskCount; i++)
+		{
+			tasks[i].cfg = cfg;
+			tasks[i].firstBlock = (i * cfg->blockCount) / taskCount;
+			tasks[i].lastBlock = ((i + 1) * cfg->blockCount) / taskCount;
+		}
+		RunCfgTasks(runner, runnerContext, BuildCfgTask, tasks, taskCount);
 
-		if (rex)
+		// Pack the successors in block order, giving the same layout as a serial traversal
+		for (size_t i = 0; i < cfg->blockCount; i++)
 		{
-			// REX prefix found before opcode
-			state->rex = true;
-			state->rexRM1 = (rex & 1) != 0;
-			state->rexRM2 = (rex & 2) != 0;
-			state->rexReg = (rex & 4) != 0;
-			if (rex & 8)
-				state->opSize = 8;
+			X86BasicBlock* block = &cfg->blocks[i];
+			block->firstSuccessor = (uint32_t)cfg->successorCount;
+			for (size_t j = 0; j < block->successorCount; j++)
+				cfg->successors[cfg->successorCount++] = cfg->successors[(i * 2) + j];
 		}
+		return true;
 	}
 
 
-	static void ClearOperand(InstructionOperand* oper)
+	bool BuildControlFlowGraph16(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86ControlFlowGraph* cfg)
 	{
-		oper->operand = NONE;
-		oper->components[0] = NONE;
-		oper->components[1] = NONE;
-		oper->scale = 1;
-		oper->immediate = 0;
-		oper->relative = false;
+		return BuildControlFlowGraph(opcode, addr, len, entries, entryCount, memory, memorySize, cfg, 2, 2, false,
+			DECODER_16(DecodeInstruction), DECODER_16(DecodeNextInstruction));
 	}
 
 
-	static void InitDisassemble(DecodeState* state)
+	bool BuildControlFlowGraph32(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86ControlFlowGraph* cfg)
 	{
-		ClearOperand(&state->result->operands[0]);
-		ClearOperand(&state->result->operands[1]);
-		ClearOperand(&state->result->operands[2]);
-		state->result->operation = INVALID;
-		state->result->flags = 0;
-		state->result->segment = SEG_DEFAULT;
-		state->invalid = false;
-		state->insufficientLength = false;
-		state->opPrefix = false;
-		state->rep = REP_PREFIX_NONE;
-		state->ripRelFixup = NULL;
-		state->rex = false;
-		state->rexReg = false;
-		state->rexRM1 = false;
-		state->rexRM2 = false;
-		state->origLen = state->len;
+		return BuildControlFlowGraph(opcode, addr, len, entries, entryCount, memory, memorySize, cfg, 4, 4, false,
+			DECODER_32(DecodeInstruction), DECODER_32(DecodeNextInstruction));
 	}
 
 
-	static void FinishDisassemble(DecodeState* state)
+	bool BuildControlFlowGraph64(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86ControlFlowGraph* cfg)
 	{
-		state->result->length = state->opcode - state->opcodeStart;
-		if (state->ripRelFixup)
-			*state->ripRelFixup += state->addr + state->result->length;
-		if (state->insufficientLength && (state->origLen < 15))
-			state->result->flags |= X86_FLAG_INSUFFICIENT_LENGTH;
+		return BuildControlFlowGraph(opcode, addr, len, entries, entryCount, memory, memorySize, cfg, 8, 4, true,
+			DECODER_64(DecodeInstruction), DECODER_64(DecodeNextInstruction));
 	}
 
 
-	bool Disassemble16(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result)
+	bool BuildControlFlowGraphParallel16(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86TaskRunner runner, void* runnerContext,
+		size_t taskCount, X86ControlFlowGraph* cfg)
 	{
-		DecodeState state;
-		state.result = result;
-		state.opcodeStart = opcode;
-		state.opcode = opcode;
-		state.addr = addr;
-		state.len = (maxLen > 15) ? 15 : maxLen;
-		state.addrSize = 2;
-		state.opSize = 2;
-		state.using64 = false;
-		InitDisassemble(&state);
-
-		ProcessPrefixes(&state);
-		ProcessOpcode(&state, mainOpcodeMap, Read8(&state));
-		FinishDisassemble(&state);
-		return !state.invalid;
+		return BuildControlFlowGraphParallel(opcode, addr, len, entries, entryCount, memory, memorySize, runner,
+			runnerContext, taskCount, cfg, 2, 2, false, DECODER_16(DecodeInstruction), DECODER_16(DecodeNextInstruction));
 	}
 
 
-	bool Disassemble32(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result)
+	bool BuildControlFlowGraphParallel32(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86TaskRunner runner, void* runnerContext,
+		size_t taskCount, X86ControlFlowGraph* cfg)
 	{
-		DecodeState state;
-		state.result = result;
-		state.opcodeStart = opcode;
-		state.opcode = opcode;
-		state.addr = addr;
-		state.len = (maxLen > 15) ? 15 : maxLen;
-		state.addrSize = 4;
-		state.opSize = 4;
-		state.using64 = false;
-		InitDisassemble(&state);
-
-		ProcessPrefixes(&state);
-		ProcessOpcode(&state, mainOpcodeMap, Read8(&state));
-		FinishDisassemble(&state);
-		return !state.invalid;
+		return BuildControlFlowGraphParallel(opcode, addr, len, entries, entryCount, memory, memorySize, runner,
+			runnerContext, taskCount, cfg, 4, 4, false, DECODER_32(DecodeInstruction), DECODER_32(DecodeNextInstruction));
 	}
 
 
-	bool Disassemble64(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result)
+	bool BuildControlFlowGraphParallel64(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86TaskRunner runner, void* runnerContext,
+		size_t taskCount, X86ControlFlowGraph* cfg)
 	{
-		DecodeState state;
-		state.result = result;
-		state.opcodeStart = opcode;
-		state.opcode = opcode;
-		state.addr = addr;
-		state.len = (maxLen > 15) ? 15 : maxLen;
-		state.addrSize = 8;
-		state.opSize = 4;
-		state.using64 = true;
-		InitDisassemble(&state);
-
-		ProcessPrefixes(&state);
-		ProcessOpcode(&state, mainOpcodeMap, Read8(&state));
-		FinishDisassemble(&state);
-		return !state.invalid;
+		return BuildControlFlowGraphParallel(opcode, addr, len, entries, entryCount, memory, memorySize, runner,
+			runnerContext, taskCount, cfg, 8, 4, true, DECODER_64(DecodeInstruction), DECODER_64(DecodeNextInstruction));
 	}
 
 
@@ -2527,23 +3913,49 @@ namespace x86
 	}
 
 
-	static void WriteHex(char** out, size_t* outMaxLen, uint64_t val, uint32_t width, bool prefix)
+	static void WriteStringLength(char** out, size_t* outMaxLen, const char* str, size_t len)
 	{
-		char temp[17];
-		int32_t i;
-		if (prefix)
-			WriteString(out, outMaxLen, "0x");
+		for (size_t i = 0; i < len; i++)
+			WriteChar(out, outMaxLen, str[i]);
+	}
+
+
+	static const char hexDigitPairs[] =
+		"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+		"202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+		"404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+		"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+		"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+		"a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		"c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		"e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+
+	// Writes the low width digits of val (at most 16) and returns the end of the digits. Two digits
+	// are written for each table lookup.
+	static char* FormatHex(char* out, uint64_t val, uint32_t width)
+	{
+		char* end;
 		if (width > 16)
 			width = 16;
-		for (i = (width - 1); i >= 0; i--, val >>= 4)
+		end = out + width;
+		for (out = end; width >= 2; width -= 2, val >>= 8)
 		{
-			char digit = (char)(val & 0xf);
-			if (digit < 10)
-				temp[i] = digit + '0';
-			else
-				temp[i] = digit + 'a' - 10;
+			out -= 2;
+			memcpy(out, &hexDigitPairs[(val & 0xff) * 2], 2);
 		}
-		temp[width] = 0;
+		if (width)
+			*(--out) = hexDigitPairs[((val & 0xf) * 2) + 1];
+		return end;
+	}
+
+
+	static void WriteHex(char** out, size_t* outMaxLen, uint64_t val, uint32_t width, bool prefix)
+	{
+		char temp[17];
+		if (prefix)
+			WriteString(out, outMaxLen, "0x");
+		*FormatHex(temp, val, width) = 0;
 		WriteString(out, outMaxLen, temp);
 	}
 
@@ -2576,7 +3988,8 @@ namespace x86
 	{
 		if (plus)
 			WriteString(out, outMaxLen, "+");
-		WriteString(out, outMaxLen, operandString[type]);
+		WriteStringLength(out, outMaxLen, &operandStringData[operandStringOffset[type]],
+			operandStringLength[type]);
 		if (scale != 1)
 		{
 			WriteChar(out, outMaxLen, '*');
@@ -2585,125 +3998,425 @@ namespace x86
 	}
 
 
-	size_t FormatInstructionString(char* out, size_t outMaxLen, const char* fmt, const uint8_t* opcode,
-		uint64_t addr, const Instruction* instr)
+	static void WriteBytes(char** out, size_t* outMaxLen, const uint8_t* opcode, const Instruction* instr, uint32_t width)
 	{
-		char* start = out;
-		size_t len;
-		for (; *fmt; fmt++)
+		size_t i;
+		for (i = 0; i < instr->length; i++)
+			WriteHex(out, outMaxLen, opcode[i], 2, false);
+		for (; i < width; i++)
+			WriteString(out, outMaxLen, "  ");
+	}
+
+
+	static void WriteMnemonic(char** out, size_t* outMaxLen, const Instruction* instr, uint32_t width)
+	{
+		char* operationStart = *out;
+		if (instr->flags & X86_FLAG_ANY_REP)
+		{
+			WriteString(out, outMaxLen, "rep");
+			if (instr->flags & X86_FLAG_REPNE)
+				WriteChar(out, outMaxLen, 'n');
+			if (instr->flags & (X86_FLAG_REPNE | X86_FLAG_REPE))
+				WriteChar(out, outMaxLen, 'e');
+			WriteChar(out, outMaxLen, ' ');
+		}
+		if (instr->flags & X86_FLAG_LOCK)
+			WriteString(out, outMaxLen, "lock ");
+		WriteStringLength(out, outMaxLen, &operationStringData[operationStringOffset[instr->operation]],
+			operationStringLength[instr->operation]);
+		for (; ((size_t)(*out - operationStart) < (size_t)width) && (*outMaxLen > 1); )
+			WriteChar(out, outMaxLen, ' ');
+	}
+
+
+	static void WriteOperands(char** out, size_t* outMaxLen, const Instruction* instr)
+	{
+		uint32_t i;
+		for (i = 0; i < 3; i++)
 		{
-			if (*fmt == '%')
+			if (instr->operands[i].operand == NONE)
+				break;
+			if (i != 0)
+				WriteString(out, outMaxLen, ", ");
+			if (instr->operands[i].operand == IMM)
+				WriteHex(out, outMaxLen, instr->operands[i].immediate, instr->operands[i].size * 2, true);
+			else if (instr->operands[i].operand == MEM)
 			{
-				uint32_t width = 0;
-				for (fmt++; *fmt; fmt++)
+				bool plus = false;
+				WriteString(out, outMaxLen, GetSizeString(instr->operands[i].size));
+				if ((instr->segment != SEG_DEFAULT) || (instr->operands[i].segment == SEG_ES))
+				{
+					WriteOperand(out, outMaxLen, (OperandType)(instr->operands[i].segment + REG_ES), 1, false);
+					WriteChar(out, outMaxLen, ':');
+				}
+				WriteChar(out, outMaxLen, '[');
+				if (instr->operands[i].components[0] != NONE)
+				{
+					WriteOperand(out, outMaxLen, instr->operands[i].components[0], 1, false);
+					plus = true;
+				}
+				if (instr->operands[i].components[1] != NONE)
+				{
+					WriteOperand(out, outMaxLen, instr->operands[i].components[1], instr->operands[i].scale, plus);
+					plus = true;
+				}
+				if ((instr->operands[i].immediate != 0) || ((instr->operands[i].components[0] == NONE) &&
+					(instr->operands[i].components[1] == NONE)))
 				{
-					if (*fmt == 'a')
+					if (plus && ((int64_t)instr->operands[i].immediate >= -0x80) &&
+						((int64_t)instr->operands[i].immediate < 0))
+					{
+						WriteChar(out, outMaxLen, '-');
+						WriteHex(out, outMaxLen, -(int64_t)instr->operands[i].immediate, 2, true);
+					}
+					else if (plus && ((int64_t)instr->operands[i].immediate > 0) &&
+						((int64_t)instr->operands[i].immediate <= 0x7f))
 					{
-						if (width == 0)
-							width = sizeof(void*) * 2;
-						WriteHex(&out, &outMaxLen, addr, width, false);
-						break;
+						WriteChar(out, outMaxLen, '+');
+						WriteHex(out, outMaxLen, instr->operands[i].immediate, 2, true);
 					}
-					else if (*fmt == 'b')
+					else
 					{
-						size_t i;
-						for (i = 0; i < instr->length; i++)
-							WriteHex(&out, &outMaxLen, opcode[i], 2, false);
-						for (; i < width; i++)
-							WriteString(&out, &outMaxLen, "  ");
-						break;
+						if (plus)
+							WriteChar(out, outMaxLen, '+');
+						WriteHex(out, outMaxLen, instr->operands[i].immediate, 8, true);
 					}
-					else if (*fmt == 'i')
+				}
+				WriteChar(out, outMaxLen, ']');
+			}
+			else
+				WriteOperand(out, outMaxLen, instr->operands[i].operand, 1, false);
+		}
+	}
+
+
+	// The following functions write to a buffer that is known to be large enough, so they write
+	// whole strings at once without checking the remaining space
+
+	static char* FastWriteString(char* out, const char* str, size_t len)
+	{
+		memcpy(out, str, len);
+		return out + len;
+	}
+
+
+	static char* FastWriteHex(char* out, uint64_t val, uint32_t width, bool prefix)
+	{
+		if (prefix)
+		{
+			out[0] = '0';
+			out[1] = 'x';
+			out += 2;
+		}
+		return FormatHex(out, val, width);
+	}
+
+
+	static char* FastWriteOperand(char* out, OperandType type, uint8_t scale, bool plus)
+	{
+		if (plus)
+			*(out++) = '+';
+		out = FastWriteString(out, &operandStringData[operandStringOffset[type]], operandStringLength[type]);
+		if (scale != 1)
+		{
+			out[0] = '*';
+			out[1] = scale + '0';
+			out += 2;
+		}
+		return out;
+	}
+
+
+	static char* FastWriteBytes(char* out, const uint8_t* opcode, const Instruction* instr, uint32_t width)
+	{
+		size_t i;
+		for (i = 0; i < instr->length; i++, out += 2)
+			memcpy(out, &hexDigitPairs[opcode[i] * 2], 2);
+		for (; i < width; i++, out += 2)
+			memcpy(out, "  ", 2);
+		return out;
+	}
+
+
+	static char* FastWriteMnemonic(char* out, const Instruction* instr, uint32_t width)
+	{
+		char* operationStart = out;
+		if (instr->flags & X86_FLAG_ANY_REP)
+		{
+			if (instr->flags & X86_FLAG_REPNE)
+				out = FastWriteString(out, "repne ", 6);
+			else if (instr->flags & X86_FLAG_REPE)
+				out = FastWriteString(out, "repe ", 5);
+			else
+				out = FastWriteString(out, "rep ", 4);
+		}
+		if (instr->flags & X86_FLAG_LOCK)
+			out = FastWriteString(out, "lock ", 5);
+		out = FastWriteString(out, &operationStringData[operationStringOffset[instr->operation]],
+			operationStringLength[instr->operation]);
+		while ((size_t)(out - operationStart) < (size_t)width)
+			*(out++) = ' ';
+		return out;
+	}
+
+
+	static char* FastWriteOperands(char* out, const Instruction* instr)
+	{
+		for (uint32_t i = 0; i < 3; i++)
+		{
+			const InstructionOperand* oper = &instr->operands[i];
+			if (oper->operand == NONE)
+				break;
+			if (i != 0)
+				out = FastWriteString(out, ", ", 2);
+			if (oper->operand == IMM)
+				out = FastWriteHex(out, oper->immediate, oper->size * 2, true);
+			else if (oper->operand == MEM)
+			{
+				bool plus = false;
+				const char* sizeString = GetSizeString(oper->size);
+				out = FastWriteString(out, sizeString, strlen(sizeString));
+				if ((instr->segment != SEG_DEFAULT) || (oper->segment == SEG_ES))
+				{
+					out = FastWriteOperand(out, (OperandType)(oper->segment + REG_ES), 1, false);
+					*(out++) = ':';
+				}
+				*(out++) = '[';
+				if (oper->components[0] != NONE)
+				{
+					out = FastWriteOperand(out, oper->components[0], 1, false);
+					plus = true;
+				}
+				if (oper->components[1] != NONE)
+				{
+					out = FastWriteOperand(out, oper->components[1], oper->scale, plus);
+					plus = true;
+				}
+				if ((oper->immediate != 0) || ((oper->components[0] == NONE) && (oper->components[1] == NONE)))
+				{
+					if (plus && ((int64_t)oper->immediate >= -0x80) && ((int64_t)oper->immediate < 0))
 					{
-						char* operationStart = out;
-						if (instr->flags & X86_FLAG_ANY_REP)
-						{
-							WriteString(&out, &outMaxLen, "rep");
-							if (instr->flags & X86_FLAG_REPNE)
-								WriteChar(&out, &outMaxLen, 'n');
-							if (instr->flags & (X86_FLAG_REPNE | X86_FLAG_REPE))
-								WriteChar(&out, &outMaxLen, 'e');
-							WriteChar(&out, &outMaxLen, ' ');
-						}
-						if (instr->flags & X86_FLAG_LOCK)
-							WriteString(&out, &outMaxLen, "lock ");
-						WriteString(&out, &outMaxLen, operationString[instr->operation]);
-						for (; ((size_t)(out - operationStart) < (size_t)width) && (outMaxLen > 1); )
-							WriteChar(&out, &outMaxLen, ' ');
-						break;
+						*(out++) = '-';
+						out = FastWriteHex(out, -(int64_t)oper->immediate, 2, true);
 					}
-					else if (*fmt == 'o')
+					else if (plus && ((int64_t)oper->immediate > 0) && ((int64_t)oper->immediate <= 0x7f))
 					{
-						uint32_t i;
-						for (i = 0; i < 3; i++)
-						{
-							if (instr->operands[i].operand == NONE)
-								break;
-							if (i != 0)
-								WriteString(&out, &outMaxLen, ", ");
-							if (instr->operands[i].operand == IMM)
-								WriteHex(&out, &outMaxLen, instr->operands[i].immediate, instr->operands[i].size * 2, true);
-							else if (instr->operands[i].operand == MEM)
-							{
-								bool plus = false;
-								WriteString(&out, &outMaxLen, GetSizeString(instr->operands[i].size));
-								if ((instr->segment != SEG_DEFAULT) || (instr->operands[i].segment == SEG_ES))
-								{
-									WriteOperand(&out, &outMaxLen, (OperandType)(instr->operands[i].segment + REG_ES), 1, false);
-									WriteChar(&out, &outMaxLen, ':');
-								}
-								WriteChar(&out, &outMaxLen, '[');
-								if (instr->operands[i].components[0] != NONE)
-								{
-									WriteOperand(&out, &outMaxLen, instr->operands[i].components[0], 1, false);
-									plus = true;
-								}
-								if (instr->operands[i].components[1] != NONE)
-								{
-									WriteOperand(&out, &outMaxLen, instr->operands[i].components[1], instr->operands[i].scale, plus);
-									plus = true;
-								}
-								if ((instr->operands[i].immediate != 0) || ((instr->operands[i].components[0] == NONE) &&
-									(instr->operands[i].components[1] == NONE)))
-								{
-									if (plus && ((int64_t)instr->operands[i].immediate >= -0x80) &&
-										((int64_t)instr->operands[i].immediate < 0))
-									{
-										WriteChar(&out, &outMaxLen, '-');
-										WriteHex(&out, &outMaxLen, -(int64_t)instr->operands[i].immediate, 2, true);
-									}
-									else if (plus && ((int64_t)instr->operands[i].immediate > 0) &&
-										((int64_t)instr->operands[i].immediate <= 0x7f))
-									{
-										WriteChar(&out, &outMaxLen, '+');
-										WriteHex(&out, &outMaxLen, instr->operands[i].immediate, 2, true);
-									}
-									else
-									{
-										if (plus)
-											WriteChar(&out, &outMaxLen, '+');
-										WriteHex(&out, &outMaxLen, instr->operands[i].immediate, 8, true);
-									}
-								}
-								WriteChar(&out, &outMaxLen, ']');
-							}
-							else
-								WriteOperand(&out, &outMaxLen, instr->operands[i].operand, 1, false);
-						}
-						break;
+						*(out++) = '+';
+						out = FastWriteHex(out, oper->immediate, 2, true);
 					}
-					else if ((*fmt >= '0') && (*fmt <= '9'))
-						width = (width * 10) + (*fmt - '0');
 					else
 					{
-						WriteChar(&out, &outMaxLen, *fmt);
-						break;
+						if (plus)
+							*(out++) = '+';
+						out = FastWriteHex(out, oper->immediate, 8, true);
 					}
 				}
+				*(out++) = ']';
 			}
 			else
-				WriteChar(&out, &outMaxLen, *fmt);
+				out = FastWriteOperand(out, oper->operand, 1, false);
+		}
+		return out;
+	}
+
+
+	// Longest output of a format step for any instruction. Text steps are counted as their
+	// characters are added.
+	static size_t GetFormatStepMaxLength(uint8_t type, uint32_t width)
+	{
+		switch (type)
+		{
+		case FORMAT_STEP_ADDRESS:
+			return (width > 16) ? 16 : width;
+		case FORMAT_STEP_BYTES:
+			if (((size_t)width * 2) < width)
+				return SIZE_MAX;
+			return ((width > 15) ? (size_t)width : 15) * 2;
+		case FORMAT_STEP_MNEMONIC:
+			// "repne lock " followed by the mnemonic, padded to the width
+			return ((width > (11 + MAX_OPERATION_STRING_LENGTH)) ? width : (11 + MAX_OPERATION_STRING_LENGTH));
+		case FORMAT_STEP_OPERANDS:
+			return MAX_OPERANDS_STRING_LENGTH;
+		default:
+			return 0;
+		}
+	}
+
+
+	static bool AddFormatStep(InstructionFormat* format, uint8_t type, uint32_t arg)
+	{
+		size_t stepMaxLength = GetFormatStepMaxLength(type, arg);
+		if (format->stepCount >= X86_MAX_FORMAT_STEPS)
+			return false;
+		format->steps[format->stepCount].type = type;
+		format->steps[format->stepCount].length = 0;
+		format->steps[format->stepCount].arg = arg;
+		format->stepCount++;
+
+		// Saturate the length for very wide padding, as no buffer is large enough for it
+		if (format->maxLength > (SIZE_MAX - stepMaxLength))
+			format->maxLength = SIZE_MAX;
+		else
+			format->maxLength += stepMaxLength;
+		return true;
+	}
+
+
+	// Compiles as much of the format string as fits in the format, and returns the position of the
+	// first part of the format string that was not compiled
+	static const char* CompileFormat(InstructionFormat* format, const char* fmt)
+	{
+		format->stepCount = 0;
+		format->textLength = 0;
+		format->maxLength = 0;
+		while (*fmt)
+		{
+			const char* next = fmt;
+			uint32_t width = 0;
+			uint8_t type = FORMAT_STEP_TEXT;
+
+			if (*next == '%')
+			{
+				for (next++; (*next >= '0') && (*next <= '9'); next++)
+					width = (width * 10) + (*next - '0');
+				if (!*next)
+					return next;
+
+				if (*next == 'a')
+				{
+					type = FORMAT_STEP_ADDRESS;
+					if (width == 0)
+						width = sizeof(void*) * 2;
+				}
+				else if (*next == 'b')
+					type = FORMAT_STEP_BYTES;
+				else if (*next == 'i')
+					type = FORMAT_STEP_MNEMONIC;
+				else if (*next == 'o')
+					type = FORMAT_STEP_OPERANDS;
+			}
+
+			if (type == FORMAT_STEP_TEXT)
+			{
+				// Literal characters are collected into a single text step
+				if (format->textLength >= X86_MAX_FORMAT_TEXT)
+					return fmt;
+				if ((format->stepCount == 0) || (format->steps[format->stepCount - 1].type != FORMAT_STEP_TEXT))
+				{
+					if (!AddFormatStep(format, FORMAT_STEP_TEXT, format->textLength))
+						return fmt;
+				}
+				format->text[format->textLength++] = *next;
+				format->steps[format->stepCount - 1].length++;
+				format->maxLength++;
+			}
+			else if (!AddFormatStep(format, type, width))
+				return fmt;
+
+			fmt = next + 1;
+		}
+		return fmt;
+	}
+
+
+	static void RunFormat(char** out, size_t* outMaxLen, const InstructionFormat* format, const uint8_t* opcode,
+		uint64_t addr, const Instruction* instr)
+	{
+		if (*outMaxLen > format->maxLength)
+		{
+			// The output is known to fit, leaving room for the terminator
+			char* start = *out;
+			char* cur = start;
+			for (size_t i = 0; i < format->stepCount; i++)
+			{
+				const InstructionFormatStep* step = &format->steps[i];
+				switch (step->type)
+				{
+				case FORMAT_STEP_TEXT:
+					cur = FastWriteString(cur, &format->text[step->arg], step->length);
+					break;
+				case FORMAT_STEP_ADDRESS:
+					cur = FastWriteHex(cur, addr, step->arg, false);
+					break;
+				case FORMAT_STEP_BYTES:
+					cur = FastWriteBytes(cur, opcode, instr, step->arg);
+					break;
+				case FORMAT_STEP_MNEMONIC:
+					cur = FastWriteMnemonic(cur, instr, step->arg);
+					break;
+				case FORMAT_STEP_OPERANDS:
+					cur = FastWriteOperands(cur, instr);
+					break;
+				default:
+					break;
+				}
+			}
+			*out = cur;
+			*outMaxLen -= (size_t)(cur - start);
+			return;
+		}
+
+		for (size_t i = 0; i < format->stepCount; i++)
+		{
+			const InstructionFormatStep* step = &format->steps[i];
+			switch (step->type)
+			{
+			case FORMAT_STEP_TEXT:
+				for (size_t j = 0; j < step->length; j++)
+					WriteChar(out, outMaxLen, format->text[step->arg + j]);
+				break;
+			case FORMAT_STEP_ADDRESS:
+				WriteHex(out, outMaxLen, addr, step->arg, false);
+				break;
+			case FORMAT_STEP_BYTES:
+				WriteBytes(out, outMaxLen, opcode, instr, step->arg);
+				break;
+			case FORMAT_STEP_MNEMONIC:
+				WriteMnemonic(out, outMaxLen, instr, step->arg);
+				break;
+			case FORMAT_STEP_OPERANDS:
+				WriteOperands(out, outMaxLen, instr);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+
+	bool CompileInstructionFormat(InstructionFormat* format, const char* fmt)
+	{
+		return *CompileFormat(format, fmt) == 0;
+	}
+
+
+	size_t FormatInstructionStringCompiled(char* out, size_t outMaxLen, const InstructionFormat* format,
+		const uint8_t* opcode, uint64_t addr, const Instruction* instr)
+	{
+		char* start = out;
+		size_t len;
+		RunFormat(&out, &outMaxLen, format, opcode, addr, instr);
+		len = out - start;
+		if (outMaxLen > 0)
+			*(out++) = 0;
+		return len;
+	}
+
+
+	size_t FormatInstructionString(char* out, size_t outMaxLen, const char* fmt, const uint8_t* opcode,
+		uint64_t addr, const Instruction* instr)
+	{
+		InstructionFormat format;
+		char* start = out;
+		size_t len;
+
+		// Format strings that are too long for a single compiled format are run in pieces
+		while (*fmt)
+		{
+			fmt = CompileFormat(&format, fmt);
+			RunFormat(&out, &outMaxLen, &format, opcode, addr, instr);
 		}
+
 		len = out - start;
 		if (outMaxLen > 0)
 			*(out++) = 0;
@@ -2736,6 +4449,82 @@ namespace x86
 			return 0;
 		return FormatInstructionString(out, outMaxLen, fmt, opcode, addr, instr);
 	}
+
+
+	static size_t DisassembleRangeToText(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionFormat* format,
+		TextArena* arena, size_t* nextOffset, uint16_t addrSize, uint16_t opSize, bool using64,
+		DecodeInstructionFunction decode, DecodeInstructionFunction decodeNext)
+	{
+		Instruction instr;
+		DecodeState state;
+		size_t offset = 0;
+		size_t count = 0;
+
+		state.result = &instr;
+		state.using64 = using64;
+		while (offset < len)
+		{
+			size_t remaining = len - offset;
+			char* out;
+			size_t outMaxLen;
+
+			state.opcodeStart = &opcode[offset];
+			state.opcode = state.opcodeStart;
+			state.addr = addr + offset;
+			state.len = (remaining > 15) ? 15 : remaining;
+			state.addrSize = addrSize;
+			state.opSize = opSize;
+			if (!((count == 0) ? decode(&state) : decodeNext(&state)))
+				break;
+
+			// A line is only started when the longest possible output of the format and the newline fit,
+			// so lines are never split across buffers
+			if ((arena->size - arena->used) <= format->maxLength)
+			{
+				if ((!arena->flush) || (!arena->flush(arena)))
+					break;
+				if ((arena->size - arena->used) <= format->maxLength)
+					break;
+			}
+
+			out = &arena->buffer[arena->used];
+			outMaxLen = arena->size - arena->used;
+			RunFormat(&out, &outMaxLen, format, state.opcodeStart, state.addr, &instr);
+			*(out++) = '\n';
+			arena->used = out - arena->buffer;
+
+			offset += instr.length;
+			count++;
+		}
+
+		if (nextOffset)
+			*nextOffset = offset;
+		return count;
+	}
+
+
+	size_t DisassembleRangeToText16(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionFormat* format,
+		TextArena* arena, size_t* nextOffset)
+	{
+		return DisassembleRangeToText(opcode, addr, len, format, arena, nextOffset, 2, 2, false,
+			DECODER_16(DecodeInstruction), DECODER_16(DecodeNextInstruction));
+	}
+
+
+	size_t DisassembleRangeToText32(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionFormat* format,
+		TextArena* arena, size_t* nextOffset)
+	{
+		return DisassembleRangeToText(opcode, addr, len, format, arena, nextOffset, 4, 4, false,
+			DECODER_32(DecodeInstruction), DECODER_32(DecodeNextInstruction));
+	}
+
+
+	size_t DisassembleRangeToText64(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionFormat* format,
+		TextArena* arena, size_t* nextOffset)
+	{
+		return DisassembleRangeToText(opcode, addr, len, format, arena, nextOffset, 8, 4, true,
+			DECODER_64(DecodeInstruction), DECODER_64(DecodeNextInstruction));
+	}
 #ifdef __cplusplus
 }
 #endif
@@ -56,6 +56,59 @@
 
 #define X86_FLAG_ANY_REP	(X86_FLAG_REP | X86_FLAG_REPE | X86_FLAG_REPNE)
 
+// Attributes of an operation, from GetOperationAttributes
+#define X86_OP_BRANCH		0x0001	// Jump, conditional branch, or loop
+#define X86_OP_CONDITIONAL	0x0002	// Depends on the flags or a count register (Jcc, loop, cmovcc, setcc, fcmovcc)
+#define X86_OP_CALL			0x0004
+#define X86_OP_RETURN		0x0008	// Return from a call, interrupt, or system call
+#define X86_OP_INTERRUPT	0x0010	// Software interrupt or system call
+#define X86_OP_PRIVILEGED	0x0020	// Faults outside of ring 0, or when not permitted by the I/O privilege level
+#define X86_OP_STRING		0x0040	// String operation, which can take a rep prefix
+#define X86_OP_IO			0x0080	// Reads or writes an I/O port
+#define X86_OP_STACK		0x0100	// Implicitly pushes or pops the stack
+#define X86_OP_NO_FALLTHROUGH	0x0200	// Never continues with the next instruction
+#define X86_OP_FPU			0x0400	// x87 floating point operation
+
+// Bits of the EFLAGS register, in their positions in the register
+#define X86_EFLAGS_CF		0x0001
+#define X86_EFLAGS_PF		0x0004
+#define X86_EFLAGS_AF		0x0010
+#define X86_EFLAGS_ZF		0x0040
+#define X86_EFLAGS_SF		0x0080
+#define X86_EFLAGS_TF		0x0100
+#define X86_EFLAGS_IF		0x0200
+#define X86_EFLAGS_DF		0x0400
+#define X86_EFLAGS_OF		0x0800
+
+#define X86_EFLAGS_STATUS	(X86_EFLAGS_CF | X86_EFLAGS_PF | X86_EFLAGS_AF | X86_EFLAGS_ZF | X86_EFLAGS_SF | X86_EFLAGS_OF)
+
+// Access of an operand by the instruction. Memory operands describe the access to memory, and the
+// registers used to compute the address are always read.
+#define X86_ACCESS_NONE			0	// Not accessed, such as the address computed by lea
+#define X86_ACCESS_READ			1
+#define X86_ACCESS_WRITE		2
+#define X86_ACCESS_READ_WRITE	3
+
+// Parts of the encoding of an instruction that are present, for InstructionEncodingInfo
+#define X86_ENCODING_REX				0x01
+#define X86_ENCODING_MODRM				0x02
+#define X86_ENCODING_SIB				0x04
+#define X86_ENCODING_RIP_RELATIVE		0x08	// Displacement is relative to the next instruction
+#define X86_ENCODING_RELATIVE_BRANCH	0x10	// Immediate is a branch offset from the next instruction
+
+// Number of 64-bit words in an X86OperationFilter, with room for one bit per InstructionOperation
+#define X86_OPERATION_FILTER_WORDS	16
+
+// Size of the pages invalidated by InvalidateDecodeCachePage
+#define X86_DECODE_CACHE_PAGE_SIZE	0x1000
+
+// Opcode maps, selected by the escape bytes before the final opcode byte
+#define X86_OPCODE_MAP_PRIMARY	0
+#define X86_OPCODE_MAP_0F		1
+#define X86_OPCODE_MAP_0F38		2
+#define X86_OPCODE_MAP_0F3A		3
+#define X86_OPCODE_MAP_3DNOW	4	// 0f 0f, with the final opcode byte after the operands
+
 
 #ifdef __cplusplus
 namespace asmx86
@@ -213,6 +266,7 @@ namespace asmx86
 		int64_t immediate;
 		SegmentRegister segment;
 		bool relative;
+		uint8_t access;
 	};
 #ifndef __cplusplus
 	typedef struct InstructionOperand InstructionOperand;
@@ -232,6 +286,297 @@ namespace asmx86
 #endif
 
 
+	// Location of each part of an instruction within its bytes, as offsets from the first byte.
+	// Parts that are not present have an offset and size of zero.
+	struct InstructionEncodingInfo
+	{
+		uint8_t flags;
+		uint8_t opcodeMap;
+		uint8_t rex;
+		uint8_t opcode;
+		uint8_t prefixLength;
+		uint8_t opcodeOffset;
+		uint8_t modRMOffset;
+		uint8_t sibOffset;
+		uint8_t displacementOffset;
+		uint8_t displacementSize;
+		uint8_t immediateOffset;
+		uint8_t immediateSize;
+	};
+#ifndef __cplusplus
+	typedef struct InstructionEncodingInfo InstructionEncodingInfo;
+#endif
+
+
+	// Set of operations for DecodeRangeVisit, with one bit for each InstructionOperation
+	struct X86OperationFilter
+	{
+		uint64_t bits[X86_OPERATION_FILTER_WORDS];
+	};
+#ifndef __cplusplus
+	typedef struct X86OperationFilter X86OperationFilter;
+#endif
+
+	// Called by DecodeRangeVisit for each instruction with an operation in the filter, with the offset
+	// of the instruction from the start of the range. Returns false to stop decoding.
+	typedef bool (*X86InstructionVisitor)(void* context, const Instruction* instr, size_t offset);
+
+
+	// Cache of decoded instructions keyed by address, for callers such as emulators that decode the same
+	// instructions many times. The cache is direct mapped over caller provided entries. The members are
+	// managed by the decode cache functions, except for the hit and miss counters, which may be reset.
+	struct X86DecodeCacheEntry
+	{
+		uint64_t addr;
+		Instruction instr;
+	};
+#ifndef __cplusplus
+	typedef struct X86DecodeCacheEntry X86DecodeCacheEntry;
+#endif
+
+	struct X86DecodeCache
+	{
+		X86DecodeCacheEntry* entries;
+		size_t entryCount;
+		uint8_t mode;
+		uint64_t hits;
+		uint64_t misses;
+	};
+#ifndef __cplusplus
+	typedef struct X86DecodeCache X86DecodeCache;
+#endif
+
+
+	// Decoder context for decoding a stream of instructions one at a time. The members are
+	// managed by the InitDecoder and DecodeNext functions and should not be modified directly.
+	struct X86Decoder
+	{
+		const uint8_t* opcode;
+		uint64_t addr;
+		size_t len;
+		Instruction* lastResult;
+		uint8_t mode;
+	};
+#ifndef __cplusplus
+	typedef struct X86Decoder X86Decoder;
+#endif
+
+#define X86_MAX_INSTRUCTION_LENGTH	15
+
+	// Decoder context for decoding a stream that arrives in chunks. Instructions that are split
+	// across chunks are reassembled in pending. The members are managed by the InitStreamDecoder,
+	// SetStreamInput, DecodeStream, and SkipStreamBytes functions and should not be modified directly.
+	struct X86StreamDecoder
+	{
+		const uint8_t* input;
+		size_t inputLen;
+		uint64_t addr;
+		uint8_t pending[X86_MAX_INSTRUCTION_LENGTH - 1];
+		uint8_t pendingLen;
+		uint8_t mode;
+	};
+#ifndef __cplusplus
+	typedef struct X86StreamDecoder X86StreamDecoder;
+#endif
+
+
+#define X86_SWEEP_SYNC_WINDOW	256
+
+	// Per-chunk state for ParallelSweep. The members are managed by ParallelSweep and should not be
+	// modified directly.
+	struct X86SweepChunk
+	{
+		size_t base;
+		size_t end;
+		size_t start;
+		size_t count;
+		size_t firstResult;
+		size_t nextOffset;
+		uint64_t head[X86_SWEEP_SYNC_WINDOW / 64];
+		uint64_t tail[X86_SWEEP_SYNC_WINDOW / 64];
+	};
+#ifndef __cplusplus
+	typedef struct X86SweepChunk X86SweepChunk;
+#endif
+
+	// Runs func(arg, i) for every i from 0 to count - 1, possibly in parallel, and returns when all
+	// of them have completed
+	typedef void (*X86TaskFunction)(void* arg, size_t index);
+	typedef void (*X86TaskRunner)(void* context, X86TaskFunction func, void* arg, size_t count);
+
+
+#define X86_BLOCK_BRANCH		1
+#define X86_BLOCK_INDIRECT		2
+#define X86_BLOCK_RETURN		4
+#define X86_BLOCK_INVALID		8
+#define X86_BLOCK_EXTERNAL		0x10
+
+	// Basic block of a control flow graph built by BuildControlFlowGraph. The successors of the block
+	// are the block indices successors[firstSuccessor] to successors[firstSuccessor + successorCount - 1].
+	struct X86BasicBlock
+	{
+		uint64_t addr;
+		uint32_t length;
+		uint32_t instructionCount;
+		uint32_t firstSuccessor;
+		uint8_t successorCount;
+		uint8_t flags;
+	};
+#ifndef __cplusplus
+	typedef struct X86BasicBlock X86BasicBlock;
+#endif
+
+	struct X86ControlFlowGraph
+	{
+		X86BasicBlock* blocks;
+		size_t blockCount;
+		uint32_t* successors;
+		size_t successorCount;
+	};
+#ifndef __cplusplus
+	typedef struct X86ControlFlowGraph X86ControlFlowGraph;
+#endif
+
+
+	// Compact 16 byte form of an Instruction for keeping large numbers of decoded instructions in
+	// memory. Immediates and displacements are stored in a separate table of int64_t values, starting
+	// at the index given by the values member. Use UnpackInstruction to recover the full Instruction.
+	struct PackedInstruction
+	{
+		uint16_t operation;
+		uint8_t length; // Length in bits 0-3, segment in bits 4-6, insufficient length flag in bit 7
+		uint8_t flags;
+		uint8_t operands[3];
+		uint8_t components[2];
+		uint8_t memory;
+		uint16_t sizes;
+		uint32_t values;
+	};
+#ifndef __cplusplus
+	typedef struct PackedInstruction PackedInstruction;
+#endif
+
+#define PACKED_INSTRUCTION_LENGTH(instr)	((instr)->length & 0xf)
+
+
+	// Output arrays for decoding a block of instructions into columns. Only the columns selected
+	// by the X86_COLUMN_* mask passed to DisassembleColumns need to be provided.
+	struct InstructionColumns
+	{
+		uint16_t* operation;
+		uint8_t* length;
+		uint32_t* flags;
+		uint8_t* operands; // Three operand types per instruction
+		uint8_t* base;
+		uint8_t* index;
+		int64_t* displacement;
+		int64_t* immediate;
+		uint64_t* regsRead;
+		uint64_t* regsWritten;
+	};
+#ifndef __cplusplus
+	typedef struct InstructionColumns InstructionColumns;
+#endif
+
+#define X86_COLUMN_OPERATION	1
+#define X86_COLUMN_LENGTH		2
+#define X86_COLUMN_FLAGS		4
+#define X86_COLUMN_OPERANDS		8
+#define X86_COLUMN_BASE			0x10
+#define X86_COLUMN_INDEX		0x20
+#define X86_COLUMN_DISPLACEMENT	0x40
+#define X86_COLUMN_IMMEDIATE	0x80
+#define X86_COLUMN_REGS_READ	0x100
+#define X86_COLUMN_REGS_WRITTEN	0x200
+
+
+// Bits of the register masks from GetRegisterMasks. Sub-registers share the bit of the full register,
+// so AL, AH, AX, EAX, and RAX are all X86_REG_MASK_GPR(0). General purpose registers are numbered
+// in encoding order, and segment registers in SegmentRegister order.
+#define X86_REG_MASK_GPR(n)		((uint64_t)1 << (n))
+#define X86_REG_MASK_XMM(n)		((uint64_t)1 << (16 + (n)))
+#define X86_REG_MASK_MM(n)		((uint64_t)1 << (32 + (n)))
+#define X86_REG_MASK_ST(n)		((uint64_t)1 << (40 + (n)))
+#define X86_REG_MASK_SEG(n)		((uint64_t)1 << (48 + (n)))
+#define X86_REG_MASK_RIP		((uint64_t)1 << 54)
+#define X86_REG_MASK_FLAGS		((uint64_t)1 << 55)
+#define X86_REG_MASK_CR			((uint64_t)1 << 56) // Any control register
+#define X86_REG_MASK_DR			((uint64_t)1 << 57) // Any debug register
+#define X86_REG_MASK_TR			((uint64_t)1 << 58) // Any test register
+
+#define X86_REG_MASK_RAX		X86_REG_MASK_GPR(0)
+#define X86_REG_MASK_RCX		X86_REG_MASK_GPR(1)
+#define X86_REG_MASK_RDX		X86_REG_MASK_GPR(2)
+#define X86_REG_MASK_RBX		X86_REG_MASK_GPR(3)
+#define X86_REG_MASK_RSP		X86_REG_MASK_GPR(4)
+#define X86_REG_MASK_RBP		X86_REG_MASK_GPR(5)
+#define X86_REG_MASK_RSI		X86_REG_MASK_GPR(6)
+#define X86_REG_MASK_RDI		X86_REG_MASK_GPR(7)
+
+	// Flags read by an operation, set to a defined value, and left undefined. A flag is in at most
+	// one of written and undefined.
+	struct X86FlagMasks
+	{
+		uint16_t read;
+		uint16_t written;
+		uint16_t undefined;
+	};
+#ifndef __cplusplus
+	typedef struct X86FlagMasks X86FlagMasks;
+#endif
+
+	// Registers read and written by an instruction, including implicit operands
+	struct X86RegisterMasks
+	{
+		uint64_t read;
+		uint64_t written;
+	};
+#ifndef __cplusplus
+	typedef struct X86RegisterMasks X86RegisterMasks;
+#endif
+
+
+#define X86_MAX_FORMAT_STEPS	16
+#define X86_MAX_FORMAT_TEXT		64
+
+	struct InstructionFormatStep
+	{
+		uint8_t type;
+		uint8_t length;
+		uint32_t arg;
+	};
+#ifndef __cplusplus
+	typedef struct InstructionFormatStep InstructionFormatStep;
+#endif
+
+	// Format string for FormatInstructionStringCompiled, prepared by CompileInstructionFormat
+	struct InstructionFormat
+	{
+		uint8_t stepCount;
+		uint8_t textLength;
+		size_t maxLength;
+		InstructionFormatStep steps[X86_MAX_FORMAT_STEPS];
+		char text[X86_MAX_FORMAT_TEXT];
+	};
+#ifndef __cplusplus
+	typedef struct InstructionFormat InstructionFormat;
+#endif
+
+	// Output buffer for DisassembleRangeToText. When the buffer does not have room for another line,
+	// flush is called to write out or replace the buffer.
+	struct TextArena
+	{
+		char* buffer;
+		size_t size;
+		size_t used;
+		bool (*flush)(struct TextArena* arena);
+		void* context;
+	};
+#ifndef __cplusplus
+	typedef struct TextArena TextArena;
+#endif
+
+
 #ifdef __cplusplus
 	extern "C"
 	{
@@ -240,8 +585,109 @@ namespace asmx86
 		bool Disassemble32(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result);
 		bool Disassemble64(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result);
 
+		bool DisassembleWithEncoding16(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result,
+			InstructionEncodingInfo* encoding);
+		bool DisassembleWithEncoding32(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result,
+			InstructionEncodingInfo* encoding);
+		bool DisassembleWithEncoding64(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result,
+			InstructionEncodingInfo* encoding);
+
+		size_t DisassembleBlock16(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+			size_t maxCount, size_t* nextOffset);
+		size_t DisassembleBlock32(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+			size_t maxCount, size_t* nextOffset);
+		size_t DisassembleBlock64(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+			size_t maxCount, size_t* nextOffset);
+
+		size_t InstructionLength16(const uint8_t* opcode, size_t maxLen);
+		size_t InstructionLength32(const uint8_t* opcode, size_t maxLen);
+		size_t InstructionLength64(const uint8_t* opcode, size_t maxLen);
+
+		size_t InstructionLengthBlock16(const uint8_t* opcode, size_t len, uint8_t* lengths, size_t maxCount,
+			size_t* nextOffset);
+		size_t InstructionLengthBlock32(const uint8_t* opcode, size_t len, uint8_t* lengths, size_t maxCount,
+			size_t* nextOffset);
+		size_t InstructionLengthBlock64(const uint8_t* opcode, size_t len, uint8_t* lengths, size_t maxCount,
+			size_t* nextOffset);
+
+		size_t DecodeRangeVisit16(const uint8_t* opcode, uint64_t addr, size_t len, const X86OperationFilter* filter,
+			X86InstructionVisitor visitor, void* context, size_t* nextOffset);
+		size_t DecodeRangeVisit32(const uint8_t* opcode, uint64_t addr, size_t len, const X86OperationFilter* filter,
+			X86InstructionVisitor visitor, void* context, size_t* nextOffset);
+		size_t DecodeRangeVisit64(const uint8_t* opcode, uint64_t addr, size_t len, const X86OperationFilter* filter,
+			X86InstructionVisitor visitor, void* context, size_t* nextOffset);
+
+		size_t ParallelSweep16(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results, size_t maxCount,
+			X86SweepChunk* chunks, size_t chunkCount, X86TaskRunner runner, void* runnerContext, size_t* nextOffset);
+		size_t ParallelSweep32(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results, size_t maxCount,
+			X86SweepChunk* chunks, size_t chunkCount, X86TaskRunner runner, void* runnerContext, size_t* nextOffset);
+		size_t ParallelSweep64(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results, size_t maxCount,
+			X86SweepChunk* chunks, size_t chunkCount, X86TaskRunner runner, void* runnerContext, size_t* nextOffset);
+
+		bool BuildControlFlowGraph16(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+			size_t entryCount, void* memory, size_t memorySize, X86ControlFlowGraph* cfg);
+		bool BuildControlFlowGraph32(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+			size_t entryCount, void* memory, size_t memorySize, X86ControlFlowGraph* cfg);
+		bool BuildControlFlowGraph64(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+			size_t entryCount, void* memory, size_t memorySize, X86ControlFlowGraph* cfg);
+		bool BuildControlFlowGraphParallel16(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+			size_t entryCount, void* memory, size_t memorySize, X86TaskRunner runner, void* runnerContext,
+			size_t taskCount, X86ControlFlowGraph* cfg);
+		bool BuildControlFlowGraphParallel32(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+			size_t entryCount, void* memory, size_t memorySize, X86TaskRunner runner, void* runnerContext,
+			size_t taskCount, X86ControlFlowGraph* cfg);
+		bool BuildControlFlowGraphParallel64(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+			size_t entryCount, void* memory, size_t memorySize, X86TaskRunner runner, void* runnerContext,
+			size_t taskCount, X86ControlFlowGraph* cfg);
+
+		void InitDecoder16(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len);
+		void InitDecoder32(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len);
+		void InitDecoder64(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len);
+		void SetDecoderPosition(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len);
+		bool DecodeNext(X86Decoder* decoder, Instruction* result);
+
+		void InitStreamDecoder16(X86StreamDecoder* decoder, uint64_t addr);
+		void InitStreamDecoder32(X86StreamDecoder* decoder, uint64_t addr);
+		void InitStreamDecoder64(X86StreamDecoder* decoder, uint64_t addr);
+		void SetStreamInput(X86StreamDecoder* decoder, const uint8_t* chunk, size_t len);
+		size_t DecodeStream(X86StreamDecoder* decoder, Instruction* results, uint64_t* addrs, size_t maxCount,
+			bool* invalid);
+		void SkipStreamBytes(X86StreamDecoder* decoder, size_t count);
+
+		void InitDecodeCache(X86DecodeCache* cache, X86DecodeCacheEntry* entries, size_t entryCount);
+		void ClearDecodeCache(X86DecodeCache* cache);
+		void InvalidateDecodeCacheRange(X86DecodeCache* cache, uint64_t addr, size_t len);
+		void InvalidateDecodeCachePage(X86DecodeCache* cache, uint64_t addr);
+		bool CachedDisassemble16(X86DecodeCache* cache, const uint8_t* opcode, uint64_t addr, size_t maxLen,
+			Instruction* result);
+		bool CachedDisassemble32(X86DecodeCache* cache, const uint8_t* opcode, uint64_t addr, size_t maxLen,
+			Instruction* result);
+		bool CachedDisassemble64(X86DecodeCache* cache, const uint8_t* opcode, uint64_t addr, size_t maxLen,
+			Instruction* result);
+
+		bool PackInstruction(const Instruction* instr, PackedInstruction* packed, int64_t* values, size_t maxValues,
+			size_t* valueCount);
+		void UnpackInstruction(const PackedInstruction* packed, const int64_t* values, Instruction* result);
+
+		size_t DisassemblePackedBlock16(const uint8_t* opcode, uint64_t addr, size_t len, PackedInstruction* results,
+			size_t maxCount, int64_t* values, size_t maxValues, size_t* valueCount, size_t* nextOffset);
+		size_t DisassemblePackedBlock32(const uint8_t* opcode, uint64_t addr, size_t len, PackedInstruction* results,
+			size_t maxCount, int64_t* values, size_t maxValues, size_t* valueCount, size_t* nextOffset);
+		size_t DisassemblePackedBlock64(const uint8_t* opcode, uint64_t addr, size_t len, PackedInstruction* results,
+			size_t maxCount, int64_t* values, size_t maxValues, size_t* valueCount, size_t* nextOffset);
+
+		size_t DisassembleColumns16(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionColumns* columns,
+			uint32_t columnMask, size_t maxCount, size_t* nextOffset);
+		size_t DisassembleColumns32(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionColumns* columns,
+			uint32_t columnMask, size_t maxCount, size_t* nextOffset);
+		size_t DisassembleColumns64(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionColumns* columns,
+			uint32_t columnMask, size_t maxCount, size_t* nextOffset);
+
 		size_t FormatInstructionString(char* out, size_t outMaxLen, const char* fmt, const uint8_t* opcode,
 			uint64_t addr, const Instruction* instr);
+		bool CompileInstructionFormat(InstructionFormat* format, const char* fmt);
+		size_t FormatInstructionStringCompiled(char* out, size_t outMaxLen, const InstructionFormat* format,
+			const uint8_t* opcode, uint64_t addr, const Instruction* instr);
 
 		size_t DisassembleToString16(char* out, size_t outMaxLen, const char* fmt, const uint8_t* opcode,
 			uint64_t addr, size_t maxLen, Instruction* instr);
@@ -249,8 +695,103 @@ namespace asmx86
 			uint64_t addr, size_t maxLen, Instruction* instr);
 		size_t DisassembleToString64(char* out, size_t outMaxLen, const char* fmt, const uint8_t* opcode,
 			uint64_t addr, size_t maxLen, Instruction* instr);
+
+		size_t DisassembleRangeToText16(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionFormat* format,
+			TextArena* arena, size_t* nextOffset);
+		size_t DisassembleRangeToText32(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionFormat* format,
+			TextArena* arena, size_t* nextOffset);
+		size_t DisassembleRangeToText64(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionFormat* format,
+			TextArena* arena, size_t* nextOffset);
+
+		uint64_t GetRegisterMask(OperandType reg);
+		void GetRegisterMasks(const Instruction* instr, X86RegisterMasks* masks);
+
+		void GetInstructionFlags(const Instruction* instr, X86FlagMasks* flags);
+
+		extern const uint16_t X86OperationAttributes[];
+		extern const X86FlagMasks X86OperationFlags[];
 #ifdef __cplusplus
 	}
+#endif
+
+	// Classification of operations with a single table lookup. Note that MOVSD and CMPSD are also
+	// SSE operations, which only have one memory operand when decoded.
+	static __inline uint16_t GetOperationAttributes(InstructionOperation operation)
+	{
+		return X86OperationAttributes[operation];
+	}
+
+	static __inline bool IsBranchOperation(InstructionOperation operation)
+	{
+		return (X86OperationAttributes[operation] & X86_OP_BRANCH) != 0;
+	}
+
+	static __inline bool IsConditionalOperation(InstructionOperation operation)
+	{
+		return (X86OperationAttributes[operation] & X86_OP_CONDITIONAL) != 0;
+	}
+
+	static __inline bool IsCallOperation(InstructionOperation operation)
+	{
+		return (X86OperationAttributes[operation] & X86_OP_CALL) != 0;
+	}
+
+	static __inline bool IsReturnOperation(InstructionOperation operation)
+	{
+		return (X86OperationAttributes[operation] & X86_OP_RETURN) != 0;
+	}
+
+	static __inline bool IsPrivilegedOperation(InstructionOperation operation)
+	{
+		return (X86OperationAttributes[operation] & X86_OP_PRIVILEGED) != 0;
+	}
+
+	static __inline bool IsStringOperation(InstructionOperation operation)
+	{
+		return (X86OperationAttributes[operation] & X86_OP_STRING) != 0;
+	}
+
+	static __inline const X86FlagMasks* GetOperationFlags(InstructionOperation operation)
+	{
+		return &X86OperationFlags[operation];
+	}
+
+	static __inline void ClearOperationFilter(X86OperationFilter* filter)
+	{
+		for (size_t i = 0; i < X86_OPERATION_FILTER_WORDS; i++)
+			filter->bits[i] = 0;
+	}
+
+	static __inline void AddOperationToFilter(X86OperationFilter* filter, InstructionOperation operation)
+	{
+		filter->bits[operation >> 6] |= (uint64_t)1 << (operation & 63);
+	}
+
+	static __inline bool IsOperationInFilter(const X86OperationFilter* filter, InstructionOperation operation)
+	{
+		return ((filter->bits[operation >> 6] >> (operation & 63)) & 1) != 0;
+	}
+
+	static __inline bool ReadsMemory(const Instruction* instr)
+	{
+		for (size_t i = 0; i < 3; i++)
+		{
+			if ((instr->operands[i].operand == MEM) && (instr->operands[i].access & X86_ACCESS_READ))
+				return true;
+		}
+		return false;
+	}
+
+	static __inline bool WritesMemory(const Instruction* instr)
+	{
+		for (size_t i = 0; i < 3; i++)
+		{
+			if ((instr->operands[i].operand == MEM) && (instr->operands[i].access & X86_ACCESS_WRITE))
+				return true;
+		}
+		return false;
+	}
+#ifdef __cplusplus
 }
 #endif
 
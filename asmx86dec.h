@@ -0,0 +1,2108 @@
+// Copyright (c) 2006-2015, Rusty Wagner
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+// the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+//      following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+//      the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Decoder core. This file is included by asmx86.c once for each variant of the decoder that is
+// built. Define __ASMX86DEC_16BIT, __ASMX86DEC_32BIT or __ASMX86DEC_64BIT before including it to
+// emit a copy of the decoder specialized for that processor mode, with the mode checks folded
+// away at compile time. With none of them defined, the runtime decoder is emitted, which reads the
+// mode from the DecodeState structure.
+//
+// Each variant is included twice, the second time with __ASMX86DEC_UNCHECKED defined. This emits a
+// copy of the code after the prefixes that does not check for the end of the buffer on every read.
+// The checked copy hands over to it once the prefixes are processed if the longest possible
+// instruction body is known to fit in the remaining bytes.
+
+// Name generators and mode predicates
+#ifdef __DEC
+#undef __DEC
+#undef __CHECKED
+#undef __UNCHECKED
+#undef __USING64
+#undef __ADDR16
+#undef __ADDR64
+#endif
+#if defined(__ASMX86DEC_16BIT)
+#define __CHECKED(n) Mode16 ## n
+#define __UNCHECKED(n) Mode16Unchecked ## n
+#define __USING64(state) false
+#define __ADDR16(state) ((state)->addrSize == 2)
+#define __ADDR64(state) false
+#elif defined(__ASMX86DEC_32BIT)
+#define __CHECKED(n) Mode32 ## n
+#define __UNCHECKED(n) Mode32Unchecked ## n
+#define __USING64(state) false
+#define __ADDR16(state) ((state)->addrSize == 2)
+#define __ADDR64(state) false
+#elif defined(__ASMX86DEC_64BIT)
+#define __CHECKED(n) Mode64 ## n
+#define __UNCHECKED(n) Mode64Unchecked ## n
+#define __USING64(state) true
+#define __ADDR16(state) false
+#define __ADDR64(state) ((state)->addrSize == 8)
+#else
+#define __CHECKED(n) n
+#define __UNCHECKED(n) Unchecked ## n
+#define __USING64(state) ((state)->using64)
+#define __ADDR16(state) ((state)->addrSize == 2)
+#define __ADDR64(state) ((state)->addrSize == 8)
+#endif
+#ifdef __ASMX86DEC_UNCHECKED
+#define __DEC(n) __UNCHECKED(n)
+#else
+#define __DEC(n) __CHECKED(n)
+#endif
+
+// When the opcode tables hold decoder function pointers, they refer to the checked runtime decoder,
+// so the unchecked copy always dispatches on the decoder kind
+#ifdef __KIND_DISPATCH
+#undef __KIND_DISPATCH
+#endif
+#if defined(DECODER_KIND_DISPATCH) || defined(__ASMX86DEC_UNCHECKED)
+#define __KIND_DISPATCH
+#endif
+
+#define GetByteRegList __DEC(GetByteRegList)
+#define GetRegListForOpSize __DEC(GetRegListForOpSize)
+#define GetRegListForFinalOpSize __DEC(GetRegListForFinalOpSize)
+#define GetRegListForAddrSize __DEC(GetRegListForAddrSize)
+#define GetFinalOpSize __DEC(GetFinalOpSize)
+#define Read8 __DEC(Read8)
+#define Peek8 __DEC(Peek8)
+#define ReadModRM __DEC(ReadModRM)
+#define Read16 __DEC(Read16)
+#define Read32 __DEC(Read32)
+#define Read64 __DEC(Read64)
+#define ReadSigned8 __DEC(ReadSigned8)
+#define ReadSigned16 __DEC(ReadSigned16)
+#define ReadSigned32 __DEC(ReadSigned32)
+#define ReadFinalOpSize __DEC(ReadFinalOpSize)
+#define ReadAddrSize __DEC(ReadAddrSize)
+#define ReadSignedFinalOpSize __DEC(ReadSignedFinalOpSize)
+#define UpdateOperationForAddrSize __DEC(UpdateOperationForAddrSize)
+#define ProcessEncoding __DEC(ProcessEncoding)
+#define ProcessOpcode __DEC(ProcessOpcode)
+#define GetFinalSegment __DEC(GetFinalSegment)
+#define SetMemOperand __DEC(SetMemOperand)
+#define DecodeRM __DEC(DecodeRM)
+#define DecodeRMReg __DEC(DecodeRMReg)
+#define SetOperandToEsEdi __DEC(SetOperandToEsEdi)
+#define SetOperandToDsEsi __DEC(SetOperandToDsEsi)
+#define SetOperandToImmAddr __DEC(SetOperandToImmAddr)
+#define SetOperandToEaxFinalOpSize __DEC(SetOperandToEaxFinalOpSize)
+#define SetOperandToOpReg __DEC(SetOperandToOpReg)
+#define SetOperandToImm __DEC(SetOperandToImm)
+#define SetOperandToImm8 __DEC(SetOperandToImm8)
+#define SetOperandToImm16 __DEC(SetOperandToImm16)
+#define DecodeSSEPrefix __DEC(DecodeSSEPrefix)
+#define GetSizeForSSEType __DEC(GetSizeForSSEType)
+#define GetOperandForSSEEntryType __DEC(GetOperandForSSEEntryType)
+#define GetRegListForSSEEntryType __DEC(GetRegListForSSEEntryType)
+#define GetSizeForSSEEntryType __DEC(GetSizeForSSEEntryType)
+#define UpdateOperationForSSEEntryType __DEC(UpdateOperationForSSEEntryType)
+#define InvalidDecode __DEC(InvalidDecode)
+#define DecodeTwoByte __DEC(DecodeTwoByte)
+#define DecodeFpu __DEC(DecodeFpu)
+#define DecodeNoOperands __DEC(DecodeNoOperands)
+#define DecodeRegRM __DEC(DecodeRegRM)
+#define DecodeRegRMImm __DEC(DecodeRegRMImm)
+#define DecodeRMRegImm8 __DEC(DecodeRMRegImm8)
+#define DecodeRMRegCL __DEC(DecodeRMRegCL)
+#define DecodeEaxImm __DEC(DecodeEaxImm)
+#define DecodePushPopSeg __DEC(DecodePushPopSeg)
+#define DecodeOpReg __DEC(DecodeOpReg)
+#define DecodeEaxOpReg __DEC(DecodeEaxOpReg)
+#define DecodeOpRegImm __DEC(DecodeOpRegImm)
+#define DecodeNop __DEC(DecodeNop)
+#define DecodeImm __DEC(DecodeImm)
+#define DecodeImm16Imm8 __DEC(DecodeImm16Imm8)
+#define DecodeEdiDx __DEC(DecodeEdiDx)
+#define DecodeDxEsi __DEC(DecodeDxEsi)
+#define DecodeRelImm __DEC(DecodeRelImm)
+#define DecodeRelImmAddrSize __DEC(DecodeRelImmAddrSize)
+#define DecodeGroupRM __DEC(DecodeGroupRM)
+#define DecodeGroupRMImm __DEC(DecodeGroupRMImm)
+#define DecodeGroupRMImm8V __DEC(DecodeGroupRMImm8V)
+#define DecodeGroupRMOne __DEC(DecodeGroupRMOne)
+#define DecodeGroupRMCl __DEC(DecodeGroupRMCl)
+#define DecodeGroupF6F7 __DEC(DecodeGroupF6F7)
+#define DecodeGroupFF __DEC(DecodeGroupFF)
+#define DecodeGroup0F00 __DEC(DecodeGroup0F00)
+#define DecodeGroup0F01 __DEC(DecodeGroup0F01)
+#define DecodeGroup0FAE __DEC(DecodeGroup0FAE)
+#define Decode0FB8 __DEC(Decode0FB8)
+#define DecodeRMSRegV __DEC(DecodeRMSRegV)
+#define DecodeRM8 __DEC(DecodeRM8)
+#define DecodeRMV __DEC(DecodeRMV)
+#define DecodeFarImm __DEC(DecodeFarImm)
+#define DecodeEaxAddr __DEC(DecodeEaxAddr)
+#define DecodeEdiEsi __DEC(DecodeEdiEsi)
+#define DecodeEdiEax __DEC(DecodeEdiEax)
+#define DecodeEaxEsi __DEC(DecodeEaxEsi)
+#define DecodeAlEbxAl __DEC(DecodeAlEbxAl)
+#define DecodeEaxImm8 __DEC(DecodeEaxImm8)
+#define DecodeEaxDx __DEC(DecodeEaxDx)
+#define Decode3DNow __DEC(Decode3DNow)
+#define DecodeSSETable __DEC(DecodeSSETable)
+#define DecodeSSETableImm8 __DEC(DecodeSSETableImm8)
+#define DecodeSSETableMem8 __DEC(DecodeSSETableMem8)
+#define DecodeSSE __DEC(DecodeSSE)
+#define DecodeSSESingle __DEC(DecodeSSESingle)
+#define DecodeSSEPacked __DEC(DecodeSSEPacked)
+#define DecodeMMX __DEC(DecodeMMX)
+#define DecodeMMXSSEOnly __DEC(DecodeMMXSSEOnly)
+#define DecodeMMXGroup __DEC(DecodeMMXGroup)
+#define DecodePinsrw __DEC(DecodePinsrw)
+#define DecodeRegCR __DEC(DecodeRegCR)
+#define DecodeMovSXZX8 __DEC(DecodeMovSXZX8)
+#define DecodeMovSXZX16 __DEC(DecodeMovSXZX16)
+#define DecodeMem16 __DEC(DecodeMem16)
+#define DecodeMem32 __DEC(DecodeMem32)
+#define DecodeMem64 __DEC(DecodeMem64)
+#define DecodeMem80 __DEC(DecodeMem80)
+#define DecodeMemFloatEnv __DEC(DecodeMemFloatEnv)
+#define DecodeMemFloatSave __DEC(DecodeMemFloatSave)
+#define DecodeFPUReg __DEC(DecodeFPUReg)
+#define DecodeFPURegST0 __DEC(DecodeFPURegST0)
+#define DecodeRegGroupNoOperands __DEC(DecodeRegGroupNoOperands)
+#define DecodeRegGroupAX __DEC(DecodeRegGroupAX)
+#define DecodeCmpXch8B __DEC(DecodeCmpXch8B)
+#define DecodeMovNti __DEC(DecodeMovNti)
+#define DecodeCrc32 __DEC(DecodeCrc32)
+#define DecodeArpl __DEC(DecodeArpl)
+#define ProcessPrefixes __DEC(ProcessPrefixes)
+#define ClearOperand __DEC(ClearOperand)
+#define InitDecodeState __DEC(InitDecodeState)
+#define InitDisassemble __DEC(InitDisassemble)
+#define FinishDisassemble __DEC(FinishDisassemble)
+#define DispatchDecoder __DEC(DispatchDecoder)
+#define ProcessInstruction __DEC(ProcessInstruction)
+#define ProcessInstructionBody __DEC(ProcessInstructionBody)
+#define DecodeInstruction __DEC(DecodeInstruction)
+#define DecodeNextInstruction __DEC(DecodeNextInstruction)
+
+#ifdef __KIND_DISPATCH
+	static void DispatchDecoder(DecodeState* state, uint8_t kind);
+#endif
+#ifndef __ASMX86DEC_UNCHECKED
+	static bool __UNCHECKED(ProcessInstructionBody)(DecodeState* state);
+#endif
+
+
+	static const RegDef* GetByteRegList(DecodeState* state)
+	{
+		if (state->rex)
+			return reg8List64;
+		return reg8List;
+	}
+
+
+	static const RegDef* GetRegListForOpSize(DecodeState* state)
+	{
+		switch (state->opSize)
+		{
+		case 2:
+			return reg16List;
+		case 4:
+			return reg32List;
+		case 8:
+			return reg64List;
+		default:
+			return NULL;
+		}
+	}
+
+
+	static const RegDef* GetRegListForFinalOpSize(DecodeState* state)
+	{
+		switch (state->finalOpSize)
+		{
+		case 1:
+			return GetByteRegList(state);
+		case 2:
+			return reg16List;
+		case 4:
+			return reg32List;
+		case 8:
+			return reg64List;
+		default:
+			return NULL;
+		}
+	}
+
+
+	static const RegDef* GetRegListForAddrSize(DecodeState* state)
+	{
+		if (__ADDR16(state))
+			return reg16List;
+		if (__ADDR64(state))
+			return reg64List;
+		return reg32List;
+	}
+
+
+	static uint16_t GetFinalOpSize(DecodeState* state)
+	{
+		if (state->flags & DEC_FLAG_BYTE)
+			return 1;
+		return state->opSize;
+	}
+
+
+	static uint8_t Read8(DecodeState* state)
+	{
+		uint8_t val;
+
+#ifndef __ASMX86DEC_UNCHECKED
+		if (state->len < 1)
+		{
+			// Read past end of buffer, returning 0xcc from now on will guarantee exit
+			state->invalid = true;
+			state->insufficientLength = true;
+			state->len = 0;
+			return 0xcc;
+		}
+#endif
+
+		val = *(state->opcode++);
+#ifndef __ASMX86DEC_UNCHECKED
+		state->len--;
+#endif
+		return val;
+	}
+
+
+	static uint8_t Peek8(DecodeState* state)
+	{
+		uint8_t val;
+
+#ifndef __ASMX86DEC_UNCHECKED
+		if (state->len < 1)
+		{
+			// Read past end of buffer, returning 0xcc from now on will guarantee exit
+			state->invalid = true;
+			state->insufficientLength = true;
+			state->len = 0;
+			return 0xcc;
+		}
+#endif
+
+		val = *state->opcode;
+		return val;
+	}
+
+
+	// Reads the ModRM byte, remembering where it is for DisassembleWithEncoding
+	static uint8_t ReadModRM(DecodeState* state)
+	{
+		state->modRM = state->opcode;
+		return Read8(state);
+	}
+
+
+	static uint16_t Read16(DecodeState* state)
+	{
+		uint16_t val;
+
+#ifndef __ASMX86DEC_UNCHECKED
+		if (state->len < 2)
+		{
+			// Read past end of buffer
+			state->invalid = true;
+			state->insufficientLength = true;
+			state->len = 0;
+			return 0;
+		}
+#endif
+
+		memcpy(&val, state->opcode, sizeof(val));
+		state->opcode += 2;
+#ifndef __ASMX86DEC_UNCHECKED
+		state->len -= 2;
+#endif
+		return val;
+	}
+
+
+	static uint32_t Read32(DecodeState* state)
+	{
+		uint32_t val;
+
+#ifndef __ASMX86DEC_UNCHECKED
+		if (state->len < 4)
+		{
+			// Read past end of buffer
+			state->invalid = true;
+			state->insufficientLength = true;
+			state->len = 0;
+			return 0;
+		}
+#endif
+
+		memcpy(&val, state->opcode, sizeof(val));
+		state->opcode += 4;
+#ifndef __ASMX86DEC_UNCHECKED
+		state->len -= 4;
+#endif
+		return val;
+	}
+
+
+	static uint64_t Read64(DecodeState* state)
+	{
+		uint64_t val;
+
+#ifndef __ASMX86DEC_UNCHECKED
+		if (state->len < 8)
+		{
+			// Read past end of buffer
+			state->invalid = true;
+			state->insufficientLength = true;
+			state->len = 0;
+			return 0;
+		}
+#endif
+
+		memcpy(&val, state->opcode, sizeof(val));
+		state->opcode += 8;
+#ifndef __ASMX86DEC_UNCHECKED
+		state->len -= 8;
+#endif
+		return val;
+	}
+
+
+	static int64_t ReadSigned8(DecodeState* state)
+	{
+		return (int64_t)(int8_t)Read8(state);
+	}
+
+
+	static int64_t ReadSigned16(DecodeState* state)
+	{
+		return (int64_t)(int16_t)Read16(state);
+	}
+
+
+	static int64_t ReadSigned32(DecodeState* state)
+	{
+		return (int64_t)(int32_t)Read32(state);
+	}
+
+
+	static int64_t ReadFinalOpSize(DecodeState* state)
+	{
+		if (state->flags & DEC_FLAG_IMM_SX)
+			return ReadSigned8(state);
+		switch (state->finalOpSize)
+		{
+		case 1:
+			return Read8(state);
+		case 2:
+			return Read16(state);
+		case 4:
+			return Read32(state);
+		case 8:
+			return ReadSigned32(state);
+		}
+		return 0;
+	}
+
+
+	static int64_t ReadAddrSize(DecodeState* state)
+	{
+		if (__ADDR16(state))
+			return Read16(state);
+		return Read32(state);
+	}
+
+
+	static int64_t ReadSignedFinalOpSize(DecodeState* state)
+	{
+		switch (state->finalOpSize)
+		{
+		case 1:
+			return ReadSigned8(state);
+		case 2:
+			return ReadSigned16(state);
+		case 4:
+		case 8:
+			return ReadSigned32(state);
+		}
+		return 0;
+	}
+
+
+	static void UpdateOperationForAddrSize(DecodeState* state)
+	{
+		if (__ADDR64(state))
+			state->result->operation = (InstructionOperation)(state->result->operation + 2);
+		else if (!__ADDR16(state))
+			state->result->operation = (InstructionOperation)(state->result->operation + 1);
+	}
+
+
+	static void ProcessEncoding(DecodeState* state, const InstructionEncoding* encoding)
+	{
+		state->result->operation = (InstructionOperation)encoding->operation;
+
+		state->flags = encoding->flags;
+		if (__USING64(state) && (state->flags & DEC_FLAG_INVALID_IN_64BIT))
+		{
+			state->invalid = true;
+			return;
+		}
+		if (__USING64(state) && (state->flags & DEC_FLAG_DEFAULT_TO_64BIT))
+			state->opSize = state->opPrefix ? 4 : 8;
+		state->finalOpSize = GetFinalOpSize(state);
+
+		if (state->flags & DEC_FLAG_FLIP_OPERANDS)
+		{
+			state->operand0 = &state->result->operands[1];
+			state->operand1 = &state->result->operands[0];
+		}
+		else
+		{
+			state->operand0 = &state->result->operands[0];
+			state->operand1 = &state->result->operands[1];
+		}
+
+		if (state->flags & DEC_FLAG_FORCE_16BIT)
+			state->finalOpSize = 2;
+
+		if (state->flags & DEC_FLAG_OPERATION_OP_SIZE)
+		{
+			if (state->finalOpSize == 4)
+				state->result->operation = (InstructionOperation)(state->result->operation + 1);
+			else if (state->finalOpSize == 8)
+				state->result->operation = (InstructionOperation)(state->result->operation + 2);
+		}
+
+		if (state->flags & DEC_FLAG_REP)
+		{
+			if (state->rep != REP_PREFIX_NONE)
+				state->result->flags |= X86_FLAG_REP;
+		}
+		else if (state->flags & DEC_FLAG_REP_COND)
+		{
+			if (state->rep == REP_PREFIX_REPNE)
+				state->result->flags |= X86_FLAG_REPNE;
+			else if (state->rep == REP_PREFIX_REPE)
+				state->result->flags |= X86_FLAG_REPE;
+		}
+
+#ifdef __KIND_DISPATCH
+		DispatchDecoder(state, encoding->kind);
+#else
+		encoding->func(state);
+#endif
+
+		if (state->result->operation == INVALID)
+			state->invalid = true;
+
+		if (state->result->flags & X86_FLAG_LOCK)
+		{
+			// Ensure instruction allows lock and it has proper semantics
+			if (!(state->flags & DEC_FLAG_LOCK))
+				state->invalid = true;
+			else if (state->result->operation == CMP)
+				state->invalid = true;
+			else if ((state->result->operands[0].operand != MEM) && (state->result->operands[1].operand != MEM))
+				state->invalid = true;
+		}
+	}
+
+
+	static void ProcessOpcode(DecodeState* state, const InstructionEncoding* map, uint8_t opcode)
+	{
+		ProcessEncoding(state, &map[opcode]);
+	}
+
+
+	static SegmentRegister GetFinalSegment(DecodeState* state, SegmentRegister seg)
+	{
+		return (state->result->segment == SEG_DEFAULT) ? seg : state->result->segment;
+	}
+
+
+	static void SetMemOperand(DecodeState* state, InstructionOperand* oper, const RMDef* def, int64_t immed)
+	{
+		oper->operand = MEM;
+		oper->components[0] = def->first;
+		oper->components[1] = def->second;
+		oper->immediate = immed;
+		oper->segment = GetFinalSegment(state, def->segment);
+	}
+
+
+	static void DecodeRM(DecodeState* state, InstructionOperand* rmOper, const RegDef* regList, uint16_t rmSize, uint8_t* regOper)
+	{
+		uint8_t rmByte = ReadModRM(state);
+		uint8_t mod = rmByte >> 6;
+		uint8_t rm = rmByte & 7;
+		InstructionOperand temp;
+
+		if (regOper)
+			*regOper = (rmByte >> 3) & 7;
+
+		if (!rmOper)
+			rmOper = &temp;
+
+		rmOper->size = rmSize;
+		if (__ADDR16(state))
+		{
+			static const RMDef rm16Components[9] = {{REG_BX, REG_SI, SEG_DS}, {REG_BX, REG_DI, SEG_DS},
+				{REG_BP, REG_SI, SEG_SS}, {REG_BP, REG_DI, SEG_SS}, {REG_SI, NONE, SEG_DS},
+				{REG_DI, NONE, SEG_DS}, {REG_BP, NONE, SEG_SS}, {REG_BX, NONE, SEG_DS},
+				{NONE, NONE, SEG_DS}};
+			switch (mod)
+			{
+			case 0:
+				if (rm == 6)
+				{
+					rm = 8;
+					SetMemOperand(state, rmOper, &rm16Components[rm], Read16(state));
+				}
+				else
+					SetMemOperand(state, rmOper, &rm16Components[rm], 0);
+				break;
+			case 1:
+				SetMemOperand(state, rmOper, &rm16Components[rm], ReadSigned8(state));
+				break;
+			case 2:
+				SetMemOperand(state, rmOper, &rm16Components[rm], ReadSigned16(state));
+				break;
+			case 3:
+				rmOper->operand = (OperandType)regList[rm];
+				break;
+			}
+			if (rmOper->components[0] == NONE)
+				rmOper->immediate &= 0xffff;
+		}
+		else
+		{
+			const RegDef* addrRegList = GetRegListForAddrSize(state);
+			uint8_t rmReg1Offset = state->rexRM1 ? 8 : 0;
+			uint8_t rmReg2Offset = state->rexRM2 ? 8 : 0;
+			SegmentRegister seg = SEG_DEFAULT;
+			rmOper->operand = MEM;
+			if ((mod != 3) && (rm == 4))
+			{
+				// SIB byte present
+				uint8_t sibByte = Read8(state);
+				uint8_t base = sibByte & 7;
+				uint8_t index = (sibByte >> 3) & 7;
+				rmOper->scale = 1 << (sibByte >> 6);
+				if ((mod != 0) || (base != 5))
+					rmOper->components[0] = (OperandType)addrRegList[base + rmReg1Offset];
+				if ((index + rmReg2Offset) != 4)
+					rmOper->components[1] = (OperandType)addrRegList[index + rmReg2Offset];
+				switch (mod)
+				{
+				case 0:
+					if (base == 5)
+						rmOper->immediate = ReadSigned32(state);
+					break;
+				case 1:
+					rmOper->immediate = ReadSigned8(state);
+					break;
+				case 2:
+					rmOper->immediate = ReadSigned32(state);
+					break;
+				}
+				if (((base + rmReg1Offset) == 4) || ((base + rmReg1Offset) == 5))
+					seg = SEG_SS;
+				else
+					seg = SEG_DS;
+			}
+			else
+			{
+				switch (mod)
+				{
+				case 0:
+					if (rm == 5)
+					{
+						rmOper->immediate = ReadSigned32(state);
+						if (__ADDR64(state))
+						{
+							state->ripRelFixup = &rmOper->immediate;
+							rmOper->relative = true;
+						}
+					}
+					else
+						rmOper->components[0] = (OperandType)addrRegList[rm + rmReg1Offset];
+					seg = SEG_DS;
+					break;
+				case 1:
+					rmOper->components[0] = (OperandType)addrRegList[rm + rmReg1Offset];
+					rmOper->immediate = ReadSigned8(state);
+					seg = (rm == 5) ? SEG_SS : SEG_DS;
+					break;
+				case 2:
+					rmOper->components[0] = (OperandType)addrRegList[rm + rmReg1Offset];
+					rmOper->immediate = ReadSigned32(state);
+					seg = (rm == 5) ? SEG_SS : SEG_DS;
+					break;
+				case 3:
+					rmOper->operand = (OperandType)regList[rm + rmReg1Offset];
+					break;
+				}
+			}
+			if (seg != SEG_DEFAULT)
+				rmOper->segment = GetFinalSegment(state, seg);
+		}
+
+		// The SIB byte and displacement end here
+		state->modRMEnd = state->opcode;
+	}
+
+
+	static void DecodeRMReg(DecodeState* state, InstructionOperand* rmOper, const RegDef* rmRegList, uint16_t rmSize,
+		InstructionOperand* regOper, const RegDef* regList, uint16_t regSize)
+	{
+		uint8_t reg;
+		DecodeRM(state, rmOper, rmRegList, rmSize, &reg);
+		if (regOper)
+		{
+			uint8_t regOffset = state->rexReg ? 8 : 0;
+			regOper->size = regSize;
+			regOper->operand = (OperandType)regList[reg + regOffset];
+		}
+	}
+
+
+	static void SetOperandToEsEdi(DecodeState* state, InstructionOperand* oper, uint16_t size)
+	{
+		const RegDef* addrRegList = GetRegListForAddrSize(state);
+		oper->operand = MEM;
+		oper->components[0] = (OperandType)addrRegList[7];
+		oper->size = size;
+		oper->segment = SEG_ES;
+	}
+
+
+	static void SetOperandToDsEsi(DecodeState* state, InstructionOperand* oper, uint16_t size)
+	{
+		const RegDef* addrRegList = GetRegListForAddrSize(state);
+		oper->operand = MEM;
+		oper->components[0] = (OperandType)addrRegList[6];
+		oper->size = size;
+		oper->segment = GetFinalSegment(state, SEG_DS);
+	}
+
+
+	static void SetOperandToImmAddr(DecodeState* state, InstructionOperand* oper)
+	{
+		oper->operand = MEM;
+		oper->immediate = ReadAddrSize(state);
+		oper->segment = GetFinalSegment(state, SEG_DS);
+		oper->size = state->finalOpSize;
+	}
+
+
+	static void SetOperandToEaxFinalOpSize(DecodeState* state, InstructionOperand* oper)
+	{
+		const RegDef* regList = GetRegListForFinalOpSize(state);
+		oper->operand = (OperandType)regList[0];
+		oper->size = state->finalOpSize;
+	}
+
+
+	static void SetOperandToOpReg(DecodeState* state, InstructionOperand* oper)
+	{
+		const RegDef* regList = GetRegListForFinalOpSize(state);
+		uint8_t regOffset = state->rexRM1 ? 8 : 0;
+		oper->operand = (OperandType)regList[(state->opcode[-1] & 7) + regOffset];
+		oper->size = state->finalOpSize;
+	}
+
+
+	static void SetOperandToImm(DecodeState* state, InstructionOperand* oper)
+	{
+		oper->operand = IMM;
+		oper->size = state->finalOpSize;
+		oper->immediate = ReadFinalOpSize(state);
+	}
+
+
+	static void SetOperandToImm8(DecodeState* state, InstructionOperand* oper)
+	{
+		oper->operand = IMM;
+		oper->size = 1;
+		oper->immediate = Read8(state);
+	}
+
+
+	static void SetOperandToImm16(DecodeState* state, InstructionOperand* oper)
+	{
+		oper->operand = IMM;
+		oper->size = 2;
+		oper->immediate = Read16(state);
+	}
+
+
+	static uint8_t DecodeSSEPrefix(DecodeState* state)
+	{
+		if (state->opPrefix)
+		{
+			state->opPrefix = false;
+			return 1;
+		}
+		else if (state->rep == REP_PREFIX_REPNE)
+		{
+			state->rep = REP_PREFIX_NONE;
+			return 2;
+		}
+		else if (state->rep == REP_PREFIX_REPE)
+		{
+			state->rep = REP_PREFIX_NONE;
+			return 3;
+		}
+		return 0;
+	}
+
+
+	static uint16_t GetSizeForSSEType(uint8_t type)
+	{
+		if (type == 2)
+			return 8;
+		if (type == 3)
+			return 4;
+		return 16;
+	}
+
+
+	static InstructionOperand* GetOperandForSSEEntryType(DecodeState* state, uint16_t type, uint8_t operandIndex)
+	{
+		if (type == SSE_128_FLIP)
+			operandIndex = 1 - operandIndex;
+		if (operandIndex == 0)
+			return state->operand0;
+		return state->operand1;
+	}
+
+
+	static const RegDef* GetRegListForSSEEntryType(DecodeState* state, uint16_t type)
+	{
+		switch (type)
+		{
+		case MMX_32:
+		case MMX_64:
+			return mmxRegList;
+		case GPR_32_OR_64:
+			return (state->opSize == 8) ? reg64List : reg32List;
+		default:
+			return xmmRegList;
+		}
+	}
+
+
+	static uint16_t GetSizeForSSEEntryType(DecodeState* state, uint16_t type)
+	{
+		switch (type)
+		{
+		case SSE_16:
+			return 2;
+		case SSE_32:
+		case MMX_32:
+			return 4;
+		case SSE_64:
+		case MMX_64:
+			return 8;
+		case GPR_32_OR_64:
+			return (state->opSize == 8) ? 8 : 4;
+		default:
+			return 16;
+		}
+	}
+
+
+	static void UpdateOperationForSSEEntryType(DecodeState* state, uint16_t type)
+	{
+		if ((type == GPR_32_OR_64) && (state->opSize == 8))
+			state->result->operation = (InstructionOperation)((int)state->result->operation + 1);
+	}
+
+
+	static void InvalidDecode(DecodeState* state)
+	{
+		state->invalid = true;
+	}
+
+
+	static void DecodeTwoByte(DecodeState* state)
+	{
+		uint8_t opcode = Read8(state);
+		if (opcode == 0x38)
+			ProcessOpcode(state, threeByte0F38Map, Read8(state));
+		else if (opcode == 0x3a)
+		{
+			ProcessOpcode(state, threeByte0F3AMap, Read8(state));
+			SetOperandToImm8(state, &state->result->operands[2]);
+		}
+		else
+			ProcessOpcode(state, twoByteOpcodeMap, opcode);
+	}
+
+
+	static void DecodeFpu(DecodeState* state)
+	{
+		uint8_t modRM = Peek8(state);
+		uint8_t reg = (modRM >> 3) & 7;
+		uint8_t op = (uint8_t)state->result->operation;
+
+		const InstructionEncoding* map;
+		if ((modRM & 0xc0) == 0xc0)
+			map = fpuRegOpcodeMap[op];
+		else
+			map = fpuMemOpcodeMap[op];
+		ProcessEncoding(state, &map[reg]);
+	}
+
+
+	static void DecodeNoOperands(DecodeState* state)
+	{
+	}
+
+
+	static void DecodeRegRM(DecodeState* state)
+	{
+		uint16_t size = state->finalOpSize;
+		const RegDef* regList = GetRegListForFinalOpSize(state);
+		switch (state->flags & DEC_FLAG_REG_RM_SIZE_MASK)
+		{
+		case 0:
+			break;
+		case DEC_FLAG_REG_RM_2X_SIZE:
+			size *= 2;
+			break;
+		case DEC_FLAG_REG_RM_FAR_SIZE:
+			size += 2;
+			break;
+		case DEC_FLAG_REG_RM_NO_SIZE:
+			size = 0;
+			break;
+		}
+
+		DecodeRMReg(state, state->operand1, regList, size, state->operand0, regList, state->finalOpSize);
+
+		if ((size != state->finalOpSize) && (state->operand1->operand != MEM))
+			state->invalid = true;
+	}
+
+
+	static void DecodeRegRMImm(DecodeState* state)
+	{
+		const RegDef* regList = GetRegListForFinalOpSize(state);
+		DecodeRMReg(state, state->operand1, regList, state->finalOpSize, state->operand0, regList, state->finalOpSize);
+		SetOperandToImm(state, &state->result->operands[2]);
+	}
+
+
+	static void DecodeRMRegImm8(DecodeState* state)
+	{
+		const RegDef* regList = GetRegListForFinalOpSize(state);
+		DecodeRMReg(state, state->operand0, regList, state->finalOpSize, state->operand1, regList, state->finalOpSize);
+		SetOperandToImm8(state, &state->result->operands[2]);
+	}
+
+
+	static void DecodeRMRegCL(DecodeState* state)
+	{
+		const RegDef* regList = GetRegListForFinalOpSize(state);
+		DecodeRMReg(state, state->operand0, regList, state->finalOpSize, state->operand1, regList, state->finalOpSize);
+		state->result->operands[2].operand = REG_CL;
+		state->result->operands[2].size = 1;
+	}
+
+
+	static void DecodeEaxImm(DecodeState* state)
+	{
+		SetOperandToEaxFinalOpSize(state, state->operand0);
+		SetOperandToImm(state, state->operand1);
+	}
+
+
+	static void DecodePushPopSeg(DecodeState* state)
+	{
+		int8_t offset = 0;
+		if (state->opcode[-1] >= 0xa0) // FS/GS
+			offset = -16;
+		state->operand0->operand = (OperandType)(REG_ES + (state->opcode[-1] >> 3) + offset);
+		state->operand0->size = state->opSize;
+	}
+
+
+	static void DecodeOpReg(DecodeState* state)
+	{
+		SetOperandToOpReg(state, state->operand0);
+	}
+
+
+	static void DecodeEaxOpReg(DecodeState* state)
+	{
+		SetOperandToEaxFinalOpSize(state, state->operand0);
+		SetOperandToOpReg(state, state->operand1);
+	}
+
+
+	static void DecodeOpRegImm(DecodeState* state)
+	{
+		SetOperandToOpReg(state, state->operand0);
+		state->operand1->operand = IMM;
+		state->operand1->size = state->finalOpSize;
+		state->operand1->immediate = (state->opSize == 8) ? Read64(state) : ReadFinalOpSize(state);
+	}
+
+
+	static void DecodeNop(DecodeState* state)
+	{
+		if (state->rexRM1)
+		{
+			state->result->operation = XCHG;
+			DecodeEaxOpReg(state);
+		}
+	}
+
+
+	static void DecodeImm(DecodeState* state)
+	{
+		SetOperandToImm(state, state->operand0);
+	}
+
+
+	static void DecodeImm16Imm8(DecodeState* state)
+	{
+		SetOperandToImm16(state, state->operand0);
+		SetOperandToImm8(state, state->operand1);
+	}
+
+
+	static void DecodeEdiDx(DecodeState* state)
+	{
+		SetOperandToEsEdi(state, state->operand0, state->finalOpSize);
+		state->operand1->operand = REG_DX;
+		state->operand1->size = 2;
+	}
+
+
+	static void DecodeDxEsi(DecodeState* state)
+	{
+		state->operand0->operand = REG_DX;
+		state->operand0->size = 2;
+		SetOperandToDsEsi(state, state->operand1, state->finalOpSize);
+	}
+
+
+	static void DecodeRelImm(DecodeState* state)
+	{
+		state->operand0->operand = IMM;
+		state->operand0->size = state->opSize;
+		state->operand0->immediate = ReadSignedFinalOpSize(state);
+		state->operand0->immediate += state->addr + (state->opcode - state->opcodeStart);
+	}
+
+
+	static void DecodeRelImmAddrSize(DecodeState* state)
+	{
+		DecodeRelImm(state);
+		UpdateOperationForAddrSize(state);
+	}
+
+
+	static void DecodeGroupRM(DecodeState* state)
+	{
+		const RegDef* regList = GetRegListForFinalOpSize(state);
+		uint8_t regField;
+		DecodeRM(state, state->operand0, regList, state->finalOpSize, &regField);
+		state->result->operation = (InstructionOperation)groupOperations[(int)state->result->operation][regField];
+	}
+
+
+	static void DecodeGroupRMImm(DecodeState* state)
+	{
+		DecodeGroupRM(state);
+		SetOperandToImm(state, state->operand1);
+	}
+
+
+	static void DecodeGroupRMImm8V(DecodeState* state)
+	{
+		DecodeGroupRM(state);
+		SetOperandToImm8(state, state->operand1);
+	}
+
+
+	static void DecodeGroupRMOne(DecodeState* state)
+	{
+		DecodeGroupRM(state);
+		state->operand1->operand = IMM;
+		state->operand1->size = 1;
+		state->operand1->immediate = 1;
+	}
+
+
+	static void DecodeGroupRMCl(DecodeState* state)
+	{
+		DecodeGroupRM(state);
+		state->operand1->operand = REG_CL;
+		state->operand1->size = 1;
+	}
+
+
+	static void DecodeGroupF6F7(DecodeState* state)
+	{
+		DecodeGroupRM(state);
+		if (state->result->operation == TEST)
+			SetOperandToImm(state, state->operand1);
+		// Check for valid locking semantics
+		if ((state->result->flags & X86_FLAG_LOCK) && (state->result->operation != NOT) && (state->result->operation != NEG))
+			state->invalid = true;
+	}
+
+
+	static void DecodeGroupFF(DecodeState* state)
+	{
+		if (__USING64(state))
+		{
+			// Default to 64-bit for jumps and calls
+			uint8_t rm = Peek8(state);
+			uint8_t regField = (rm >> 3) & 7;
+			if ((regField >= 2) && (regField <= 5))
+				state->finalOpSize = state->opSize = state->opPrefix ? 4 : 8;
+			else if (regField == 6)
+				state->finalOpSize = state->opSize = 8; // Prefix doesn't matter for 64 bit push
+		}
+		DecodeGroupRM(state);
+		// Check for valid far jump/call semantics
+		if ((state->result->operation == CALLF) || (state->result->operation == JMPF))
+		{
+			if (state->operand0->operand != MEM)
+				state->invalid = true;
+			state->operand0->size += 2;
+		}
+		// Check for valid locking semantics
+		if ((state->result->flags & X86_FLAG_LOCK) && (state->result->operation != INC) && (state->result->operation != DEC))
+			state->invalid = true;
+	}
+
+
+	static void DecodeGroup0F00(DecodeState* state)
+	{
+		uint8_t rm = Peek8(state);
+		uint8_t regField = (rm >> 3) & 7;
+		if (regField >= 2)
+			state->opSize = 2;
+		DecodeGroupRM(state);
+	}
+
+
+	static void DecodeGroup0F01(DecodeState* state)
+	{
+		uint8_t rm = Peek8(state);
+		uint8_t modField = (rm >> 6) & 3;
+		uint8_t regField = (rm >> 3) & 7;
+		uint8_t rmField = rm & 7;
+
+		if ((modField == 3) && (regField != 4) && (regField != 6))
+		{
+			state->result->operation = (InstructionOperation)group0F01RegOperations[regField][rmField];
+			ReadModRM(state);
+			return;
+		}
+
+		if (regField < 4)
+			state->opSize = __USING64(state) ? 10 : 6;
+		else if (regField != 7)
+			state->opSize = 2;
+		else
+			state->opSize = 1;
+		DecodeGroupRM(state);
+	}
+
+
+	static void DecodeGroup0FAE(DecodeState* state)
+	{
+		uint8_t rm = Peek8(state);
+		uint8_t modField = (rm >> 6) & 3;
+		uint8_t regField = (rm >> 3) & 7;
+
+		if (((rm & 0xf8) == 0xe8) || ((rm & 0xf8) == 0xf8))
+		{
+			state->result->operation = (InstructionOperation)groupOperations[(int)state->result->operation + 1][regField];
+			ReadModRM(state);
+			return;
+		}
+
+		if (modField == 3)
+		{
+			state->result->operation = (InstructionOperation)groupOperations[(int)state->result->operation + 1][regField];
+			return;
+		}
+
+		if ((regField & 2) == 0)
+			state->opSize = 512;
+		else if ((regField & 6) == 2)
+			state->opSize = 4;
+		else
+			state->opSize = 1;
+		DecodeGroupRM(state);
+	}
+
+
+	static void Decode0FB8(DecodeState* state)
+	{
+		if (state->rep != REP_PREFIX_REPE)
+		{
+			if (__USING64(state))
+				state->opSize = state->opPrefix ? 4 : 8;
+			state->finalOpSize = GetFinalOpSize(state);
+			DecodeRelImm(state);
+			return;
+		}
+
+		DecodeRegRM(state);
+	}
+
+
+	static void DecodeRMSRegV(DecodeState* state)
+	{
+		const RegDef* regList = GetRegListForOpSize(state);
+		uint8_t regField;
+		DecodeRM(state, state->operand0, regList, state->opSize, &regField);
+		if (regField >= 6)
+			state->invalid = true;
+		state->operand1->operand = (OperandType)(REG_ES + regField);
+		state->operand1->size = 2;
+		if (state->result->operands[0].operand == REG_CS)
+			state->invalid = true;
+	}
+
+
+	static void DecodeRM8(DecodeState* state)
+	{
+		const RegDef* regList = GetByteRegList(state);
+		DecodeRM(state, state->operand0, regList, 1, NULL);
+	}
+
+
+	static void DecodeRMV(DecodeState* state)
+	{
+		const RegDef* regList = GetRegListForOpSize(state);
+		DecodeRM(state, state->operand0, regList, state->opSize, NULL);
+	}
+
+
+	static void DecodeFarImm(DecodeState* state)
+	{
+		SetOperandToImm(state, state->operand1);
+		SetOperandToImm16(state, state->operand0);
+	}
+
+
+	static void DecodeEaxAddr(DecodeState* state)
+	{
+		SetOperandToEaxFinalOpSize(state, state->operand0);
+		SetOperandToImmAddr(state, state->operand1);
+	}
+
+
+	static void DecodeEdiEsi(DecodeState* state)
+	{
+		SetOperandToEsEdi(state, state->operand0, state->finalOpSize);
+		SetOperandToDsEsi(state, state->operand1, state->finalOpSize);
+	}
+
+
+	static void DecodeEdiEax(DecodeState* state)
+	{
+		SetOperandToEsEdi(state, state->operand0, state->finalOpSize);
+		SetOperandToEaxFinalOpSize(state, state->operand1);
+	}
+
+
+	static void DecodeEaxEsi(DecodeState* state)
+	{
+		SetOperandToEaxFinalOpSize(state, state->operand0);
+		SetOperandToDsEsi(state, state->operand1, state->finalOpSize);
+	}
+
+
+	static void DecodeAlEbxAl(DecodeState* state)
+	{
+		const RegDef* regList = GetRegListForAddrSize(state);
+		state->operand0->operand = REG_AL;
+		state->operand0->size = 1;
+		state->operand1->operand = MEM;
+		state->operand1->components[0] = (OperandType)regList[3];
+		state->operand1->components[1] = REG_AL;
+		state->operand1->size = 1;
+		state->operand1->segment = GetFinalSegment(state, SEG_DS);
+	}
+
+
+	static void DecodeEaxImm8(DecodeState* state)
+	{
+		SetOperandToEaxFinalOpSize(state, state->operand0);
+		SetOperandToImm8(state, state->operand1);
+	}
+
+
+	static void DecodeEaxDx(DecodeState* state)
+	{
+		SetOperandToEaxFinalOpSize(state, state->operand0);
+		state->operand1->operand = REG_DX;
+		state->operand1->size = 2;
+	}
+
+
+	static void Decode3DNow(DecodeState* state)
+	{
+		DecodeRMReg(state, state->operand1, mmxRegList, 8, state->operand0, mmxRegList, 8);
+		state->result->operation = (InstructionOperation)threeDNowOpcodeMap[Read8(state)];
+	}
+
+
+	static void DecodeSSETable(DecodeState* state)
+	{
+		uint8_t type = DecodeSSEPrefix(state);
+		uint8_t rm = Peek8(state);
+		uint8_t modField = (rm >> 6) & 3;
+
+		const SSETableEntry* entry = &sseTable[(int)state->result->operation];
+		const SSETableOperationEntry* opEntry;
+
+		if (modField == 3)
+			opEntry = &entry->regOps[type];
+		else
+			opEntry = &entry->memOps[type];
+
+		state->result->operation = (InstructionOperation)opEntry->operation;
+		DecodeRMReg(state, GetOperandForSSEEntryType(state, opEntry->rmType, 1), GetRegListForSSEEntryType(state, opEntry->rmType),
+			GetSizeForSSEEntryType(state, opEntry->rmType), GetOperandForSSEEntryType(state, opEntry->regType, 0),
+			GetRegListForSSEEntryType(state, opEntry->regType), GetSizeForSSEEntryType(state, opEntry->regType));
+
+		if (state->flags & DEC_FLAG_INC_OPERATION_FOR_64)
+		{
+			UpdateOperationForSSEEntryType(state, opEntry->regType);
+			UpdateOperationForSSEEntryType(state, opEntry->rmType);
+		}
+	}
+
+
+	static void DecodeSSETableImm8(DecodeState* state)
+	{
+		DecodeSSETable(state);
+		SetOperandToImm8(state, &state->result->operands[2]);
+	}
+
+
+	static void DecodeSSETableMem8(DecodeState* state)
+	{
+		DecodeSSETable(state);
+		if (state->operand0->operand == MEM)
+			state->operand0->size = 1;
+		if (state->operand1->operand == MEM)
+			state->operand1->size = 1;
+	}
+
+
+	static void DecodeSSE(DecodeState* state)
+	{
+		uint8_t type = DecodeSSEPrefix(state);
+		uint8_t rm = Peek8(state);
+		uint8_t modField = (rm >> 6) & 3;
+		uint16_t size;
+
+		state->result->operation = (InstructionOperation)((int)state->result->operation + type);
+		if (modField == 3)
+			size = 16;
+		else
+			size = GetSizeForSSEType(type);
+		DecodeRMReg(state, state->operand1, xmmRegList, size, state->operand0, xmmRegList, 16);
+	}
+
+
+	static void DecodeSSESingle(DecodeState* state)
+	{
+		uint8_t type = DecodeSSEPrefix(state);
+
+		if ((type == 1) || (type == 2))
+		{
+			state->invalid = true;
+			return;
+		}
+
+		state->result->operation = (InstructionOperation)((int)state->result->operation + (type & 1));
+		DecodeRMReg(state, state->operand1, xmmRegList, 16, state->operand0, xmmRegList, 16);
+	}
+
+
+	static void DecodeSSEPacked(DecodeState* state)
+	{
+		uint8_t type = DecodeSSEPrefix(state);
+
+		if ((type == 2) || (type == 3))
+		{
+			state->invalid = true;
+			return;
+		}
+
+		state->result->operation = (InstructionOperation)((int)state->result->operation + (type & 1));
+		DecodeRMReg(state, state->operand1, xmmRegList, 16, state->operand0, xmmRegList, 16);
+	}
+
+
+	static void DecodeMMX(DecodeState* state)
+	{
+		if (state->opPrefix)
+			DecodeRMReg(state, state->operand1, xmmRegList, 16, state->operand0, xmmRegList, 16);
+		else
+			DecodeRMReg(state, state->operand1, mmxRegList, 8, state->operand0, mmxRegList, 8);
+	}
+
+
+	static void DecodeMMXSSEOnly(DecodeState* state)
+	{
+		if (state->opPrefix)
+			DecodeRMReg(state, state->operand1, xmmRegList, 16, state->operand0, xmmRegList, 16);
+		else
+			state->invalid = true;
+	}
+
+
+	static void DecodeMMXGroup(DecodeState* state)
+	{
+		uint8_t regField;
+		if (state->opPrefix)
+		{
+			DecodeRM(state, state->operand0, xmmRegList, 16, &regField);
+			state->result->operation = (InstructionOperation)mmxGroupOperations[(int)state->result->operation][regField][1];
+		}
+		else
+		{
+			DecodeRM(state, state->operand0, mmxRegList, 8, &regField);
+			state->result->operation = (InstructionOperation)mmxGroupOperations[(int)state->result->operation][regField][0];
+		}
+		SetOperandToImm8(state, state->operand1);
+	}
+
+
+	static void DecodePinsrw(DecodeState* state)
+	{
+		DecodeSSETableImm8(state);
+		if (state->operand1->operand == MEM)
+			state->operand1->size = 2;
+	}
+
+
+	static void DecodeRegCR(DecodeState* state)
+	{
+		const RegDef* regList;
+		uint8_t reg;
+		if (state->opSize == 2)
+			state->opSize = 4;
+		regList = GetRegListForOpSize(state);
+		reg = ReadModRM(state);
+		if (state->result->flags & X86_FLAG_LOCK)
+		{
+			state->result->flags &= ~X86_FLAG_LOCK;
+			state->rexReg = true;
+		}
+		state->operand0->operand = regList[(reg & 7) + (state->rexRM1 ? 8 : 0)];
+		state->operand0->size = state->opSize;
+		state->operand1->operand = (OperandType)((int)state->result->operation + ((reg >> 3) & 7) +
+			(state->rexReg ? 8 : 0));
+		state->operand1->size = state->opSize;
+		state->result->operation = MOV;
+	}
+
+
+	static void DecodeMovSXZX8(DecodeState* state)
+	{
+		DecodeRMReg(state, state->operand1, GetByteRegList(state), 1, state->operand0, GetRegListForOpSize(state), state->opSize);
+	}
+
+
+	static void DecodeMovSXZX16(DecodeState* state)
+	{
+		DecodeRMReg(state, state->operand1, reg16List, 2, state->operand0, GetRegListForOpSize(state), state->opSize);
+	}
+
+
+	static void DecodeMem16(DecodeState* state)
+	{
+		DecodeRM(state, state->operand0, reg32List, 2, NULL);
+		if (state->operand0->operand != MEM)
+			state->invalid = true;
+	}
+
+
+	static void DecodeMem32(DecodeState* state)
+	{
+		DecodeRM(state, state->operand0, reg32List, 4, NULL);
+		if (state->operand0->operand != MEM)
+			state->invalid = true;
+	}
+
+
+	static void DecodeMem64(DecodeState* state)
+	{
+		DecodeRM(state, state->operand0, reg32List, 8, NULL);
+		if (state->operand0->operand != MEM)
+			state->invalid = true;
+	}
+
+
+	static void DecodeMem80(DecodeState* state)
+	{
+		DecodeRM(state, state->operand0, reg32List, 10, NULL);
+		if (state->operand0->operand != MEM)
+			state->invalid = true;
+	}
+
+
+	static void DecodeMemFloatEnv(DecodeState* state)
+	{
+		DecodeRM(state, state->operand0, reg32List, (state->opSize == 2) ? 14 : 28, NULL);
+		if (state->operand0->operand != MEM)
+			state->invalid = true;
+	}
+
+
+	static void DecodeMemFloatSave(DecodeState* state)
+	{
+		DecodeRM(state, state->operand0, reg32List, (state->opSize == 2) ? 94 : 108, NULL);
+		if (state->operand0->operand != MEM)
+			state->invalid = true;
+	}
+
+
+	static void DecodeFPUReg(DecodeState* state)
+	{
+		DecodeRM(state, state->operand0, fpuRegList, 10, NULL);
+	}
+
+
+	static void DecodeFPURegST0(DecodeState* state)
+	{
+		DecodeFPUReg(state);
+		state->operand1->operand = REG_ST0;
+		state->operand1->size = 10;
+	}
+
+
+	static void DecodeRegGroupNoOperands(DecodeState* state)
+	{
+		uint8_t rmByte = ReadModRM(state);
+		state->result->operation = (InstructionOperation)groupOperations[(int)state->result->operation][rmByte & 7];
+	}
+
+
+	static void DecodeRegGroupAX(DecodeState* state)
+	{
+		DecodeRegGroupNoOperands(state);
+		state->operand0->operand = REG_AX;
+		state->operand0->size = 2;
+	}
+
+
+	static void DecodeCmpXch8B(DecodeState* state)
+	{
+		uint8_t rm = Peek8(state);
+		uint8_t regField = (rm >> 3) & 7;
+
+		if (regField == 1)
+		{
+			if (state->opSize == 2)
+				state->opSize = 4;
+			else if (state->opSize == 8)
+				state->result->operation = CMPXCH16B;
+			DecodeRM(state, state->operand0, GetRegListForOpSize(state), state->opSize * 2, NULL);
+		}
+		else if (regField == 6)
+		{
+			if (state->opPrefix)
+				state->result->operation = VMCLEAR;
+			else if (state->rep == REP_PREFIX_REPE)
+				state->result->operation = VMXON;
+			else
+				state->result->operation = VMPTRLD;
+			DecodeRM(state, state->operand0, reg64List, 8, NULL);
+		}
+		else if (regField == 7)
+		{
+			state->result->operation = VMPTRST;
+			DecodeRM(state, state->operand0, reg64List, 8, NULL);
+		}
+		else
+			state->invalid = true;
+
+		if (state->operand0->operand != MEM)
+			state->invalid = true;
+	}
+
+
+	static void DecodeMovNti(DecodeState* state)
+	{
+		if (state->opSize == 2)
+			state->opSize = 4;
+		DecodeRMReg(state, state->operand0, GetRegListForOpSize(state), state->opSize, state->operand1, GetRegListForOpSize(state), state->opSize);
+		if (state->operand0->operand != MEM)
+			state->invalid = true;
+	}
+
+
+	static void DecodeCrc32(DecodeState* state)
+	{
+		const RegDef* srcRegList = GetRegListForFinalOpSize(state);
+		const RegDef* destRegList = (state->opSize == 8) ? reg64List : reg32List;
+		uint16_t destSize = (state->opSize == 8) ? 8 : 4;
+		DecodeRMReg(state, state->operand1, srcRegList, state->finalOpSize, state->operand0, destRegList, destSize);
+	}
+
+
+	static void DecodeArpl(DecodeState* state)
+	{
+		if (__USING64(state))
+		{
+			// In 64-bit ARPL is repurposed to MOVSXD
+			const RegDef* regList = GetRegListForFinalOpSize(state);
+			state->result->operation = MOVSXD;
+			DecodeRMReg(state, state->operand1, reg32List, 4, state->operand0, regList, state->finalOpSize);
+		}
+		else
+		{
+			// ARPL instruction
+			state->operand0 = &state->result->operands[1];
+			state->operand1 = &state->result->operands[0];
+			state->finalOpSize = 2;
+			DecodeRegRM(state);
+		}
+	}
+
+
+#ifdef __KIND_DISPATCH
+	static void DispatchDecoder(DecodeState* state, uint8_t kind)
+	{
+		switch (kind)
+		{
+		case DECODE_INVALID:
+			InvalidDecode(state);
+			break;
+		case DECODE_TWO_BYTE:
+			DecodeTwoByte(state);
+			break;
+		case DECODE_FPU:
+			DecodeFpu(state);
+			break;
+		case DECODE_NO_OPERANDS:
+			DecodeNoOperands(state);
+			break;
+		case DECODE_REG_RM:
+			DecodeRegRM(state);
+			break;
+		case DECODE_REG_RM_IMM:
+			DecodeRegRMImm(state);
+			break;
+		case DECODE_RM_REG_IMM8:
+			DecodeRMRegImm8(state);
+			break;
+		case DECODE_RM_REG_CL:
+			DecodeRMRegCL(state);
+			break;
+		case DECODE_EAX_IMM:
+			DecodeEaxImm(state);
+			break;
+		case DECODE_PUSH_POP_SEG:
+			DecodePushPopSeg(state);
+			break;
+		case DECODE_OP_REG:
+			DecodeOpReg(state);
+			break;
+		case DECODE_EAX_OP_REG:
+			DecodeEaxOpReg(state);
+			break;
+		case DECODE_OP_REG_IMM:
+			DecodeOpRegImm(state);
+			break;
+		case DECODE_NOP:
+			DecodeNop(state);
+			break;
+		case DECODE_IMM:
+			DecodeImm(state);
+			break;
+		case DECODE_IMM16_IMM8:
+			DecodeImm16Imm8(state);
+			break;
+		case DECODE_EDI_DX:
+			DecodeEdiDx(state);
+			break;
+		case DECODE_DX_ESI:
+			DecodeDxEsi(state);
+			break;
+		case DECODE_REL_IMM:
+			DecodeRelImm(state);
+			break;
+		case DECODE_REL_IMM_ADDR_SIZE:
+			DecodeRelImmAddrSize(state);
+			break;
+		case DECODE_GROUP_RM:
+			DecodeGroupRM(state);
+			break;
+		case DECODE_GROUP_RM_IMM:
+			DecodeGroupRMImm(state);
+			break;
+		case DECODE_GROUP_RM_IMM8_V:
+			DecodeGroupRMImm8V(state);
+			break;
+		case DECODE_GROUP_RM_ONE:
+			DecodeGroupRMOne(state);
+			break;
+		case DECODE_GROUP_RM_CL:
+			DecodeGroupRMCl(state);
+			break;
+		case DECODE_GROUP_F6F7:
+			DecodeGroupF6F7(state);
+			break;
+		case DECODE_GROUP_FF:
+			DecodeGroupFF(state);
+			break;
+		case DECODE_GROUP_0F00:
+			DecodeGroup0F00(state);
+			break;
+		case DECODE_GROUP_0F01:
+			DecodeGroup0F01(state);
+			break;
+		case DECODE_GROUP_0FAE:
+			DecodeGroup0FAE(state);
+			break;
+		case DECODE_0FB8:
+			Decode0FB8(state);
+			break;
+		case DECODE_RM_SREG_V:
+			DecodeRMSRegV(state);
+			break;
+		case DECODE_RM_8:
+			DecodeRM8(state);
+			break;
+		case DECODE_RM_V:
+			DecodeRMV(state);
+			break;
+		case DECODE_FAR_IMM:
+			DecodeFarImm(state);
+			break;
+		case DECODE_EAX_ADDR:
+			DecodeEaxAddr(state);
+			break;
+		case DECODE_EDI_ESI:
+			DecodeEdiEsi(state);
+			break;
+		case DECODE_EDI_EAX:
+			DecodeEdiEax(state);
+			break;
+		case DECODE_EAX_ESI:
+			DecodeEaxEsi(state);
+			break;
+		case DECODE_AL_EBX_AL:
+			DecodeAlEbxAl(state);
+			break;
+		case DECODE_EAX_IMM8:
+			DecodeEaxImm8(state);
+			break;
+		case DECODE_EAX_DX:
+			DecodeEaxDx(state);
+			break;
+		case DECODE_3DNOW:
+			Decode3DNow(state);
+			break;
+		case DECODE_SSE_TABLE:
+			DecodeSSETable(state);
+			break;
+		case DECODE_SSE_TABLE_IMM8:
+			DecodeSSETableImm8(state);
+			break;
+		case DECODE_SSE_TABLE_MEM8:
+			DecodeSSETableMem8(state);
+			break;
+		case DECODE_SSE:
+			DecodeSSE(state);
+			break;
+		case DECODE_SSE_SINGLE:
+			DecodeSSESingle(state);
+			break;
+		case DECODE_SSE_PACKED:
+			DecodeSSEPacked(state);
+			break;
+		case DECODE_MMX:
+			DecodeMMX(state);
+			break;
+		case DECODE_MMX_SSE_ONLY:
+			DecodeMMXSSEOnly(state);
+			break;
+		case DECODE_MMX_GROUP:
+			DecodeMMXGroup(state);
+			break;
+		case DECODE_PINSRW:
+			DecodePinsrw(state);
+			break;
+		case DECODE_REG_CR:
+			DecodeRegCR(state);
+			break;
+		case DECODE_MOVSXZX_8:
+			DecodeMovSXZX8(state);
+			break;
+		case DECODE_MOVSXZX_16:
+			DecodeMovSXZX16(state);
+			break;
+		case DECODE_MEM_16:
+			DecodeMem16(state);
+			break;
+		case DECODE_MEM_32:
+			DecodeMem32(state);
+			break;
+		case DECODE_MEM_64:
+			DecodeMem64(state);
+			break;
+		case DECODE_MEM_80:
+			DecodeMem80(state);
+			break;
+		case DECODE_MEM_FLOATENV:
+			DecodeMemFloatEnv(state);
+			break;
+		case DECODE_MEM_FLOATSAVE:
+			DecodeMemFloatSave(state);
+			break;
+		case DECODE_FPUREG:
+			DecodeFPUReg(state);
+			break;
+		case DECODE_FPUREG_ST0:
+			DecodeFPURegST0(state);
+			break;
+		case DECODE_REGGROUP_NO_OPERANDS:
+			DecodeRegGroupNoOperands(state);
+			break;
+		case DECODE_REGGROUP_AX:
+			DecodeRegGroupAX(state);
+			break;
+		case DECODE_CMPXCH8B:
+			DecodeCmpXch8B(state);
+			break;
+		case DECODE_MOVNTI:
+			DecodeMovNti(state);
+			break;
+		case DECODE_CRC32:
+			DecodeCrc32(state);
+			break;
+		case DECODE_ARPL:
+			DecodeArpl(state);
+			break;
+		default:
+			InvalidDecode(state);
+			break;
+		}
+	}
+#endif
+
+
+	static void FinishDisassemble(DecodeState* state)
+	{
+		state->result->length = state->opcode - state->opcodeStart;
+		if (state->ripRelFixup)
+			*state->ripRelFixup += state->addr + state->result->length;
+		if (state->insufficientLength && (state->origLen < 15))
+			state->result->flags |= X86_FLAG_INSUFFICIENT_LENGTH;
+		SetOperandAccess(state->result);
+	}
+
+
+	static bool ProcessInstructionBody(DecodeState* state)
+	{
+		ProcessOpcode(state, mainOpcodeMap, Read8(state));
+		FinishDisassemble(state);
+		return !state->invalid;
+	}
+
+
+#ifndef __ASMX86DEC_UNCHECKED
+	static void ProcessPrefixes(DecodeState* state)
+	{
+		uint8_t rex = 0;
+		bool addrPrefix = false;
+
+		while (!state->invalid)
+		{
+			uint8_t prefix = Read8(state);
+			if ((prefix >= 0x26) && (prefix <= 0x3e) && ((prefix & 7) == 6))
+			{
+				// Segment prefix
+				state->result->segment = (SegmentRegister)(SEG_ES + ((prefix >> 3) - 4));
+			}
+			else if ((prefix == 0x64) || (prefix == 0x65))
+			{
+				// FS/GS prefix
+				state->result->segment = (SegmentRegister)(SEG_ES + (prefix - 0x60));
+			}
+			else if (prefix == 0x66)
+			{
+				state->opPrefix = true;
+				state->result->flags |= X86_FLAG_OPSIZE;
+			}
+			else if (prefix == 0x67)
+			{
+				addrPrefix = true;
+				state->result->flags |= X86_FLAG_ADDRSIZE;
+			}
+			else if (prefix == 0xf0)
+				state->result->flags |= X86_FLAG_LOCK;
+			else if (prefix == 0xf2)
+				state->rep = REP_PREFIX_REPNE;
+			else if (prefix == 0xf3)
+				state->rep = REP_PREFIX_REPE;
+			else if (__USING64(state) && (prefix >= 0x40) && (prefix <= 0x4f))
+			{
+				// REX prefix
+				rex = prefix;
+				continue;
+			}
+			else
+			{
+				// Not a prefix, continue instruction processing
+				state->opcode--;
+				state->len++;
+				break;
+			}
+
+			// Force ignore REX unless it is the last prefix
+			rex = 0;
+		}
+
+		if (state->opPrefix)
+			state->opSize = (state->opSize == 2) ? 4 : 2;
+		if (addrPrefix)
+			state->addrSize = (state->addrSize == 4) ? 2 : 4;
+
+		if (rex)
+		{
+			// REX prefix found before opcode
+			state->rex = true;
+			state->rexRM1 = (rex & 1) != 0;
+			state->rexRM2 = (rex & 2) != 0;
+			state->rexReg = (rex & 4) != 0;
+			if (rex & 8)
+				state->opSize = 8;
+		}
+	}
+
+
+	static void ClearOperand(InstructionOperand* oper)
+	{
+		oper->operand = NONE;
+		oper->components[0] = NONE;
+		oper->components[1] = NONE;
+		oper->scale = 1;
+		oper->immediate = 0;
+		oper->relative = false;
+	}
+
+
+	static void InitDecodeState(DecodeState* state)
+	{
+		state->result->operation = INVALID;
+		state->result->flags = 0;
+		state->result->segment = SEG_DEFAULT;
+		state->invalid = false;
+		state->insufficientLength = false;
+		state->opPrefix = false;
+		state->rep = REP_PREFIX_NONE;
+		state->ripRelFixup = NULL;
+		state->rex = false;
+		state->rexReg = false;
+		state->rexRM1 = false;
+		state->rexRM2 = false;
+		state->modRM = NULL;
+		state->modRMEnd = NULL;
+		state->origLen = state->len;
+	}
+
+
+	static void InitDisassemble(DecodeState* state)
+	{
+		ClearOperand(&state->result->operands[0]);
+		ClearOperand(&state->result->operands[1]);
+		ClearOperand(&state->result->operands[2]);
+		InitDecodeState(state);
+	}
+
+
+	static bool ProcessInstruction(DecodeState* state)
+	{
+		ProcessPrefixes(state);
+		state->body = state->opcode;
+
+		// Reads can skip the bounds checks if the longest possible instruction body fits in the bytes
+		// that remain after the prefixes
+		if (state->len >= MAX_INSTRUCTION_BODY_LENGTH)
+			return __UNCHECKED(ProcessInstructionBody)(state);
+		return ProcessInstructionBody(state);
+	}
+
+
+	static bool DecodeInstruction(DecodeState* state)
+	{
+		InitDisassemble(state);
+		return ProcessInstruction(state);
+	}
+
+
+	static bool DecodeNextInstruction(DecodeState* state)
+	{
+		// The result still holds the previous instruction decoded by the same decoder context, so
+		// only the operands that were used by that instruction need to be cleared
+		if (state->result->operands[0].operand != NONE)
+			ClearOperand(&state->result->operands[0]);
+		if (state->result->operands[1].operand != NONE)
+			ClearOperand(&state->result->operands[1]);
+		if (state->result->operands[2].operand != NONE)
+			ClearOperand(&state->result->operands[2]);
+		InitDecodeState(state);
+		return ProcessInstruction(state);
+	}
+
+#endif
+
+
+#undef GetByteRegList
+#undef GetRegListForOpSize
+#undef GetRegListForFinalOpSize
+#undef GetRegListForAddrSize
+#undef GetFinalOpSize
+#undef Read8
+#undef Peek8
+#undef ReadModRM
+#undef Read16
+#undef Read32
+#undef Read64
+#undef ReadSigned8
+#undef ReadSigned16
+#undef ReadSigned32
+#undef ReadFinalOpSize
+#undef ReadAddrSize
+#undef ReadSignedFinalOpSize
+#undef UpdateOperationForAddrSize
+#undef ProcessEncoding
+#undef ProcessOpcode
+#undef GetFinalSegment
+#undef SetMemOperand
+#undef DecodeRM
+#undef DecodeRMReg
+#undef SetOperandToEsEdi
+#undef SetOperandToDsEsi
+#undef SetOperandToImmAddr
+#undef SetOperandToEaxFinalOpSize
+#undef SetOperandToOpReg
+#undef SetOperandToImm
+#undef SetOperandToImm8
+#undef SetOperandToImm16
+#undef DecodeSSEPrefix
+#undef GetSizeForSSEType
+#undef GetOperandForSSEEntryType
+#undef GetRegListForSSEEntryType
+#undef GetSizeForSSEEntryType
+#undef UpdateOperationForSSEEntryType
+#undef InvalidDecode
+#undef DecodeTwoByte
+#undef DecodeFpu
+#undef DecodeNoOperands
+#undef DecodeRegRM
+#undef DecodeRegRMImm
+#undef DecodeRMRegImm8
+#undef DecodeRMRegCL
+#undef DecodeEaxImm
+#undef DecodePushPopSeg
+#undef DecodeOpReg
+#undef DecodeEaxOpReg
+#undef DecodeOpRegImm
+#undef DecodeNop
+#undef DecodeImm
+#undef DecodeImm16Imm8
+#undef DecodeEdiDx
+#undef DecodeDxEsi
+#undef DecodeRelImm
+#undef DecodeRelImmAddrSize
+#undef DecodeGroupRM
+#undef DecodeGroupRMImm
+#undef DecodeGroupRMImm8V
+#undef DecodeGroupRMOne
+#undef DecodeGroupRMCl
+#undef DecodeGroupF6F7
+#undef DecodeGroupFF
+#undef DecodeGroup0F00
+#undef DecodeGroup0F01
+#undef DecodeGroup0FAE
+#undef Decode0FB8
+#undef DecodeRMSRegV
+#undef DecodeRM8
+#undef DecodeRMV
+#undef DecodeFarImm
+#undef DecodeEaxAddr
+#undef DecodeEdiEsi
+#undef DecodeEdiEax
+#undef DecodeEaxEsi
+#undef DecodeAlEbxAl
+#undef DecodeEaxImm8
+#undef DecodeEaxDx
+#undef Decode3DNow
+#undef DecodeSSETable
+#undef DecodeSSETableImm8
+#undef DecodeSSETableMem8
+#undef DecodeSSE
+#undef DecodeSSESingle
+#undef DecodeSSEPacked
+#undef DecodeMMX
+#undef DecodeMMXSSEOnly
+#undef DecodeMMXGroup
+#undef DecodePinsrw
+#undef DecodeRegCR
+#undef DecodeMovSXZX8
+#undef DecodeMovSXZX16
+#undef DecodeMem16
+#undef DecodeMem32
+#undef DecodeMem64
+#undef DecodeMem80
+#undef DecodeMemFloatEnv
+#undef DecodeMemFloatSave
+#undef DecodeFPUReg
+#undef DecodeFPURegST0
+#undef DecodeRegGroupNoOperands
+#undef DecodeRegGroupAX
+#undef DecodeCmpXch8B
+#undef DecodeMovNti
+#undef DecodeCrc32
+#undef DecodeArpl
+#undef ProcessPrefixes
+#undef ClearOperand
+#undef InitDecodeState
+#undef InitDisassemble
+#undef FinishDisassemble
+#undef DispatchDecoder
+#undef ProcessInstruction
+#undef ProcessInstructionBody
+#undef DecodeInstruction
+#undef DecodeNextInstruction
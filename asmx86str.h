@@ -1,791 +1,5109 @@
-static const char* operationString[] = {
-	"",
-	"aaa",
-	"aad",
-	"aam",
-	"aas",
-	"add",
-	"adc",
-	"and",
-	"arpl",
-	"blendpd",
-	"blendps",
-	"blendvpd",
-	"blendvps",
-	"bound",
-	"bsf",
-	"bsr",
-	"bswap",
-	"bt",
-	"btc",
-	"btr",
-	"bts",
-	"callf",
-	"call",
-	"clc",
-	"cld",
-	"clflush",
-	"cli",
-	"clts",
-	"cmc",
-	"cmp",
-	"cmpxch16b",
-	"cmpxch8b",
-	"cmpxchg",
-	"cpuid",
-	"crc32",
-	"daa",
-	"das",
-	"dec",
-	"div",
-	"dppd",
-	"dpps",
-	"emms",
-	"enter",
-	"f2xm1",
-	"fabs",
-	"fadd",
-	"faddp",
-	"fbld",
-	"fbstp",
-	"fchs",
-	"fclex",
-	"fcmovb",
-	"fcmovbe",
-	"fcmove",
-	"fcmovnb",
-	"fcmovnbe",
-	"fcmovne",
-	"fcmovnu",
-	"fcmovu",
-	"fcom",
-	"fcomi",
-	"fcomip",
-	"fcomp",
-	"fcompp",
-	"fcos",
-	"fdecstp",
-	"fdisi",
-	"fdiv",
-	"fdivp",
-	"fdivr",
-	"fdivrp",
-	"femms",
-	"feni",
-	"ffree",
-	"ffreep",
-	"fiadd",
-	"ficom",
-	"ficomp",
-	"fidiv",
-	"fidivr",
-	"fild",
-	"fimul",
-	"fincstp",
-	"finit",
-	"fist",
-	"fistp",
-	"fisttp",
-	"fisub",
-	"fisubr",
-	"fld",
-	"fld1",
-	"fldcw",
-	"fldenv",
-	"fldl2e",
-	"fldl2t",
-	"fldlg2",
-	"fldln2",
-	"fldpi",
-	"fldz",
-	"fmul",
-	"fmulp",
-	"fnop",
-	"fpatan",
-	"fprem",
-	"fprem1",
-	"fptan",
-	"frichop",
-	"frinear",
-	"frint2",
-	"frndint",
-	"frstor",
-	"frstpm",
-	"fsave",
-	"fscale",
-	"fsetpm",
-	"fsin",
-	"fsincos",
-	"fsqrt",
-	"fst",
-	"fstcw",
-	"fstdw",
-	"fstenv",
-	"fstp",
-	"fstsg",
-	"fstsw",
-	"fsub",
-	"fsubp",
-	"fsubr",
-	"fsubrp",
-	"ftst",
-	"fucom",
-	"fucomi",
-	"fucomip",
-	"fucomp",
-	"fucompp",
-	"fwait",
-	"fxam",
-	"fxch",
-	"fxrstor",
-	"fxsave",
-	"fxtract",
-	"fyl2x",
-	"fyl2xp1",
-	"getsec",
-	"hlt",
-	"idiv",
-	"imul",
-	"in",
-	"inc",
-	"int",
-	"int1",
-	"int3",
-	"into",
-	"invd",
-	"invlpg",
-	"iret",
-	"jmpf",
-	"jmp",
-	"lahf",
-	"lar",
-	"ldmxcsr",
-	"lds",
-	"lea",
-	"leave",
-	"les",
-	"lfence",
-	"lfs",
-	"lgs",
-	"loop",
-	"loope",
-	"loopne",
-	"lsl",
-	"lss",
-	"mfence",
-	"mov",
-	"movnti",
-	"movss",
-	"movsx",
-	"movsxd",
-	"movupd",
-	"movups",
-	"movzx",
-	"mpsadbw",
-	"mul",
-	"neg",
-	"nop",
-	"not",
-	"or",
-	"out",
-	"packssdw",
-	"packsswb",
-	"packusdw",
-	"packuswb",
-	"pabsb",
-	"pabsd",
-	"pabsw",
-	"paddb",
-	"paddd",
-	"paddq",
-	"paddw",
-	"paddsb",
-	"paddsw",
-	"paddusb",
-	"paddusw",
-	"palignr",
-	"pand",
-	"pandn",
-	"pause",
-	"pavgb",
-	"pavgusb",
-	"pavgw",
-	"pblendvb",
-	"pblendw",
-	"pcmpeqb",
-	"pcmpeqd",
-	"pcmpeqq",
-	"pcmpeqw",
-	"pcmpestri",
-	"pcmpestrm",
-	"pcmpgtb",
-	"pcmpgtd",
-	"pcmpgtq",
-	"pcmpgtw",
-	"pcmpistri",
-	"pcmpistrm",
-	"pf2id",
-	"pf2iw",
-	"pfacc",
-	"pfadd",
-	"pfcmpeq",
-	"pfcmpge",
-	"pfcmpgt",
-	"pfmax",
-	"pfmin",
-	"pfmul",
-	"pfnacc",
-	"pfpnacc",
-	"pfrcp",
-	"pfrcpit1",
-	"pfrcpit2",
-	"pfrcpv",
-	"pfrsqit1",
-	"pfrsqrt",
-	"pfrsqrtv",
-	"pfsub",
-	"pfsubr",
-	"phaddd",
-	"phaddsw",
-	"phaddw",
-	"phminposuw",
-	"phsubd",
-	"phsubsw",
-	"phsubw",
-	"pi2fd",
-	"pi2fw",
-	"pmaddwd",
-	"pmaddubsw",
-	"pmaxsb",
-	"pmaxsd",
-	"pmaxsw",
-	"pmaxub",
-	"pmaxud",
-	"pmaxuw",
-	"pminsb",
-	"pminsd",
-	"pminsw",
-	"pminub",
-	"pminud",
-	"pminuw",
-	"pmuldq",
-	"pmulhrsw",
-	"pmulhrw",
-	"pmulhuw",
-	"pmulhw",
-	"pmulld",
-	"pmullw",
-	"pmuludq",
-	"pop",
-	"popcnt",
-	"por",
-	"psadbw",
-	"pshufb",
-	"psignb",
-	"psignd",
-	"psignw",
-	"pslld",
-	"pslldq",
-	"psllq",
-	"psllw",
-	"psrad",
-	"psraw",
-	"psrld",
-	"psrldq",
-	"psrlq",
-	"psrlw",
-	"psubb",
-	"psubd",
-	"psubq",
-	"psubw",
-	"psubsb",
-	"psubsw",
-	"psubusb",
-	"psubusw",
-	"pswapd",
-	"ptest",
-	"punpckhbw",
-	"punpckhdq",
-	"punpckhqdq",
-	"punpckhwd",
-	"punpcklqdq",
-	"push",
-	"pxor",
-	"rdmsr",
-	"rdpmc",
-	"rdtsc",
-	"retf",
-	"retn",
-	"rcl",
-	"rcr",
-	"rol",
-	"ror",
-	"roundps",
-	"roundpd",
-	"rsm",
-	"sahf",
-	"salc",
-	"sar",
-	"sbb",
-	"sfence",
-	"shl",
-	"shld",
-	"shr",
-	"shrd",
-	"sub",
-	"stc",
-	"std",
-	"sti",
-	"stmxcsr",
-	"syscall",
-	"sysenter",
-	"sysexit",
-	"sysret",
-	"test",
-	"ud2",
-	"vmread",
-	"vmwrite",
-	"wbinvd",
-	"wrmsr",
-	"xchg",
-	"xlat",
-	"xadd",
-	"xor",
-	"xrstor",
-	"xsave",
-	"addps",
-	"addpd",
-	"addsd",
-	"addss",
-	"addsubpd",
-	"addsubps",
-	"andnps",
-	"andnpd",
-	"andps",
-	"andpd",
-	"cbw",
-	"cwde",
-	"cdqe",
-	"cmpsb",
-	"cmpsw",
-	"cmpsd",
-	"cmpsq",
-	"cmovo",
-	"cmovno",
-	"cmovb",
-	"cmovae",
-	"cmove",
-	"cmovne",
-	"cmovbe",
-	"cmova",
-	"cmovs",
-	"cmovns",
-	"cmovpe",
-	"cmovpo",
-	"cmovl",
-	"cmovge",
-	"cmovle",
-	"cmovg",
-	"cwd",
-	"cdq",
-	"cqo",
-	"divps",
-	"divpd",
-	"divsd",
-	"divss",
-	"insb",
-	"insw",
-	"insd",
-	"insq",
-	"jcxz",
-	"jecxz",
-	"jrcxz",
-	"jo",
-	"jno",
-	"jb",
-	"jae",
-	"je",
-	"jne",
-	"jbe",
-	"ja",
-	"js",
-	"jns",
-	"jpe",
-	"jpo",
-	"jl",
-	"jge",
-	"jle",
-	"jg",
-	"lodsb",
-	"lodsw",
-	"lodsd",
-	"lodsq",
-	"maxps",
-	"maxpd",
-	"maxsd",
-	"maxss",
-	"minps",
-	"minpd",
-	"minsd",
-	"minss",
-	"movd",
-	"movq",
-	"movsb",
-	"movsw",
-	"movsd",
-	"movsq",
-	"mulps",
-	"mulpd",
-	"mulsd",
-	"mulss",
-	"orps",
-	"orpd",
-	"outsb",
-	"outsw",
-	"outsd",
-	"outsq",
-	"pextrd",
-	"pextrq",
-	"pinsrd",
-	"pinsrq",
-	"popa",
-	"popad",
-	"popf",
-	"popfd",
-	"popfq",
-	"pusha",
-	"pushad",
-	"pushf",
-	"pushfd",
-	"pushfq",
-	"rcpps",
-	"rcpss",
-	"rsqrtps",
-	"rsqrtss",
-	"scasb",
-	"scasw",
-	"scasd",
-	"scasq",
-	"seto",
-	"setno",
-	"setb",
-	"setae",
-	"sete",
-	"setne",
-	"setbe",
-	"seta",
-	"sets",
-	"setns",
-	"setpe",
-	"setpo",
-	"setl",
-	"setge",
-	"setle",
-	"setg",
-	"sqrtps",
-	"sqrtpd",
-	"sqrtsd",
-	"sqrtss",
-	"stosb",
-	"stosw",
-	"stosd",
-	"stosq",
-	"subps",
-	"subpd",
-	"subsd",
-	"subss",
-	"xorps",
-	"xorpd",
-	"cmppd",
-	"cmpps",
-	"cmpss",
-	"comisd",
-	"comiss",
-	"cvtdq2pd",
-	"cvtdq2ps",
-	"cvtpd2dq",
-	"cvtpd2pi",
-	"cvtpd2ps",
-	"cvtpi2pd",
-	"cvtpi2ps",
-	"cvtps2dq",
-	"cvtps2pd",
-	"cvtps2pi",
-	"cvtsd2si",
-	"cvtsd2ss",
-	"cvtsi2sd",
-	"cvtsi2ss",
-	"cvtss2sd",
-	"cvtss2si",
-	"cvttpd2dq",
-	"cvttpd2pi",
-	"cvttps2dq",
-	"cvttps2pi",
-	"cvttsd2si",
-	"cvttss2si",
-	"extractps",
-	"haddpd",
-	"haddps",
-	"hsubpd",
-	"hsubps",
-	"insertps",
-	"lddqu",
-	"lgdt",
-	"lidt",
-	"lldt",
-	"lmsw",
-	"ltr",
-	"maskmovq",
-	"maskmovdqu",
-	"mmxnop",
-	"monitor",
-	"movapd",
-	"movaps",
-	"movddup",
-	"movdq2q",
-	"movdqa",
-	"movdqu",
-	"movhlps",
-	"movhpd",
-	"movhps",
-	"movshdup",
-	"movsldup",
-	"movlhps",
-	"movlpd",
-	"movlps",
-	"movmskpd",
-	"movmskps",
-	"movntdq",
-	"movntdqa",
-	"movntpd",
-	"movntps",
-	"movntq",
-	"movq2dq",
-	"mwait",
-	"pinsrb",
-	"pinsrw",
-	"pextrb",
-	"pextrw",
-	"pmovmskb",
-	"pmovsxbd",
-	"pmovsxbq",
-	"pmovsxdq",
-	"pmovsxbw",
-	"pmovsxwd",
-	"pmovsxwq",
-	"pmovzxbd",
-	"pmovzxbq",
-	"pmovzxdq",
-	"pmovzxbw",
-	"pmovzxwd",
-	"pmovzxwq",
-	"prefetch",
-	"prefetchnta",
-	"prefetcht0",
-	"prefetcht1",
-	"prefetcht2",
-	"prefetchw",
-	"pshufd",
-	"pshufhw",
-	"pshuflw",
-	"pshufw",
-	"punpcklbw",
-	"punpckldq",
-	"punpcklwd",
-	"roundsd",
-	"roundss",
-	"sgdt",
-	"sidt",
-	"sldt",
-	"shufpd",
-	"shufps",
-	"smsw",
-	"str",
-	"swapgs",
-	"ucomisd",
-	"ucomiss",
-	"unpckhpd",
-	"unpckhps",
-	"unpcklpd",
-	"unpcklps",
-	"verr",
-	"verw",
-	"vmcall",
-	"vmclear",
-	"vmlaunch",
-	"vmptrld",
-	"vmptrst",
-	"vmresume",
-	"vmxoff",
-	"vmxon",
-	"xgetbv",
-	"xsetbv",
-	"clac",
-	"stac",
-	"encls",
-	"vmfunc",
-	"xend",
-	"xtext",
-	"enclu",
+static const char operationStringData[] =
+	"aaa"
+	"aad"
+	"aam"
+	"aas"
+	"add"
+	"adc"
+	"and"
+	"arpl"
+	"blendpd"
+	"blendps"
+	"blendvpd"
+	"blendvps"
+	"bound"
+	"bsf"
+	"bsr"
+	"bswap"
+	"bt"
+	"btc"
+	"btr"
+	"bts"
+	"callf"
+	"call"
+	"clc"
+	"cld"
+	"clflush"
+	"cli"
+	"clts"
+	"cmc"
+	"cmp"
+	"cmpxch16b"
+	"cmpxch8b"
+	"cmpxchg"
+	"cpuid"
+	"crc32"
+	"daa"
+	"das"
+	"dec"
+	"div"
+	"dppd"
+	"dpps"
+	"emms"
+	"enter"
+	"f2xm1"
+	"fabs"
+	"fadd"
+	"faddp"
+	"fbld"
+	"fbstp"
+	"fchs"
+	"fclex"
+	"fcmovb"
+	"fcmovbe"
+	"fcmove"
+	"fcmovnb"
+	"fcmovnbe"
+	"fcmovne"
+	"fcmovnu"
+	"fcmovu"
+	"fcom"
+	"fcomi"
+	"fcomip"
+	"fcomp"
+	"fcompp"
+	"fcos"
+	"fdecstp"
+	"fdisi"
+	"fdiv"
+	"fdivp"
+	"fdivr"
+	"fdivrp"
+	"femms"
+	"feni"
+	"ffree"
+	"ffreep"
+	"fiadd"
+	"ficom"
+	"ficomp"
+	"fidiv"
+	"fidivr"
+	"fild"
+	"fimul"
+	"fincstp"
+	"finit"
+	"fist"
+	"fistp"
+	"fisttp"
+	"fisub"
+	"fisubr"
+	"fld"
+	"fld1"
+	"fldcw"
+	"fldenv"
+	"fldl2e"
+	"fldl2t"
+	"fldlg2"
+	"fldln2"
+	"fldpi"
+	"fldz"
+	"fmul"
+	"fmulp"
+	"fnop"
+	"fpatan"
+	"fprem"
+	"fprem1"
+	"fptan"
+	"frichop"
+	"frinear"
+	"frint2"
+	"frndint"
+	"frstor"
+	"frstpm"
+	"fsave"
+	"fscale"
+	"fsetpm"
+	"fsin"
+	"fsincos"
+	"fsqrt"
+	"fst"
+	"fstcw"
+	"fstdw"
+	"fstenv"
+	"fstp"
+	"fstsg"
+	"fstsw"
+	"fsub"
+	"fsubp"
+	"fsubr"
+	"fsubrp"
+	"ftst"
+	"fucom"
+	"fucomi"
+	"fucomip"
+	"fucomp"
+	"fucompp"
+	"fwait"
+	"fxam"
+	"fxch"
+	"fxrstor"
+	"fxsave"
+	"fxtract"
+	"fyl2x"
+	"fyl2xp1"
+	"getsec"
+	"hlt"
+	"idiv"
+	"imul"
+	"in"
+	"inc"
+	"int"
+	"int1"
+	"int3"
+	"into"
+	"invd"
+	"invlpg"
+	"iret"
+	"jmpf"
+	"jmp"
+	"lahf"
+	"lar"
+	"ldmxcsr"
+	"lds"
+	"lea"
+	"leave"
+	"les"
+	"lfence"
+	"lfs"
+	"lgs"
+	"loop"
+	"loope"
+	"loopne"
+	"lsl"
+	"lss"
+	"mfence"
+	"mov"
+	"movnti"
+	"movss"
+	"movsx"
+	"movsxd"
+	"movupd"
+	"movups"
+	"movzx"
+	"mpsadbw"
+	"mul"
+	"neg"
+	"nop"
+	"not"
+	"or"
+	"out"
+	"packssdw"
+	"packsswb"
+	"packusdw"
+	"packuswb"
+	"pabsb"
+	"pabsd"
+	"pabsw"
+	"paddb"
+	"paddd"
+	"paddq"
+	"paddw"
+	"paddsb"
+	"paddsw"
+	"paddusb"
+	"paddusw"
+	"palignr"
+	"pand"
+	"pandn"
+	"pause"
+	"pavgb"
+	"pavgusb"
+	"pavgw"
+	"pblendvb"
+	"pblendw"
+	"pcmpeqb"
+	"pcmpeqd"
+	"pcmpeqq"
+	"pcmpeqw"
+	"pcmpestri"
+	"pcmpestrm"
+	"pcmpgtb"
+	"pcmpgtd"
+	"pcmpgtq"
+	"pcmpgtw"
+	"pcmpistri"
+	"pcmpistrm"
+	"pf2id"
+	"pf2iw"
+	"pfacc"
+	"pfadd"
+	"pfcmpeq"
+	"pfcmpge"
+	"pfcmpgt"
+	"pfmax"
+	"pfmin"
+	"pfmul"
+	"pfnacc"
+	"pfpnacc"
+	"pfrcp"
+	"pfrcpit1"
+	"pfrcpit2"
+	"pfrcpv"
+	"pfrsqit1"
+	"pfrsqrt"
+	"pfrsqrtv"
+	"pfsub"
+	"pfsubr"
+	"phaddd"
+	"phaddsw"
+	"phaddw"
+	"phminposuw"
+	"phsubd"
+	"phsubsw"
+	"phsubw"
+	"pi2fd"
+	"pi2fw"
+	"pmaddwd"
+	"pmaddubsw"
+	"pmaxsb"
+	"pmaxsd"
+	"pmaxsw"
+	"pmaxub"
+	"pmaxud"
+	"pmaxuw"
+	"pminsb"
+	"pminsd"
+	"pminsw"
+	"pminub"
+	"pminud"
+	"pminuw"
+	"pmuldq"
+	"pmulhrsw"
+	"pmulhrw"
+	"pmulhuw"
+	"pmulhw"
+	"pmulld"
+	"pmullw"
+	"pmuludq"
+	"pop"
+	"popcnt"
+	"por"
+	"psadbw"
+	"pshufb"
+	"psignb"
+	"psignd"
+	"psignw"
+	"pslld"
+	"pslldq"
+	"psllq"
+	"psllw"
+	"psrad"
+	"psraw"
+	"psrld"
+	"psrldq"
+	"psrlq"
+	"psrlw"
+	"psubb"
+	"psubd"
+	"psubq"
+	"psubw"
+	"psubsb"
+	"psubsw"
+	"psubusb"
+	"psubusw"
+	"pswapd"
+	"ptest"
+	"punpckhbw"
+	"punpckhdq"
+	"punpckhqdq"
+	"punpckhwd"
+	"punpcklqdq"
+	"push"
+	"pxor"
+	"rdmsr"
+	"rdpmc"
+	"rdtsc"
+	"retf"
+	"retn"
+	"rcl"
+	"rcr"
+	"rol"
+	"ror"
+	"roundps"
+	"roundpd"
+	"rsm"
+	"sahf"
+	"salc"
+	"sar"
+	"sbb"
+	"sfence"
+	"shl"
+	"shld"
+	"shr"
+	"shrd"
+	"sub"
+	"stc"
+	"std"
+	"sti"
+	"stmxcsr"
+	"syscall"
+	"sysenter"
+	"sysexit"
+	"sysret"
+	"test"
+	"ud2"
+	"vmread"
+	"vmwrite"
+	"wbinvd"
+	"wrmsr"
+	"xchg"
+	"xlat"
+	"xadd"
+	"xor"
+	"xrstor"
+	"xsave"
+	"addps"
+	"addpd"
+	"addsd"
+	"addss"
+	"addsubpd"
+	"addsubps"
+	"andnps"
+	"andnpd"
+	"andps"
+	"andpd"
+	"cbw"
+	"cwde"
+	"cdqe"
+	"cmpsb"
+	"cmpsw"
+	"cmpsd"
+	"cmpsq"
+	"cmovo"
+	"cmovno"
+	"cmovb"
+	"cmovae"
+	"cmove"
+	"cmovne"
+	"cmovbe"
+	"cmova"
+	"cmovs"
+	"cmovns"
+	"cmovpe"
+	"cmovpo"
+	"cmovl"
+	"cmovge"
+	"cmovle"
+	"cmovg"
+	"cwd"
+	"cdq"
+	"cqo"
+	"divps"
+	"divpd"
+	"divsd"
+	"divss"
+	"insb"
+	"insw"
+	"insd"
+	"insq"
+	"jcxz"
+	"jecxz"
+	"jrcxz"
+	"jo"
+	"jno"
+	"jb"
+	"jae"
+	"je"
+	"jne"
+	"jbe"
+	"ja"
+	"js"
+	"jns"
+	"jpe"
+	"jpo"
+	"jl"
+	"jge"
+	"jle"
+	"jg"
+	"lodsb"
+	"lodsw"
+	"lodsd"
+	"lodsq"
+	"maxps"
+	"maxpd"
+	"maxsd"
+	"maxss"
+	"minps"
+	"minpd"
+	"minsd"
+	"minss"
+	"movd"
+	"movq"
+	"movsb"
+	"movsw"
+	"movsd"
+	"movsq"
+	"mulps"
+	"mulpd"
+	"mulsd"
+	"mulss"
+	"orps"
+	"orpd"
+	"outsb"
+	"outsw"
+	"outsd"
+	"outsq"
+	"pextrd"
+	"pextrq"
+	"pinsrd"
+	"pinsrq"
+	"popa"
+	"popad"
+	"popf"
+	"popfd"
+	"popfq"
+	"pusha"
+	"pushad"
+	"pushf"
+	"pushfd"
+	"pushfq"
+	"rcpps"
+	"rcpss"
+	"rsqrtps"
+	"rsqrtss"
+	"scasb"
+	"scasw"
+	"scasd"
+	"scasq"
+	"seto"
+	"setno"
+	"setb"
+	"setae"
+	"sete"
+	"setne"
+	"setbe"
+	"seta"
+	"sets"
+	"setns"
+	"setpe"
+	"setpo"
+	"setl"
+	"setge"
+	"setle"
+	"setg"
+	"sqrtps"
+	"sqrtpd"
+	"sqrtsd"
+	"sqrtss"
+	"stosb"
+	"stosw"
+	"stosd"
+	"stosq"
+	"subps"
+	"subpd"
+	"subsd"
+	"subss"
+	"xorps"
+	"xorpd"
+	"cmppd"
+	"cmpps"
+	"cmpss"
+	"comisd"
+	"comiss"
+	"cvtdq2pd"
+	"cvtdq2ps"
+	"cvtpd2dq"
+	"cvtpd2pi"
+	"cvtpd2ps"
+	"cvtpi2pd"
+	"cvtpi2ps"
+	"cvtps2dq"
+	"cvtps2pd"
+	"cvtps2pi"
+	"cvtsd2si"
+	"cvtsd2ss"
+	"cvtsi2sd"
+	"cvtsi2ss"
+	"cvtss2sd"
+	"cvtss2si"
+	"cvttpd2dq"
+	"cvttpd2pi"
+	"cvttps2dq"
+	"cvttps2pi"
+	"cvttsd2si"
+	"cvttss2si"
+	"extractps"
+	"haddpd"
+	"haddps"
+	"hsubpd"
+	"hsubps"
+	"insertps"
+	"lddqu"
+	"lgdt"
+	"lidt"
+	"lldt"
+	"lmsw"
+	"ltr"
+	"maskmovq"
+	"maskmovdqu"
+	"mmxnop"
+	"monitor"
+	"movapd"
+	"movaps"
+	"movddup"
+	"movdq2q"
+	"movdqa"
+	"movdqu"
+	"movhlps"
+	"movhpd"
+	"movhps"
+	"movshdup"
+	"movsldup"
+	"movlhps"
+	"movlpd"
+	"movlps"
+	"movmskpd"
+	"movmskps"
+	"movntdq"
+	"movntdqa"
+	"movntpd"
+	"movntps"
+	"movntq"
+	"movq2dq"
+	"mwait"
+	"pinsrb"
+	"pinsrw"
+	"pextrb"
+	"pextrw"
+	"pmovmskb"
+	"pmovsxbd"
+	"pmovsxbq"
+	"pmovsxdq"
+	"pmovsxbw"
+	"pmovsxwd"
+	"pmovsxwq"
+	"pmovzxbd"
+	"pmovzxbq"
+	"pmovzxdq"
+	"pmovzxbw"
+	"pmovzxwd"
+	"pmovzxwq"
+	"prefetch"
+	"prefetchnta"
+	"prefetcht0"
+	"prefetcht1"
+	"prefetcht2"
+	"prefetchw"
+	"pshufd"
+	"pshufhw"
+	"pshuflw"
+	"pshufw"
+	"punpcklbw"
+	"punpckldq"
+	"punpcklwd"
+	"roundsd"
+	"roundss"
+	"sgdt"
+	"sidt"
+	"sldt"
+	"shufpd"
+	"shufps"
+	"smsw"
+	"str"
+	"swapgs"
+	"ucomisd"
+	"ucomiss"
+	"unpckhpd"
+	"unpckhps"
+	"unpcklpd"
+	"unpcklps"
+	"verr"
+	"verw"
+	"vmcall"
+	"vmclear"
+	"vmlaunch"
+	"vmptrld"
+	"vmptrst"
+	"vmresume"
+	"vmxoff"
+	"vmxon"
+	"xgetbv"
+	"xsetbv"
+	"clac"
+	"stac"
+	"encls"
+	"vmfunc"
+	"xend"
+	"xtext"
+	"enclu"
 	"rdtscp"
+;
+static const uint16_t operationStringOffset[] = {
+	0,
+	0,
+	3,
+	6,
+	9,
+	12,
+	15,
+	18,
+	21,
+	25,
+	32,
+	39,
+	47,
+	55,
+	60,
+	63,
+	66,
+	71,
+	73,
+	76,
+	79,
+	82,
+	87,
+	91,
+	94,
+	97,
+	104,
+	107,
+	111,
+	114,
+	117,
+	126,
+	134,
+	141,
+	146,
+	151,
+	154,
+	157,
+	160,
+	163,
+	167,
+	171,
+	175,
+	180,
+	185,
+	189,
+	193,
+	198,
+	202,
+	207,
+	211,
+	216,
+	222,
+	229,
+	235,
+	242,
+	250,
+	257,
+	264,
+	270,
+	274,
+	279,
+	285,
+	290,
+	296,
+	300,
+	307,
+	312,
+	316,
+	321,
+	326,
+	332,
+	337,
+	341,
+	346,
+	352,
+	357,
+	362,
+	368,
+	373,
+	379,
+	383,
+	388,
+	395,
+	400,
+	404,
+	409,
+	415,
+	420,
+	426,
+	429,
+	433,
+	438,
+	444,
+	450,
+	456,
+	462,
+	468,
+	473,
+	477,
+	481,
+	486,
+	490,
+	496,
+	501,
+	507,
+	512,
+	519,
+	526,
+	532,
+	539,
+	545,
+	551,
+	556,
+	562,
+	568,
+	572,
+	579,
+	584,
+	587,
+	592,
+	597,
+	603,
+	607,
+	612,
+	617,
+	621,
+	626,
+	631,
+	637,
+	641,
+	646,
+	652,
+	659,
+	665,
+	672,
+	677,
+	681,
+	685,
+	692,
+	698,
+	705,
+	710,
+	717,
+	723,
+	726,
+	730,
+	734,
+	736,
+	739,
+	742,
+	746,
+	750,
+	754,
+	758,
+	764,
+	768,
+	772,
+	775,
+	779,
+	782,
+	789,
+	792,
+	795,
+	800,
+	803,
+	809,
+	812,
+	815,
+	819,
+	824,
+	830,
+	833,
+	836,
+	842,
+	845,
+	851,
+	856,
+	861,
+	867,
+	873,
+	879,
+	884,
+	891,
+	894,
+	897,
+	900,
+	903,
+	905,
+	908,
+	916,
+	924,
+	932,
+	940,
+	945,
+	950,
+	955,
+	960,
+	965,
+	970,
+	975,
+	981,
+	987,
+	994,
+	1001,
+	1008,
+	1012,
+	1017,
+	1022,
+	1027,
+	1034,
+	1039,
+	1047,
+	1054,
+	1061,
+	1068,
+	1075,
+	1082,
+	1091,
+	1100,
+	1107,
+	1114,
+	1121,
+	1128,
+	1137,
+	1146,
+	1151,
+	1156,
+	1161,
+	1166,
+	1173,
+	1180,
+	1187,
+	1192,
+	1197,
+	1202,
+	1208,
+	1215,
+	1220,
+	1228,
+	1236,
+	1242,
+	1250,
+	1257,
+	1265,
+	1270,
+	1276,
+	1282,
+	1289,
+	1295,
+	1305,
+	1311,
+	1318,
+	1324,
+	1329,
+	1334,
+	1341,
+	1350,
+	1356,
+	1362,
+	1368,
+	1374,
+	1380,
+	1386,
+	1392,
+	1398,
+	1404,
+	1410,
+	1416,
+	1422,
+	1428,
+	1436,
+	1443,
+	1450,
+	1456,
+	1462,
+	1468,
+	1475,
+	1478,
+	1484,
+	1487,
+	1493,
+	1499,
+	1505,
+	1511,
+	1517,
+	1522,
+	1528,
+	1533,
+	1538,
+	1543,
+	1548,
+	1553,
+	1559,
+	1564,
+	1569,
+	1574,
+	1579,
+	1584,
+	1589,
+	1595,
+	1601,
+	1608,
+	1615,
+	1621,
+	1626,
+	1635,
+	1644,
+	1654,
+	1663,
+	1673,
+	1677,
+	1681,
+	1686,
+	1691,
+	1696,
+	1700,
+	1704,
+	1707,
+	1710,
+	1713,
+	1716,
+	1723,
+	1730,
+	1733,
+	1737,
+	1741,
+	1744,
+	1747,
+	1753,
+	1756,
+	1760,
+	1763,
+	1767,
+	1770,
+	1773,
+	1776,
+	1779,
+	1786,
+	1793,
+	1801,
+	1808,
+	1814,
+	1818,
+	1821,
+	1827,
+	1834,
+	1840,
+	1845,
+	1849,
+	1853,
+	1857,
+	1860,
+	1866,
+	1871,
+	1876,
+	1881,
+	1886,
+	1891,
+	1899,
+	1907,
+	1913,
+	1919,
+	1924,
+	1929,
+	1932,
+	1936,
+	1940,
+	1945,
+	1950,
+	1955,
+	1960,
+	1965,
+	1971,
+	1976,
+	1982,
+	1987,
+	1993,
+	1999,
+	2004,
+	2009,
+	2015,
+	2021,
+	2027,
+	2032,
+	2038,
+	2044,
+	2049,
+	2052,
+	2055,
+	2058,
+	2063,
+	2068,
+	2073,
+	2078,
+	2082,
+	2086,
+	2090,
+	2094,
+	2098,
+	2103,
+	2108,
+	2110,
+	2113,
+	2115,
+	2118,
+	2120,
+	2123,
+	2126,
+	2128,
+	2130,
+	2133,
+	2136,
+	2139,
+	2141,
+	2144,
+	2147,
+	2149,
+	2154,
+	2159,
+	2164,
+	2169,
+	2174,
+	2179,
+	2184,
+	2189,
+	2194,
+	2199,
+	2204,
+	2209,
+	2213,
+	2217,
+	2222,
+	2227,
+	2232,
+	2237,
+	2242,
+	2247,
+	2252,
+	2257,
+	2261,
+	2265,
+	2270,
+	2275,
+	2280,
+	2285,
+	2291,
+	2297,
+	2303,
+	2309,
+	2313,
+	2318,
+	2322,
+	2327,
+	2332,
+	2337,
+	2343,
+	2348,
+	2354,
+	2360,
+	2365,
+	2370,
+	2377,
+	2384,
+	2389,
+	2394,
+	2399,
+	2404,
+	2408,
+	2413,
+	2417,
+	2422,
+	2426,
+	2431,
+	2436,
+	2440,
+	2444,
+	2449,
+	2454,
+	2459,
+	2463,
+	2468,
+	2473,
+	2477,
+	2483,
+	2489,
+	2495,
+	2501,
+	2506,
+	2511,
+	2516,
+	2521,
+	2526,
+	2531,
+	2536,
+	2541,
+	2546,
+	2551,
+	2556,
+	2561,
+	2566,
+	2572,
+	2578,
+	2586,
+	2594,
+	2602,
+	2610,
+	2618,
+	2626,
+	2634,
+	2642,
+	2650,
+	2658,
+	2666,
+	2674,
+	2682,
+	2690,
+	2698,
+	2706,
+	2715,
+	2724,
+	2733,
+	2742,
+	2751,
+	2760,
+	2769,
+	2775,
+	2781,
+	2787,
+	2793,
+	2801,
+	2806,
+	2810,
+	2814,
+	2818,
+	2822,
+	2825,
+	2833,
+	2843,
+	2849,
+	2856,
+	2862,
+	2868,
+	2875,
+	2882,
+	2888,
+	2894,
+	2901,
+	2907,
+	2913,
+	2921,
+	2929,
+	2936,
+	2942,
+	2948,
+	2956,
+	2964,
+	2971,
+	2979,
+	2986,
+	2993,
+	2999,
+	3006,
+	3011,
+	3017,
+	3023,
+	3029,
+	3035,
+	3043,
+	3051,
+	3059,
+	3067,
+	3075,
+	3083,
+	3091,
+	3099,
+	3107,
+	3115,
+	3123,
+	3131,
+	3139,
+	3147,
+	3158,
+	3168,
+	3178,
+	3188,
+	3197,
+	3203,
+	3210,
+	3217,
+	3223,
+	3232,
+	3241,
+	3250,
+	3257,
+	3264,
+	3268,
+	3272,
+	3276,
+	3282,
+	3288,
+	3292,
+	3295,
+	3301,
+	3308,
+	3315,
+	3323,
+	3331,
+	3339,
+	3347,
+	3351,
+	3355,
+	3361,
+	3368,
+	3376,
+	3383,
+	3390,
+	3398,
+	3404,
+	3409,
+	3415,
+	3421,
+	3425,
+	3429,
+	3434,
+	3440,
+	3444,
+	3449,
+	3454
 };
-static const char* operandString[] = {
-	"",
-	"",
-	"",
-	"al",
-	"cl",
-	"dl",
-	"bl",
-	"ah",
-	"ch",
-	"dh",
-	"bh",
-	"spl",
-	"bpl",
-	"sil",
-	"dil",
-	"r8b",
-	"r9b",
-	"r10b",
-	"r11b",
-	"r12b",
-	"r13b",
-	"r14b",
-	"r15b",
-	"ax",
-	"cx",
-	"dx",
-	"bx",
-	"sp",
-	"bp",
-	"si",
-	"di",
-	"r8w",
-	"r9w",
-	"r10w",
-	"r11w",
-	"r12w",
-	"r13w",
-	"r14w",
-	"r15w",
-	"eax",
-	"ecx",
-	"edx",
-	"ebx",
-	"esp",
-	"ebp",
-	"esi",
-	"edi",
-	"r8d",
-	"r9d",
-	"r10d",
-	"r11d",
-	"r12d",
-	"r13d",
-	"r14d",
-	"r15d",
-	"rax",
-	"rcx",
-	"rdx",
-	"rbx",
-	"rsp",
-	"rbp",
-	"rsi",
-	"rdi",
-	"r8",
-	"r9",
-	"r10",
-	"r11",
-	"r12",
-	"r13",
-	"r14",
-	"r15",
-	"st0",
-	"st1",
-	"st2",
-	"st3",
-	"st4",
-	"st5",
-	"st6",
-	"st7",
-	"mm0",
-	"mm1",
-	"mm2",
-	"mm3",
-	"mm4",
-	"mm5",
-	"mm6",
-	"mm7",
-	"xmm0",
-	"xmm1",
-	"xmm2",
-	"xmm3",
-	"xmm4",
-	"xmm5",
-	"xmm6",
-	"xmm7",
-	"xmm8",
-	"xmm9",
-	"xmm10",
-	"xmm11",
-	"xmm12",
-	"xmm13",
-	"xmm14",
-	"xmm15",
-	"cr0",
-	"cr1",
-	"cr2",
-	"cr3",
-	"cr4",
-	"cr5",
-	"cr6",
-	"cr7",
-	"cr8",
-	"cr9",
-	"cr10",
-	"cr11",
-	"cr12",
-	"cr13",
-	"cr14",
-	"cr15",
-	"dr0",
-	"dr1",
-	"dr2",
-	"dr3",
-	"dr4",
-	"dr5",
-	"dr6",
-	"dr7",
-	"dr8",
-	"dr9",
-	"dr10",
-	"dr11",
-	"dr12",
-	"dr13",
-	"dr14",
-	"dr15",
-	"tr0",
-	"tr1",
-	"tr2",
-	"tr3",
-	"tr4",
-	"tr5",
-	"tr6",
-	"tr7",
-	"tr8",
-	"tr9",
-	"tr10",
-	"tr11",
-	"tr12",
-	"tr13",
-	"tr14",
-	"tr15",
-	"es",
-	"cs",
-	"ss",
-	"ds",
-	"fs",
-	"gs",
+static const uint8_t operationStringLength[] = {
+	0,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	4,
+	7,
+	7,
+	8,
+	8,
+	5,
+	3,
+	3,
+	5,
+	2,
+	3,
+	3,
+	3,
+	5,
+	4,
+	3,
+	3,
+	7,
+	3,
+	4,
+	3,
+	3,
+	9,
+	8,
+	7,
+	5,
+	5,
+	3,
+	3,
+	3,
+	3,
+	4,
+	4,
+	4,
+	5,
+	5,
+	4,
+	4,
+	5,
+	4,
+	5,
+	4,
+	5,
+	6,
+	7,
+	6,
+	7,
+	8,
+	7,
+	7,
+	6,
+	4,
+	5,
+	6,
+	5,
+	6,
+	4,
+	7,
+	5,
+	4,
+	5,
+	5,
+	6,
+	5,
+	4,
+	5,
+	6,
+	5,
+	5,
+	6,
+	5,
+	6,
+	4,
+	5,
+	7,
+	5,
+	4,
+	5,
+	6,
+	5,
+	6,
+	3,
+	4,
+	5,
+	6,
+	6,
+	6,
+	6,
+	6,
+	5,
+	4,
+	4,
+	5,
+	4,
+	6,
+	5,
+	6,
+	5,
+	7,
+	7,
+	6,
+	7,
+	6,
+	6,
+	5,
+	6,
+	6,
+	4,
+	7,
+	5,
+	3,
+	5,
+	5,
+	6,
+	4,
+	5,
+	5,
+	4,
+	5,
+	5,
+	6,
+	4,
+	5,
+	6,
+	7,
+	6,
+	7,
+	5,
+	4,
+	4,
+	7,
+	6,
+	7,
+	5,
+	7,
+	6,
+	3,
+	4,
+	4,
+	2,
+	3,
+	3,
+	4,
+	4,
+	4,
+	4,
+	6,
+	4,
+	4,
+	3,
+	4,
+	3,
+	7,
+	3,
+	3,
+	5,
+	3,
+	6,
+	3,
+	3,
+	4,
+	5,
+	6,
+	3,
+	3,
+	6,
+	3,
+	6,
+	5,
+	5,
+	6,
+	6,
+	6,
+	5,
+	7,
+	3,
+	3,
+	3,
+	3,
+	2,
+	3,
+	8,
+	8,
+	8,
+	8,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	6,
+	6,
+	7,
+	7,
+	7,
+	4,
+	5,
+	5,
+	5,
+	7,
+	5,
+	8,
+	7,
+	7,
+	7,
+	7,
+	7,
+	9,
+	9,
+	7,
+	7,
+	7,
+	7,
+	9,
+	9,
+	5,
+	5,
+	5,
+	5,
+	7,
+	7,
+	7,
+	5,
+	5,
+	5,
+	6,
+	7,
+	5,
+	8,
+	8,
+	6,
+	8,
+	7,
+	8,
+	5,
+	6,
+	6,
+	7,
+	6,
+	10,
+	6,
+	7,
+	6,
+	5,
+	5,
+	7,
+	9,
+	6,
+	6,
+	6,
+	6,
+	6,
+	6,
+	6,
+	6,
+	6,
+	6,
+	6,
+	6,
+	6,
+	8,
+	7,
+	7,
+	6,
+	6,
+	6,
+	7,
+	3,
+	6,
+	3,
+	6,
+	6,
+	6,
+	6,
+	6,
+	5,
+	6,
+	5,
+	5,
+	5,
+	5,
+	5,
+	6,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	6,
+	6,
+	7,
+	7,
+	6,
+	5,
+	9,
+	9,
+	10,
+	9,
+	10,
+	4,
+	4,
+	5,
+	5,
+	5,
+	4,
+	4,
+	3,
+	3,
+	3,
+	3,
+	7,
+	7,
+	3,
+	4,
+	4,
+	3,
+	3,
+	6,
+	3,
+	4,
+	3,
+	4,
+	3,
+	3,
+	3,
+	3,
+	7,
+	7,
+	8,
+	7,
+	6,
+	4,
+	3,
+	6,
+	7,
+	6,
+	5,
+	4,
+	4,
+	4,
+	3,
+	6,
+	5,
+	5,
+	5,
+	5,
+	5,
+	8,
+	8,
+	6,
+	6,
+	5,
+	5,
+	3,
+	4,
+	4,
+	5,
+	5,
+	5,
+	5,
+	5,
+	6,
+	5,
+	6,
+	5,
+	6,
+	6,
+	5,
+	5,
+	6,
+	6,
+	6,
+	5,
+	6,
+	6,
+	5,
+	3,
+	3,
+	3,
+	5,
+	5,
+	5,
+	5,
+	4,
+	4,
+	4,
+	4,
+	4,
+	5,
+	5,
+	2,
+	3,
+	2,
+	3,
+	2,
+	3,
+	3,
+	2,
+	2,
+	3,
+	3,
+	3,
+	2,
+	3,
+	3,
+	2,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	4,
+	4,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	4,
+	4,
+	5,
+	5,
+	5,
+	5,
+	6,
+	6,
+	6,
+	6,
+	4,
+	5,
+	4,
+	5,
+	5,
+	5,
+	6,
+	5,
+	6,
+	6,
+	5,
+	5,
+	7,
+	7,
+	5,
+	5,
+	5,
+	5,
+	4,
+	5,
+	4,
+	5,
+	4,
+	5,
+	5,
+	4,
+	4,
+	5,
+	5,
+	5,
+	4,
+	5,
+	5,
+	4,
+	6,
+	6,
+	6,
+	6,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	6,
+	6,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	9,
+	9,
+	9,
+	9,
+	9,
+	9,
+	9,
+	6,
+	6,
+	6,
+	6,
+	8,
+	5,
+	4,
+	4,
+	4,
+	4,
+	3,
+	8,
+	10,
+	6,
+	7,
+	6,
+	6,
+	7,
+	7,
+	6,
+	6,
+	7,
+	6,
+	6,
+	8,
+	8,
+	7,
+	6,
+	6,
+	8,
+	8,
+	7,
+	8,
+	7,
+	7,
+	6,
+	7,
+	5,
+	6,
+	6,
+	6,
+	6,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	8,
+	11,
+	10,
+	10,
+	10,
+	9,
+	6,
+	7,
+	7,
+	6,
+	9,
+	9,
+	9,
+	7,
+	7,
+	4,
+	4,
+	4,
+	6,
+	6,
+	4,
+	3,
+	6,
+	7,
+	7,
+	8,
+	8,
+	8,
+	8,
+	4,
+	4,
+	6,
+	7,
+	8,
+	7,
+	7,
+	8,
+	6,
+	5,
+	6,
+	6,
+	4,
+	4,
+	5,
+	6,
+	4,
+	5,
+	5,
+	6
+};
+#define MAX_OPERATION_STRING_LENGTH 11
+static const char operandStringData[] =
+	"al"
+	"cl"
+	"dl"
+	"bl"
+	"ah"
+	"ch"
+	"dh"
+	"bh"
+	"spl"
+	"bpl"
+	"sil"
+	"dil"
+	"r8b"
+	"r9b"
+	"r10b"
+	"r11b"
+	"r12b"
+	"r13b"
+	"r14b"
+	"r15b"
+	"ax"
+	"cx"
+	"dx"
+	"bx"
+	"sp"
+	"bp"
+	"si"
+	"di"
+	"r8w"
+	"r9w"
+	"r10w"
+	"r11w"
+	"r12w"
+	"r13w"
+	"r14w"
+	"r15w"
+	"eax"
+	"ecx"
+	"edx"
+	"ebx"
+	"esp"
+	"ebp"
+	"esi"
+	"edi"
+	"r8d"
+	"r9d"
+	"r10d"
+	"r11d"
+	"r12d"
+	"r13d"
+	"r14d"
+	"r15d"
+	"rax"
+	"rcx"
+	"rdx"
+	"rbx"
+	"rsp"
+	"rbp"
+	"rsi"
+	"rdi"
+	"r8"
+	"r9"
+	"r10"
+	"r11"
+	"r12"
+	"r13"
+	"r14"
+	"r15"
+	"st0"
+	"st1"
+	"st2"
+	"st3"
+	"st4"
+	"st5"
+	"st6"
+	"st7"
+	"mm0"
+	"mm1"
+	"mm2"
+	"mm3"
+	"mm4"
+	"mm5"
+	"mm6"
+	"mm7"
+	"xmm0"
+	"xmm1"
+	"xmm2"
+	"xmm3"
+	"xmm4"
+	"xmm5"
+	"xmm6"
+	"xmm7"
+	"xmm8"
+	"xmm9"
+	"xmm10"
+	"xmm11"
+	"xmm12"
+	"xmm13"
+	"xmm14"
+	"xmm15"
+	"cr0"
+	"cr1"
+	"cr2"
+	"cr3"
+	"cr4"
+	"cr5"
+	"cr6"
+	"cr7"
+	"cr8"
+	"cr9"
+	"cr10"
+	"cr11"
+	"cr12"
+	"cr13"
+	"cr14"
+	"cr15"
+	"dr0"
+	"dr1"
+	"dr2"
+	"dr3"
+	"dr4"
+	"dr5"
+	"dr6"
+	"dr7"
+	"dr8"
+	"dr9"
+	"dr10"
+	"dr11"
+	"dr12"
+	"dr13"
+	"dr14"
+	"dr15"
+	"tr0"
+	"tr1"
+	"tr2"
+	"tr3"
+	"tr4"
+	"tr5"
+	"tr6"
+	"tr7"
+	"tr8"
+	"tr9"
+	"tr10"
+	"tr11"
+	"tr12"
+	"tr13"
+	"tr14"
+	"tr15"
+	"es"
+	"cs"
+	"ss"
+	"ds"
+	"fs"
+	"gs"
 	"rip"
+;
+static const uint16_t operandStringOffset[] = {
+	0,
+	0,
+	0,
+	0,
+	2,
+	4,
+	6,
+	8,
+	10,
+	12,
+	14,
+	16,
+	19,
+	22,
+	25,
+	28,
+	31,
+	34,
+	38,
+	42,
+	46,
+	50,
+	54,
+	58,
+	60,
+	62,
+	64,
+	66,
+	68,
+	70,
+	72,
+	74,
+	77,
+	80,
+	84,
+	88,
+	92,
+	96,
+	100,
+	104,
+	107,
+	110,
+	113,
+	116,
+	119,
+	122,
+	125,
+	128,
+	131,
+	134,
+	138,
+	142,
+	146,
+	150,
+	154,
+	158,
+	161,
+	164,
+	167,
+	170,
+	173,
+	176,
+	179,
+	182,
+	184,
+	186,
+	189,
+	192,
+	195,
+	198,
+	201,
+	204,
+	207,
+	210,
+	213,
+	216,
+	219,
+	222,
+	225,
+	228,
+	231,
+	234,
+	237,
+	240,
+	243,
+	246,
+	249,
+	252,
+	256,
+	260,
+	264,
+	268,
+	272,
+	276,
+	280,
+	284,
+	288,
+	292,
+	297,
+	302,
+	307,
+	312,
+	317,
+	322,
+	325,
+	328,
+	331,
+	334,
+	337,
+	340,
+	343,
+	346,
+	349,
+	352,
+	356,
+	360,
+	364,
+	368,
+	372,
+	376,
+	379,
+	382,
+	385,
+	388,
+	391,
+	394,
+	397,
+	400,
+	403,
+	406,
+	410,
+	414,
+	418,
+	422,
+	426,
+	430,
+	433,
+	436,
+	439,
+	442,
+	445,
+	448,
+	451,
+	454,
+	457,
+	460,
+	464,
+	468,
+	472,
+	476,
+	480,
+	484,
+	486,
+	488,
+	490,
+	492,
+	494,
+	496
+};
+static const uint8_t operandStringLength[] = {
+	0,
+	0,
+	0,
+	2,
+	2,
+	2,
+	2,
+	2,
+	2,
+	2,
+	2,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	2,
+	2,
+	2,
+	2,
+	2,
+	2,
+	2,
+	2,
+	3,
+	3,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	2,
+	2,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	5,
+	5,
+	5,
+	5,
+	5,
+	5,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	4,
+	4,
+	4,
+	4,
+	4,
+	4,
+	2,
+	2,
+	2,
+	2,
+	2,
+	2,
+	3
+};
+#define MAX_OPERAND_STRING_LENGTH 5
+const uint16_t X86OperationAttributes[] = {
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0104, // CALLF: X86_OP_CALL X86_OP_STACK
+	0x0104, // CALL: X86_OP_CALL X86_OP_STACK
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0020, // CLI: X86_OP_PRIVILEGED
+	0x0020, // CLTS: X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0100, // ENTER: X86_OP_STACK
+	0x0400, // F2XM1: X86_OP_FPU
+	0x0400, // FABS: X86_OP_FPU
+	0x0400, // FADD: X86_OP_FPU
+	0x0400, // FADDP: X86_OP_FPU
+	0x0400, // FBLD: X86_OP_FPU
+	0x0400, // FBSTP: X86_OP_FPU
+	0x0400, // FCHS: X86_OP_FPU
+	0x0400, // FCLEX: X86_OP_FPU
+	0x0402, // FCMOVB: X86_OP_CONDITIONAL X86_OP_FPU
+	0x0402, // FCMOVBE: X86_OP_CONDITIONAL X86_OP_FPU
+	0x0402, // FCMOVE: X86_OP_CONDITIONAL X86_OP_FPU
+	0x0402, // FCMOVNB: X86_OP_CONDITIONAL X86_OP_FPU
+	0x0402, // FCMOVNBE: X86_OP_CONDITIONAL X86_OP_FPU
+	0x0402, // FCMOVNE: X86_OP_CONDITIONAL X86_OP_FPU
+	0x0402, // FCMOVNU: X86_OP_CONDITIONAL X86_OP_FPU
+	0x0402, // FCMOVU: X86_OP_CONDITIONAL X86_OP_FPU
+	0x0400, // FCOM: X86_OP_FPU
+	0x0400, // FCOMI: X86_OP_FPU
+	0x0400, // FCOMIP: X86_OP_FPU
+	0x0400, // FCOMP: X86_OP_FPU
+	0x0400, // FCOMPP: X86_OP_FPU
+	0x0400, // FCOS: X86_OP_FPU
+	0x0400, // FDECSTP: X86_OP_FPU
+	0x0400, // FDISI: X86_OP_FPU
+	0x0400, // FDIV: X86_OP_FPU
+	0x0400, // FDIVP: X86_OP_FPU
+	0x0400, // FDIVR: X86_OP_FPU
+	0x0400, // FDIVRP: X86_OP_FPU
+	0x0000,
+	0x0400, // FENI: X86_OP_FPU
+	0x0400, // FFREE: X86_OP_FPU
+	0x0400, // FFREEP: X86_OP_FPU
+	0x0400, // FIADD: X86_OP_FPU
+	0x0400, // FICOM: X86_OP_FPU
+	0x0400, // FICOMP: X86_OP_FPU
+	0x0400, // FIDIV: X86_OP_FPU
+	0x0400, // FIDIVR: X86_OP_FPU
+	0x0400, // FILD: X86_OP_FPU
+	0x0400, // FIMUL: X86_OP_FPU
+	0x0400, // FINCSTP: X86_OP_FPU
+	0x0400, // FINIT: X86_OP_FPU
+	0x0400, // FIST: X86_OP_FPU
+	0x0400, // FISTP: X86_OP_FPU
+	0x0400, // FISTTP: X86_OP_FPU
+	0x0400, // FISUB: X86_OP_FPU
+	0x0400, // FISUBR: X86_OP_FPU
+	0x0400, // FLD: X86_OP_FPU
+	0x0400, // FLD1: X86_OP_FPU
+	0x0400, // FLDCW: X86_OP_FPU
+	0x0400, // FLDENV: X86_OP_FPU
+	0x0400, // FLDL2E: X86_OP_FPU
+	0x0400, // FLDL2T: X86_OP_FPU
+	0x0400, // FLDLG2: X86_OP_FPU
+	0x0400, // FLDLN2: X86_OP_FPU
+	0x0400, // FLDPI: X86_OP_FPU
+	0x0400, // FLDZ: X86_OP_FPU
+	0x0400, // FMUL: X86_OP_FPU
+	0x0400, // FMULP: X86_OP_FPU
+	0x0400, // FNOP: X86_OP_FPU
+	0x0400, // FPATAN: X86_OP_FPU
+	0x0400, // FPREM: X86_OP_FPU
+	0x0400, // FPREM1: X86_OP_FPU
+	0x0400, // FPTAN: X86_OP_FPU
+	0x0400, // FRICHOP: X86_OP_FPU
+	0x0400, // FRINEAR: X86_OP_FPU
+	0x0400, // FRINT2: X86_OP_FPU
+	0x0400, // FRNDINT: X86_OP_FPU
+	0x0400, // FRSTOR: X86_OP_FPU
+	0x0400, // FRSTPM: X86_OP_FPU
+	0x0400, // FSAVE: X86_OP_FPU
+	0x0400, // FSCALE: X86_OP_FPU
+	0x0400, // FSETPM: X86_OP_FPU
+	0x0400, // FSIN: X86_OP_FPU
+	0x0400, // FSINCOS: X86_OP_FPU
+	0x0400, // FSQRT: X86_OP_FPU
+	0x0400, // FST: X86_OP_FPU
+	0x0400, // FSTCW: X86_OP_FPU
+	0x0400, // FSTDW: X86_OP_FPU
+	0x0400, // FSTENV: X86_OP_FPU
+	0x0400, // FSTP: X86_OP_FPU
+	0x0400, // FSTSG: X86_OP_FPU
+	0x0400, // FSTSW: X86_OP_FPU
+	0x0400, // FSUB: X86_OP_FPU
+	0x0400, // FSUBP: X86_OP_FPU
+	0x0400, // FSUBR: X86_OP_FPU
+	0x0400, // FSUBRP: X86_OP_FPU
+	0x0400, // FTST: X86_OP_FPU
+	0x0400, // FUCOM: X86_OP_FPU
+	0x0400, // FUCOMI: X86_OP_FPU
+	0x0400, // FUCOMIP: X86_OP_FPU
+	0x0400, // FUCOMP: X86_OP_FPU
+	0x0400, // FUCOMPP: X86_OP_FPU
+	0x0400, // FWAIT: X86_OP_FPU
+	0x0400, // FXAM: X86_OP_FPU
+	0x0400, // FXCH: X86_OP_FPU
+	0x0400, // FXRSTOR: X86_OP_FPU
+	0x0400, // FXSAVE: X86_OP_FPU
+	0x0400, // FXTRACT: X86_OP_FPU
+	0x0400, // FYL2X: X86_OP_FPU
+	0x0400, // FYL2XP1: X86_OP_FPU
+	0x0020, // GETSEC: X86_OP_PRIVILEGED
+	0x0220, // HLT: X86_OP_NO_FALLTHROUGH X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x00a0, // IN: X86_OP_IO X86_OP_PRIVILEGED
+	0x0000,
+	0x0010, // INT: X86_OP_INTERRUPT
+	0x0010, // INT1: X86_OP_INTERRUPT
+	0x0010, // INT3: X86_OP_INTERRUPT
+	0x0010, // INTO: X86_OP_INTERRUPT
+	0x0020, // INVD: X86_OP_PRIVILEGED
+	0x0020, // INVLPG: X86_OP_PRIVILEGED
+	0x0308, // IRET: X86_OP_NO_FALLTHROUGH X86_OP_RETURN X86_OP_STACK
+	0x0201, // JMPF: X86_OP_BRANCH X86_OP_NO_FALLTHROUGH
+	0x0201, // JMP: X86_OP_BRANCH X86_OP_NO_FALLTHROUGH
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0100, // LEAVE: X86_OP_STACK
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0003, // LOOP: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // LOOPE: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // LOOPNE: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x00a0, // OUT: X86_OP_IO X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0100, // POP: X86_OP_STACK
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0100, // PUSH: X86_OP_STACK
+	0x0000,
+	0x0020, // RDMSR: X86_OP_PRIVILEGED
+	0x0020, // RDPMC: X86_OP_PRIVILEGED
+	0x0000,
+	0x0308, // RETF: X86_OP_NO_FALLTHROUGH X86_OP_RETURN X86_OP_STACK
+	0x0308, // RETN: X86_OP_NO_FALLTHROUGH X86_OP_RETURN X86_OP_STACK
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0220, // RSM: X86_OP_NO_FALLTHROUGH X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0020, // STI: X86_OP_PRIVILEGED
+	0x0000,
+	0x0010, // SYSCALL: X86_OP_INTERRUPT
+	0x0010, // SYSENTER: X86_OP_INTERRUPT
+	0x0228, // SYSEXIT: X86_OP_NO_FALLTHROUGH X86_OP_PRIVILEGED X86_OP_RETURN
+	0x0228, // SYSRET: X86_OP_NO_FALLTHROUGH X86_OP_PRIVILEGED X86_OP_RETURN
+	0x0000,
+	0x0200, // UD2: X86_OP_NO_FALLTHROUGH
+	0x0020, // VMREAD: X86_OP_PRIVILEGED
+	0x0020, // VMWRITE: X86_OP_PRIVILEGED
+	0x0020, // WBINVD: X86_OP_PRIVILEGED
+	0x0020, // WRMSR: X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0040, // CMPSB: X86_OP_STRING
+	0x0040, // CMPSW: X86_OP_STRING
+	0x0040, // CMPSD: X86_OP_STRING
+	0x0040, // CMPSQ: X86_OP_STRING
+	0x0002, // CMOVO: X86_OP_CONDITIONAL
+	0x0002, // CMOVNO: X86_OP_CONDITIONAL
+	0x0002, // CMOVB: X86_OP_CONDITIONAL
+	0x0002, // CMOVAE: X86_OP_CONDITIONAL
+	0x0002, // CMOVE: X86_OP_CONDITIONAL
+	0x0002, // CMOVNE: X86_OP_CONDITIONAL
+	0x0002, // CMOVBE: X86_OP_CONDITIONAL
+	0x0002, // CMOVA: X86_OP_CONDITIONAL
+	0x0002, // CMOVS: X86_OP_CONDITIONAL
+	0x0002, // CMOVNS: X86_OP_CONDITIONAL
+	0x0002, // CMOVPE: X86_OP_CONDITIONAL
+	0x0002, // CMOVPO: X86_OP_CONDITIONAL
+	0x0002, // CMOVL: X86_OP_CONDITIONAL
+	0x0002, // CMOVGE: X86_OP_CONDITIONAL
+	0x0002, // CMOVLE: X86_OP_CONDITIONAL
+	0x0002, // CMOVG: X86_OP_CONDITIONAL
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x00e0, // INSB: X86_OP_IO X86_OP_PRIVILEGED X86_OP_STRING
+	0x00e0, // INSW: X86_OP_IO X86_OP_PRIVILEGED X86_OP_STRING
+	0x00e0, // INSD: X86_OP_IO X86_OP_PRIVILEGED X86_OP_STRING
+	0x00e0, // INSQ: X86_OP_IO X86_OP_PRIVILEGED X86_OP_STRING
+	0x0003, // JCXZ: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JECXZ: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JRCXZ: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JO: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JNO: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JB: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JAE: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JE: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JNE: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JBE: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JA: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JS: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JNS: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JPE: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JPO: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JL: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JGE: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JLE: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0003, // JG: X86_OP_BRANCH X86_OP_CONDITIONAL
+	0x0040, // LODSB: X86_OP_STRING
+	0x0040, // LODSW: X86_OP_STRING
+	0x0040, // LODSD: X86_OP_STRING
+	0x0040, // LODSQ: X86_OP_STRING
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0040, // MOVSB: X86_OP_STRING
+	0x0040, // MOVSW: X86_OP_STRING
+	0x0040, // MOVSD: X86_OP_STRING
+	0x0040, // MOVSQ: X86_OP_STRING
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x00e0, // OUTSB: X86_OP_IO X86_OP_PRIVILEGED X86_OP_STRING
+	0x00e0, // OUTSW: X86_OP_IO X86_OP_PRIVILEGED X86_OP_STRING
+	0x00e0, // OUTSD: X86_OP_IO X86_OP_PRIVILEGED X86_OP_STRING
+	0x00e0, // OUTSQ: X86_OP_IO X86_OP_PRIVILEGED X86_OP_STRING
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0100, // POPA: X86_OP_STACK
+	0x0100, // POPAD: X86_OP_STACK
+	0x0100, // POPF: X86_OP_STACK
+	0x0100, // POPFD: X86_OP_STACK
+	0x0100, // POPFQ: X86_OP_STACK
+	0x0100, // PUSHA: X86_OP_STACK
+	0x0100, // PUSHAD: X86_OP_STACK
+	0x0100, // PUSHF: X86_OP_STACK
+	0x0100, // PUSHFD: X86_OP_STACK
+	0x0100, // PUSHFQ: X86_OP_STACK
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0040, // SCASB: X86_OP_STRING
+	0x0040, // SCASW: X86_OP_STRING
+	0x0040, // SCASD: X86_OP_STRING
+	0x0040, // SCASQ: X86_OP_STRING
+	0x0002, // SETO: X86_OP_CONDITIONAL
+	0x0002, // SETNO: X86_OP_CONDITIONAL
+	0x0002, // SETB: X86_OP_CONDITIONAL
+	0x0002, // SETAE: X86_OP_CONDITIONAL
+	0x0002, // SETE: X86_OP_CONDITIONAL
+	0x0002, // SETNE: X86_OP_CONDITIONAL
+	0x0002, // SETBE: X86_OP_CONDITIONAL
+	0x0002, // SETA: X86_OP_CONDITIONAL
+	0x0002, // SETS: X86_OP_CONDITIONAL
+	0x0002, // SETNS: X86_OP_CONDITIONAL
+	0x0002, // SETPE: X86_OP_CONDITIONAL
+	0x0002, // SETPO: X86_OP_CONDITIONAL
+	0x0002, // SETL: X86_OP_CONDITIONAL
+	0x0002, // SETGE: X86_OP_CONDITIONAL
+	0x0002, // SETLE: X86_OP_CONDITIONAL
+	0x0002, // SETG: X86_OP_CONDITIONAL
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0040, // STOSB: X86_OP_STRING
+	0x0040, // STOSW: X86_OP_STRING
+	0x0040, // STOSD: X86_OP_STRING
+	0x0040, // STOSQ: X86_OP_STRING
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0020, // LGDT: X86_OP_PRIVILEGED
+	0x0020, // LIDT: X86_OP_PRIVILEGED
+	0x0020, // LLDT: X86_OP_PRIVILEGED
+	0x0020, // LMSW: X86_OP_PRIVILEGED
+	0x0020, // LTR: X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0020, // MONITOR: X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0020, // MWAIT: X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0020, // SWAPGS: X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0020, // VMCLEAR: X86_OP_PRIVILEGED
+	0x0020, // VMLAUNCH: X86_OP_PRIVILEGED
+	0x0020, // VMPTRLD: X86_OP_PRIVILEGED
+	0x0020, // VMPTRST: X86_OP_PRIVILEGED
+	0x0020, // VMRESUME: X86_OP_PRIVILEGED
+	0x0020, // VMXOFF: X86_OP_PRIVILEGED
+	0x0020, // VMXON: X86_OP_PRIVILEGED
+	0x0000,
+	0x0020, // XSETBV: X86_OP_PRIVILEGED
+	0x0020, // CLAC: X86_OP_PRIVILEGED
+	0x0020, // STAC: X86_OP_PRIVILEGED
+	0x0020, // ENCLS: X86_OP_PRIVILEGED
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000
+};
+static const uint16_t operationOperandAccess[] = {
+	0x0000,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0015,
+	0x001a,
+	0x001a,
+	0x0003,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0001,
+	0x0001,
+	0x05df,
+	0x05df,
+	0x0000,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0015,
+	0x0003,
+	0x0003,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0003,
+	0x0001,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x001d,
+	0x05df,
+	0x0001,
+	0x0002,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001d,
+	0x05df,
+	0x001d,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0002,
+	0x0002,
+	0x05df,
+	0x0015,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x0001,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x05df,
+	0x05df,
+	0x0001,
+	0x05df,
+	0x0001,
+	0x0001,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001d,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0001,
+	0x05df,
+	0x0002,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x001d,
+	0x05df,
+	0x001d,
+	0x05df,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x003f,
+	0x0001,
+	0x0002,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0001,
+	0x059d,
+	0x001a,
+	0x0003,
+	0x0001,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0000,
+	0x05df,
+	0x0001,
+	0x0001,
+	0x05df,
+	0x001a,
+	0x0001,
+	0x001a,
+	0x000a,
+	0x05df,
+	0x001a,
+	0x05df,
+	0x001a,
+	0x001a,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x001a,
+	0x001a,
+	0x05df,
+	0x001a,
+	0x001a,
+	0x301a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x05df,
+	0x0001,
+	0x0003,
+	0x0000,
+	0x0003,
+	0x05df,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0555,
+	0x0555,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0555,
+	0x0555,
+	0x001a,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0002,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0001,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0001,
+	0x0001,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x059a,
+	0x059a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0002,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0015,
+	0x05df,
+	0x001a,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x003f,
+	0x001a,
+	0x003f,
+	0x05df,
+	0x0001,
+	0x0002,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0015,
+	0x0015,
+	0x05d4,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x301a,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x059a,
+	0x059a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x05df,
+	0x001a,
+	0x05df,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x0015,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x001a,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0015,
+	0x0015,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001f,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001f,
+	0x001f,
+	0x001f,
+	0x001f,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x059a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x001a,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0001,
+	0x0015,
+	0x0015,
+	0x0000,
+	0x05df,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001f,
+	0x101a,
+	0x101a,
+	0x001a,
+	0x001a,
+	0x001f,
+	0x101a,
+	0x101a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x059a,
+	0x059a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x001a,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x0000,
+	0x059a,
+	0x059a,
+	0x059a,
+	0x059a,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0002,
+	0x0002,
+	0x0002,
+	0x05df,
+	0x05df,
+	0x0002,
+	0x0002,
+	0x05df,
+	0x0015,
+	0x0015,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x0001,
+	0x0001,
+	0x05df,
+	0x0001,
+	0x05df,
+	0x0001,
+	0x0002,
+	0x05df,
+	0x05df,
+	0x0001,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df,
+	0x05df
+};
+const X86FlagMasks X86OperationFlags[] = {
+	{0x000, 0x000, 0x000},
+	{0x010, 0x011, 0x8c4},
+	{0x000, 0x0c4, 0x811},
+	{0x000, 0x0c4, 0x811},
+	{0x010, 0x011, 0x8c4},
+	{0x000, 0x8d5, 0x000},
+	{0x001, 0x8d5, 0x000},
+	{0x000, 0x8c5, 0x010},
+	{0x000, 0x040, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x040, 0x895},
+	{0x000, 0x040, 0x895},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x001, 0x894},
+	{0x000, 0x001, 0x894},
+	{0x000, 0x001, 0x894},
+	{0x000, 0x001, 0x894},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x001, 0x000},
+	{0x000, 0x400, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x200, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x001, 0x001, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x040, 0x000},
+	{0x000, 0x040, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x011, 0x0d5, 0x800},
+	{0x011, 0x0d5, 0x800},
+	{0x000, 0x8d4, 0x000},
+	{0x000, 0x000, 0x8d5},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x001, 0x000, 0x000},
+	{0x041, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x001, 0x000, 0x000},
+	{0x041, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x004, 0x000, 0x000},
+	{0x004, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x8d5},
+	{0x000, 0x801, 0x0d4},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d4, 0x000},
+	{0x000, 0x300, 0x000},
+	{0x000, 0x300, 0x000},
+	{0x000, 0x300, 0x000},
+	{0x800, 0x300, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0xfd5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x0d5, 0x000, 0x000},
+	{0x000, 0x040, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x000, 0x040, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x801, 0x0d4},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8c5, 0x010},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x001, 0x801, 0x000},
+	{0x001, 0x801, 0x000},
+	{0x000, 0x801, 0x000},
+	{0x000, 0x801, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0xfd5, 0x000},
+	{0x000, 0x0d5, 0x000},
+	{0x001, 0x000, 0x000},
+	{0x000, 0x8c5, 0x010},
+	{0x001, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8c5, 0x010},
+	{0x000, 0x8c5, 0x010},
+	{0x000, 0x8c5, 0x010},
+	{0x000, 0x8c5, 0x010},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x001, 0x000},
+	{0x000, 0x400, 0x000},
+	{0x000, 0x200, 0x000},
+	{0x000, 0x000, 0x000},
+	{0xfd5, 0xfd5, 0x000},
+	{0x000, 0x200, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0xfd5, 0x000},
+	{0x000, 0x8c5, 0x010},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8c5, 0x010},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x400, 0x8d5, 0x000},
+	{0x400, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x400, 0x8d5, 0x000},
+	{0x800, 0x000, 0x000},
+	{0x800, 0x000, 0x000},
+	{0x001, 0x000, 0x000},
+	{0x001, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x041, 0x000, 0x000},
+	{0x041, 0x000, 0x000},
+	{0x080, 0x000, 0x000},
+	{0x080, 0x000, 0x000},
+	{0x004, 0x000, 0x000},
+	{0x004, 0x000, 0x000},
+	{0x880, 0x000, 0x000},
+	{0x880, 0x000, 0x000},
+	{0x8c0, 0x000, 0x000},
+	{0x8c0, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x800, 0x000, 0x000},
+	{0x800, 0x000, 0x000},
+	{0x001, 0x000, 0x000},
+	{0x001, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x041, 0x000, 0x000},
+	{0x041, 0x000, 0x000},
+	{0x080, 0x000, 0x000},
+	{0x080, 0x000, 0x000},
+	{0x004, 0x000, 0x000},
+	{0x004, 0x000, 0x000},
+	{0x880, 0x000, 0x000},
+	{0x880, 0x000, 0x000},
+	{0x8c0, 0x000, 0x000},
+	{0x8c0, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0xfd5, 0x000},
+	{0x000, 0xfd5, 0x000},
+	{0x000, 0xfd5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0xfd5, 0x000, 0x000},
+	{0xfd5, 0x000, 0x000},
+	{0xfd5, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x400, 0x8d5, 0x000},
+	{0x400, 0x8d5, 0x000},
+	{0x400, 0x8d5, 0x000},
+	{0x400, 0x8d5, 0x000},
+	{0x800, 0x000, 0x000},
+	{0x800, 0x000, 0x000},
+	{0x001, 0x000, 0x000},
+	{0x001, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x040, 0x000, 0x000},
+	{0x041, 0x000, 0x000},
+	{0x041, 0x000, 0x000},
+	{0x080, 0x000, 0x000},
+	{0x080, 0x000, 0x000},
+	{0x004, 0x000, 0x000},
+	{0x004, 0x000, 0x000},
+	{0x880, 0x000, 0x000},
+	{0x880, 0x000, 0x000},
+	{0x8c0, 0x000, 0x000},
+	{0x8c0, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x400, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x040, 0x000},
+	{0x000, 0x040, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x8d5, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000},
+	{0x000, 0x000, 0x000}
+};
+static const uint8_t operandRegisterBit[] = {
+	0xff,
+	0xff,
+	0xff,
+	0,
+	1,
+	2,
+	3,
+	0,
+	1,
+	2,
+	3,
+	4,
+	5,
+	6,
+	7,
+	8,
+	9,
+	10,
+	11,
+	12,
+	13,
+	14,
+	15,
+	0,
+	1,
+	2,
+	3,
+	4,
+	5,
+	6,
+	7,
+	8,
+	9,
+	10,
+	11,
+	12,
+	13,
+	14,
+	15,
+	0,
+	1,
+	2,
+	3,
+	4,
+	5,
+	6,
+	7,
+	8,
+	9,
+	10,
+	11,
+	12,
+	13,
+	14,
+	15,
+	0,
+	1,
+	2,
+	3,
+	4,
+	5,
+	6,
+	7,
+	8,
+	9,
+	10,
+	11,
+	12,
+	13,
+	14,
+	15,
+	40,
+	41,
+	42,
+	43,
+	44,
+	45,
+	46,
+	47,
+	32,
+	33,
+	34,
+	35,
+	36,
+	37,
+	38,
+	39,
+	16,
+	17,
+	18,
+	19,
+	20,
+	21,
+	22,
+	23,
+	24,
+	25,
+	26,
+	27,
+	28,
+	29,
+	30,
+	31,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	56,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	57,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	58,
+	48,
+	49,
+	50,
+	51,
+	52,
+	53,
+	54
+};
+static const X86RegisterMasks implicitRegisterMasks[] = {
+	{0x0000000000000000ULL, 0x0000000000000000ULL},
+	{0x0080000000000001ULL, 0x0080000000000001ULL},
+	{0x0000000000000001ULL, 0x0080000000000001ULL},
+	{0x0000000000000000ULL, 0x0080000000000000ULL},
+	{0x0080000000000000ULL, 0x0080000000000000ULL},
+	{0x0000000000010000ULL, 0x0000000000000000ULL},
+	{0x0000000000000010ULL, 0x0000000000000010ULL},
+	{0x000000000000000fULL, 0x0080000000000005ULL},
+	{0x0000000000000003ULL, 0x000000000000000fULL},
+	{0x0000000000000005ULL, 0x0080000000000005ULL},
+	{0x0000000000000030ULL, 0x0000000000000030ULL},
+	{0x0000010000000000ULL, 0x0000010000000000ULL},
+	{0x0000000000000000ULL, 0x0000010000000000ULL},
+	{0x0000010000000000ULL, 0x0000000000000000ULL},
+	{0x0080000000000000ULL, 0x0000000000000000ULL},
+	{0x0000030000000000ULL, 0x0000000000000000ULL},
+	{0x0000030000000000ULL, 0x0000020000000000ULL},
+	{0x0000030000000000ULL, 0x0000010000000000ULL},
+	{0x0000010000000000ULL, 0x0000030000000000ULL},
+	{0x0000000000000001ULL, 0x0080000000000005ULL},
+	{0x0000000000000010ULL, 0x0086000000000010ULL},
+	{0x0080000000000000ULL, 0x0000000000000001ULL},
+	{0x0000000000000020ULL, 0x0000000000000030ULL},
+	{0x0000000000000002ULL, 0x0000000000000002ULL},
+	{0x0080000000000002ULL, 0x0000000000000002ULL},
+	{0x0000000000000005ULL, 0x0080000000000002ULL},
+	{0x0000000000000005ULL, 0x0080000000010000ULL},
+	{0x0000000000000000ULL, 0x0080000000000002ULL},
+	{0x0000000000000000ULL, 0x0080000000010000ULL},
+	{0x0000000000000002ULL, 0x0000000000000005ULL},
+	{0x0000000000000000ULL, 0x0000000000000005ULL},
+	{0x0000000000000001ULL, 0x0080000000000000ULL},
+	{0x0080000000000000ULL, 0x0080000000000802ULL},
+	{0x0000000000000006ULL, 0x0000000000000010ULL},
+	{0x0000000000000802ULL, 0x0080000000000000ULL},
+	{0x0000000000000007ULL, 0x0000000000000000ULL},
+	{0x0000000000000005ULL, 0x0000000000000000ULL},
+	{0x0000000000000001ULL, 0x0000000000000001ULL},
+	{0x0080000000000000ULL, 0x00800000000000c0ULL},
+	{0x0000000000000001ULL, 0x0000000000000004ULL},
+	{0x0080000000000000ULL, 0x0000000000000080ULL},
+	{0x0000000000000002ULL, 0x0000000000000000ULL},
+	{0x0080000000000000ULL, 0x0000000000000040ULL},
+	{0x0080000000000000ULL, 0x00000000000000c0ULL},
+	{0x0000000000000010ULL, 0x00000000000000ffULL},
+	{0x0000000000000010ULL, 0x0080000000000010ULL},
+	{0x00000000000000ffULL, 0x0000000000000010ULL},
+	{0x0080000000000010ULL, 0x0000000000000010ULL},
+	{0x0080000000000000ULL, 0x0080000000000080ULL},
+	{0x0000000000000080ULL, 0x0000000000000000ULL},
+	{0x0000000000000003ULL, 0x0000000000000000ULL},
+	{0x0000000000000000ULL, 0x0000000000000007ULL}
+};
+static const uint8_t operationImplicitRegisters[] = {
+	0,
+	1,
+	2,
+	2,
+	1,
+	3,
+	4,
+	3,
+	3,
+	0,
+	0,
+	5,
+	5,
+	0,
+	3,
+	3,
+	0,
+	3,
+	3,
+	3,
+	3,
+	6,
+	6,
+	3,
+	3,
+	0,
+	3,
+	0,
+	4,
+	3,
+	7,
+	7,
+	2,
+	8,
+	0,
+	1,
+	1,
+	3,
+	9,
+	0,
+	0,
+	0,
+	10,
+	11,
+	11,
+	11,
+	0,
+	12,
+	13,
+	11,
+	0,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	13,
+	3,
+	3,
+	13,
+	15,
+	11,
+	0,
+	0,
+	11,
+	0,
+	11,
+	0,
+	0,
+	0,
+	0,
+	0,
+	11,
+	13,
+	13,
+	11,
+	11,
+	12,
+	11,
+	0,
+	0,
+	13,
+	13,
+	13,
+	11,
+	11,
+	12,
+	12,
+	0,
+	0,
+	12,
+	12,
+	12,
+	12,
+	12,
+	12,
+	11,
+	0,
+	0,
+	16,
+	17,
+	17,
+	18,
+	0,
+	0,
+	0,
+	11,
+	0,
+	0,
+	0,
+	17,
+	0,
+	11,
+	18,
+	11,
+	13,
+	0,
+	0,
+	0,
+	13,
+	0,
+	0,
+	11,
+	0,
+	11,
+	0,
+	13,
+	13,
+	3,
+	3,
+	13,
+	15,
+	0,
+	13,
+	0,
+	0,
+	0,
+	11,
+	16,
+	16,
+	0,
+	0,
+	9,
+	19,
+	0,
+	3,
+	3,
+	3,
+	3,
+	4,
+	0,
+	0,
+	20,
+	0,
+	0,
+	21,
+	3,
+	0,
+	0,
+	0,
+	22,
+	0,
+	0,
+	0,
+	0,
+	23,
+	24,
+	24,
+	3,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	19,
+	3,
+	0,
+	0,
+	3,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	5,
+	0,
+	0,
+	0,
+	0,
+	0,
+	25,
+	26,
+	0,
+	0,
+	0,
+	0,
+	27,
+	28,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	6,
+	3,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	3,
+	0,
+	0,
+	0,
+	0,
+	0,
+	6,
+	0,
+	29,
+	29,
+	30,
+	6,
+	6,
+	4,
+	4,
+	3,
+	3,
+	0,
+	0,
+	3,
+	31,
+	21,
+	3,
+	4,
+	0,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	0,
+	32,
+	3,
+	33,
+	34,
+	3,
+	0,
+	3,
+	3,
+	0,
+	35,
+	0,
+	0,
+	3,
+	3,
+	36,
+	36,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	37,
+	37,
+	37,
+	38,
+	38,
+	0,
+	38,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	39,
+	39,
+	39,
+	0,
+	0,
+	0,
+	0,
+	40,
+	40,
+	40,
+	40,
+	41,
+	41,
+	41,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	42,
+	42,
+	42,
+	42,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	43,
+	43,
+	0,
+	43,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	42,
+	42,
+	42,
+	42,
+	0,
+	0,
+	0,
+	0,
+	44,
+	44,
+	45,
+	45,
+	45,
+	46,
+	46,
+	47,
+	47,
+	47,
+	0,
+	0,
+	0,
+	0,
+	48,
+	48,
+	48,
+	48,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	14,
+	0,
+	0,
+	0,
+	0,
+	40,
+	40,
+	40,
+	40,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	3,
+	3,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	49,
+	49,
+	0,
+	35,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	50,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	0,
+	3,
+	3,
+	0,
+	0,
+	0,
+	0,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	3,
+	29,
+	35,
+	0,
+	0,
+	0,
+	3,
+	0,
+	0,
+	0,
+	51
 };
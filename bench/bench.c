@@ -0,0 +1,1323 @@
+// Copyright (c) 2006-2015, Rusty Wagner
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+// the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+//      following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+//      the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Decoder benchmark. Run with "make bench". Each benchmark is run over deterministic corpora of
+// instructions emitted with codegenx86.h, and optionally over real code loaded from a file with -f.
+// The results are printed as tab separated lines so that runs can be compared across commits.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "asmx86.h"
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#define HAVE_CYCLE_COUNTER
+#endif
+
+#define DEFAULT_INSTRUCTION_COUNT 100000
+#define DEFAULT_REPETITIONS       5
+#define BLOCK_SIZE                1024
+#define CORPUS_BASE_ADDRESS       0x400000
+#define FORMAT_STRING             "%8a  %7i %o"
+#define TEXT_ARENA_SIZE           0x10000
+#define MAX_THREADS               256
+#define CFG_ENTRY_COUNT           64
+#define CFG_MEMORY_PER_BYTE       8
+#define DECODE_CACHE_ENTRIES      4096
+#define TRACE_SEED                0x7ace0000
+
+
+typedef struct
+{
+	uint64_t state;
+} Random;
+
+
+typedef struct
+{
+	OperandType base, index;
+	uint8_t scale;
+	int32_t offset;
+} MemOperand;
+
+
+typedef enum
+{
+	FORM_MOV_RR, FORM_MOV_RM, FORM_MOV_MR, FORM_MOV_RI, FORM_MOV_MI,
+	FORM_MOV8_RM, FORM_MOV8_MR, FORM_MOV16_MR,
+	FORM_MOV_NATIVE_RR, FORM_MOV_NATIVE_RM, FORM_MOV_NATIVE_MR, FORM_LEA, FORM_ALU_NATIVE_RI, FORM_MOVSXD,
+	FORM_ALU_RR, FORM_ALU_RM, FORM_ALU_MR, FORM_ALU_RI, FORM_ALU_MI,
+	FORM_CMP_RR, FORM_CMP_RI, FORM_CMP_MI, FORM_TEST_RR,
+	FORM_INC_DEC, FORM_NEG_NOT, FORM_SHIFT, FORM_IMUL, FORM_DIV,
+	FORM_MOVZX, FORM_MOVSX, FORM_SETCC, FORM_CMOV, FORM_BT, FORM_BSWAP, FORM_XADD,
+	FORM_PUSH, FORM_POP, FORM_JCC, FORM_JMP, FORM_CALL, FORM_CALL_INDIRECT, FORM_RET, FORM_LEAVE,
+	FORM_NOP, FORM_CDQ, FORM_STRING, FORM_SSE_RR, FORM_SSE_RM, FORM_SSE_CVT,
+	FORM_COUNT
+} InstructionForm;
+
+
+typedef struct
+{
+	InstructionForm form;
+	uint32_t weight;
+} FormWeight;
+
+
+// Relative frequency of instruction forms in typical compiler output. Moves, address computations,
+// compares and branches dominate, with arithmetic, stack operations and SSE making up the rest.
+static const FormWeight compilerMix[] =
+{
+	{FORM_MOV_RR, 60}, {FORM_MOV_RM, 90}, {FORM_MOV_MR, 70}, {FORM_MOV_RI, 40}, {FORM_MOV_MI, 20},
+	{FORM_MOV8_RM, 8}, {FORM_MOV8_MR, 6}, {FORM_MOV16_MR, 2},
+	{FORM_MOV_NATIVE_RR, 80}, {FORM_MOV_NATIVE_RM, 70}, {FORM_MOV_NATIVE_MR, 40}, {FORM_LEA, 60},
+	{FORM_ALU_NATIVE_RI, 30}, {FORM_MOVSXD, 8},
+	{FORM_ALU_RR, 40}, {FORM_ALU_RM, 10}, {FORM_ALU_MR, 6}, {FORM_ALU_RI, 20}, {FORM_ALU_MI, 4},
+	{FORM_CMP_RR, 30}, {FORM_CMP_RI, 30}, {FORM_CMP_MI, 10}, {FORM_TEST_RR, 40},
+	{FORM_INC_DEC, 8}, {FORM_NEG_NOT, 2}, {FORM_SHIFT, 12}, {FORM_IMUL, 6}, {FORM_DIV, 1},
+	{FORM_MOVZX, 20}, {FORM_MOVSX, 4}, {FORM_SETCC, 6}, {FORM_CMOV, 6}, {FORM_BT, 1}, {FORM_BSWAP, 1},
+	{FORM_XADD, 1},
+	{FORM_PUSH, 30}, {FORM_POP, 30}, {FORM_JCC, 80}, {FORM_JMP, 25}, {FORM_CALL, 45},
+	{FORM_CALL_INDIRECT, 5}, {FORM_RET, 15}, {FORM_LEAVE, 3},
+	{FORM_NOP, 10}, {FORM_CDQ, 2}, {FORM_STRING, 1}, {FORM_SSE_RR, 6}, {FORM_SSE_RM, 8}, {FORM_SSE_CVT, 2}
+};
+
+
+static uint64_t RandomNext(Random* rng)
+{
+	// xorshift64*
+	rng->state ^= rng->state >> 12;
+	rng->state ^= rng->state << 25;
+	rng->state ^= rng->state >> 27;
+	return rng->state * 0x2545f4914f6cdd1dULL;
+}
+
+
+static uint32_t RandomRange(Random* rng, uint32_t count)
+{
+	return (uint32_t)((RandomNext(rng) >> 32) % count);
+}
+
+
+static int32_t RandomImmediate(Random* rng)
+{
+	// Mostly small constants, as seen in compiled code
+	switch (RandomRange(rng, 4))
+	{
+	case 0:
+		return 0;
+	case 1:
+	case 2:
+		return (int32_t)RandomRange(rng, 0x100) - 0x80;
+	default:
+		return (int32_t)RandomNext(rng);
+	}
+}
+
+
+// Encodings in the 0f 38 and 0f 3a opcode maps and 3DNow! encodings, which the assembler does not
+// emit. The opcode of a 3DNow! encoding is the suffix byte after the operands.
+typedef struct
+{
+	uint8_t prefix;
+	uint8_t map;
+	uint8_t opcode;
+	bool imm8;
+} SSEForm;
+
+static const SSEForm sseForms[] =
+{
+	// SSSE3 and SSE4.1 in the 0f 38 map, and crc32 from SSE4.2
+	{0x66, 0x38, 0x00, false}, {0x00, 0x38, 0x00, false}, {0x66, 0x38, 0x01, false}, {0x66, 0x38, 0x02, false},
+	{0x66, 0x38, 0x04, false}, {0x00, 0x38, 0x04, false}, {0x66, 0x38, 0x05, false}, {0x66, 0x38, 0x08, false},
+	{0x66, 0x38, 0x0b, false}, {0x66, 0x38, 0x10, false}, {0x66, 0x38, 0x17, false}, {0x66, 0x38, 0x1c, false},
+	{0x66, 0x38, 0x1e, false}, {0x66, 0x38, 0x20, false}, {0x66, 0x38, 0x28, false}, {0x66, 0x38, 0x29, false},
+	{0x66, 0x38, 0x2b, false}, {0x66, 0x38, 0x30, false}, {0x66, 0x38, 0x33, false}, {0x66, 0x38, 0x37, false},
+	{0x66, 0x38, 0x39, false}, {0x66, 0x38, 0x3f, false}, {0x66, 0x38, 0x40, false}, {0x66, 0x38, 0x41, false},
+	{0xf2, 0x38, 0xf0, false}, {0xf2, 0x38, 0xf1, false},
+
+	// SSSE3 and SSE4 with an immediate in the 0f 3a map
+	{0x66, 0x3a, 0x08, true}, {0x66, 0x3a, 0x09, true}, {0x66, 0x3a, 0x0a, true}, {0x66, 0x3a, 0x0b, true},
+	{0x66, 0x3a, 0x0c, true}, {0x66, 0x3a, 0x0d, true}, {0x66, 0x3a, 0x0e, true}, {0x66, 0x3a, 0x0f, true},
+	{0x00, 0x3a, 0x0f, true}, {0x66, 0x3a, 0x14, true}, {0x66, 0x3a, 0x16, true}, {0x66, 0x3a, 0x17, true},
+	{0x66, 0x3a, 0x20, true}, {0x66, 0x3a, 0x21, true}, {0x66, 0x3a, 0x22, true}, {0x66, 0x3a, 0x40, true},
+	{0x66, 0x3a, 0x41, true}, {0x66, 0x3a, 0x42, true}, {0x66, 0x3a, 0x60, true}, {0x66, 0x3a, 0x61, true},
+	{0x66, 0x3a, 0x62, true}, {0x66, 0x3a, 0x63, true},
+
+	// 3DNow!
+	{0x00, 0x0f, 0x0d, false}, {0x00, 0x0f, 0x1d, false}, {0x00, 0x0f, 0x90, false}, {0x00, 0x0f, 0x9a, false},
+	{0x00, 0x0f, 0x9e, false}, {0x00, 0x0f, 0xa4, false}, {0x00, 0x0f, 0xb4, false}, {0x00, 0x0f, 0xb7, false},
+	{0x00, 0x0f, 0xbb, false}, {0x00, 0x0f, 0xbf, false}
+};
+
+
+// Emits a random ModRM operand with the given reg field, along with any SIB byte and displacement
+static size_t EmitModRM(Random* rng, uint8_t* code, uint8_t reg)
+{
+	size_t len = 0;
+	uint8_t mod = (uint8_t)RandomRange(rng, 4);
+	uint8_t rm = (uint8_t)RandomRange(rng, 8);
+	size_t dispLen = (mod == 1) ? 1 : ((mod == 2) ? 4 : 0);
+
+	code[len++] = (uint8_t)((mod << 6) | ((reg & 7) << 3) | rm);
+	if (mod == 3)
+		return len;
+	if (rm == 4)
+	{
+		uint8_t sib = (uint8_t)RandomNext(rng);
+		code[len++] = sib;
+		if ((mod == 0) && ((sib & 7) == 5))
+			dispLen = 4;
+	}
+	else if ((mod == 0) && (rm == 5))
+	{
+		dispLen = 4;
+	}
+	for (size_t i = 0; i < dispLen; i++)
+		code[len++] = (uint8_t)RandomNext(rng);
+	return len;
+}
+
+
+static size_t EmitSSEForm(Random* rng, uint8_t* code, uint8_t bits)
+{
+	const SSEForm* form = &sseForms[RandomRange(rng, sizeof(sseForms) / sizeof(sseForms[0]))];
+	size_t len = 0;
+
+	if (form->prefix)
+		code[len++] = form->prefix;
+	if ((bits == 64) && (RandomRange(rng, 4) == 0))
+		code[len++] = (uint8_t)(0x40 | RandomRange(rng, 8));
+	code[len++] = 0x0f;
+	code[len++] = form->map;
+	if (form->map != 0x0f)
+		code[len++] = form->opcode;
+	len += EmitModRM(rng, &code[len], (uint8_t)RandomRange(rng, 8));
+	if (form->map == 0x0f)
+		code[len++] = form->opcode;
+	else if (form->imm8)
+		code[len++] = (uint8_t)RandomNext(rng);
+	return len;
+}
+
+
+#define __BENCH_CORPUS_32BIT
+#include "corpus.h"
+#undef __BENCH_CORPUS_32BIT
+
+#define __BENCH_CORPUS_64BIT
+#include "corpus.h"
+#undef __BENCH_CORPUS_64BIT
+
+
+typedef enum
+{
+	CORPUS_UNIFORM,       // Uniform over the instruction forms
+	CORPUS_COMPILER_MIX,  // Weighted like compiler output
+	CORPUS_SSE,           // Mostly 0f 38, 0f 3a and 3DNow! encodings, in compiler output
+	CORPUS_FILE           // Loaded from a file
+} CorpusKind;
+
+
+typedef struct
+{
+	const char* name;
+	uint8_t bits;
+	CorpusKind kind;
+	uint8_t* code;
+	size_t size;
+	size_t count;
+} Corpus;
+
+
+typedef struct
+{
+	const char* name;
+	size_t corpus;
+	uint8_t mode;
+} CorpusMode;
+
+
+// Functions for each processor mode
+typedef struct
+{
+	bool (*disassemble)(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result);
+	bool (*cachedDisassemble)(X86DecodeCache* cache, const uint8_t* opcode, uint64_t addr, size_t maxLen,
+		Instruction* result);
+	bool (*disassembleWithEncoding)(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result,
+		InstructionEncodingInfo* encoding);
+	size_t (*disassembleToString)(char* out, size_t outMaxLen, const char* fmt, const uint8_t* opcode,
+		uint64_t addr, size_t maxLen, Instruction* instr);
+	size_t (*disassembleBlock)(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+		size_t maxCount, size_t* nextOffset);
+	size_t (*instructionLength)(const uint8_t* opcode, size_t maxLen);
+	size_t (*decodeRangeVisit)(const uint8_t* opcode, uint64_t addr, size_t len, const X86OperationFilter* filter,
+		X86InstructionVisitor visitor, void* context, size_t* nextOffset);
+	void (*initDecoder)(X86Decoder* decoder, const uint8_t* opcode, uint64_t addr, size_t len);
+	size_t (*disassemblePackedBlock)(const uint8_t* opcode, uint64_t addr, size_t len, PackedInstruction* results,
+		size_t maxCount, int64_t* values, size_t maxValues, size_t* valueCount, size_t* nextOffset);
+	size_t (*disassembleColumns)(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionColumns* columns,
+		uint32_t columnMask, size_t maxCount, size_t* nextOffset);
+	size_t (*disassembleRangeToText)(const uint8_t* opcode, uint64_t addr, size_t len, const InstructionFormat* format,
+		TextArena* arena, size_t* nextOffset);
+	size_t (*parallelSweep)(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results, size_t maxCount,
+		X86SweepChunk* chunks, size_t chunkCount, X86TaskRunner runner, void* runnerContext, size_t* nextOffset);
+	bool (*buildControlFlowGraph)(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86ControlFlowGraph* cfg);
+	bool (*buildControlFlowGraphParallel)(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86TaskRunner runner, void* runnerContext,
+		size_t taskCount, X86ControlFlowGraph* cfg);
+} ModeFunctions;
+
+
+static const ModeFunctions mode16Functions =
+{
+	Disassemble16, CachedDisassemble16, DisassembleWithEncoding16, DisassembleToString16, DisassembleBlock16, InstructionLength16, DecodeRangeVisit16, InitDecoder16,
+	DisassemblePackedBlock16, DisassembleColumns16, DisassembleRangeToText16,
+	ParallelSweep16, BuildControlFlowGraph16, BuildControlFlowGraphParallel16
+};
+
+static const ModeFunctions mode32Functions =
+{
+	Disassemble32, CachedDisassemble32, DisassembleWithEncoding32, DisassembleToString32, DisassembleBlock32, InstructionLength32, DecodeRangeVisit32, InitDecoder32,
+	DisassemblePackedBlock32, DisassembleColumns32, DisassembleRangeToText32,
+	ParallelSweep32, BuildControlFlowGraph32, BuildControlFlowGraphParallel32
+};
+
+static const ModeFunctions mode64Functions =
+{
+	Disassemble64, CachedDisassemble64, DisassembleWithEncoding64, DisassembleToString64, DisassembleBlock64, InstructionLength64, DecodeRangeVisit64, InitDecoder64,
+	DisassemblePackedBlock64, DisassembleColumns64, DisassembleRangeToText64,
+	ParallelSweep64, BuildControlFlowGraph64, BuildControlFlowGraphParallel64
+};
+
+
+typedef struct
+{
+	const Corpus* corpus;
+	const ModeFunctions* funcs;
+	Instruction* decoded;
+	size_t decodedCount;
+	uint32_t* instrOffsets;
+	uint32_t* trace;
+	size_t traceCount;
+	X86DecodeCacheEntry* cacheEntries;
+	Instruction* block;
+	PackedInstruction* packed;
+	int64_t* values;
+	uint16_t* operations;
+	uint64_t* regsRead;
+	uint64_t* regsWritten;
+	size_t dependencies;
+	size_t deadFlagWrites;
+	size_t memoryCalls;
+	InstructionFormat format;
+	char* text;
+	Instruction* sweep;
+	X86SweepChunk chunks[MAX_THREADS];
+	size_t threads;
+	uint8_t* cfgMemory;
+	size_t cfgMemorySize;
+	size_t histogram[0x10000];
+	size_t outputBytes;
+} BenchContext;
+
+
+typedef size_t (*BenchFunction)(BenchContext* ctx);
+
+typedef struct
+{
+	const char* name;
+	BenchFunction func;
+} Benchmark;
+
+
+static void GenerateCorpus(Corpus* corpus, size_t count, uint64_t seed)
+{
+	Random rng;
+	uint32_t totalWeight = 0;
+	size_t capacity = (count * X86_MAX_EMIT_LENGTH) + X86_MAX_EMIT_LENGTH;
+	size_t offset = 0;
+
+	rng.state = seed;
+	for (size_t i = 0; i < sizeof(compilerMix) / sizeof(compilerMix[0]); i++)
+		totalWeight += compilerMix[i].weight;
+
+	corpus->code = (uint8_t*)malloc(capacity);
+	for (size_t i = 0; i < count; i++)
+	{
+		InstructionForm form;
+		if ((corpus->kind == CORPUS_SSE) && (RandomRange(&rng, 4) != 0))
+		{
+			offset += EmitSSEForm(&rng, &corpus->code[offset], corpus->bits);
+			continue;
+		}
+
+		if (corpus->kind != CORPUS_UNIFORM)
+		{
+			uint32_t pick = RandomRange(&rng, totalWeight);
+			size_t j = 0;
+			while (pick >= compilerMix[j].weight)
+				pick -= compilerMix[j++].weight;
+			form = compilerMix[j].form;
+		}
+		else
+		{
+			form = (InstructionForm)RandomRange(&rng, FORM_COUNT);
+		}
+
+		if (corpus->bits == 64)
+			offset += EmitForm64(&rng, form, &corpus->code[offset], corpus->code, capacity - X86_MAX_EMIT_LENGTH);
+		else
+			offset += EmitForm32(&rng, form, &corpus->code[offset], corpus->code, capacity - X86_MAX_EMIT_LENGTH);
+	}
+
+	corpus->size = offset;
+	corpus->count = count;
+}
+
+
+static size_t BenchDisassemble(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+	Instruction instr;
+
+	while (offset < size)
+	{
+		if (ctx->funcs->disassemble(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset, &instr))
+		{
+			offset += instr.length;
+			count++;
+		}
+		else
+		{
+			offset++;
+		}
+	}
+
+	ctx->outputBytes = count * sizeof(Instruction);
+	return count;
+}
+
+
+static size_t BenchDisassembleWithEncoding(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+	Instruction instr;
+	InstructionEncodingInfo encoding;
+
+	while (offset < size)
+	{
+		if (ctx->funcs->disassembleWithEncoding(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset, &instr,
+			&encoding))
+		{
+			offset += instr.length;
+			count++;
+		}
+		else
+		{
+			offset++;
+		}
+	}
+
+	ctx->outputBytes = count * (sizeof(Instruction) + sizeof(InstructionEncodingInfo));
+	return count;
+}
+
+
+// Decodes the instructions in the order of the trace, as an emulator would without a cache
+static size_t BenchTraceDisassemble(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t count = 0;
+	Instruction instr;
+
+	for (size_t i = 0; i < ctx->traceCount; i++)
+	{
+		size_t offset = ctx->trace[i];
+		if (ctx->funcs->disassemble(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset, &instr))
+			count++;
+	}
+
+	ctx->outputBytes = count * sizeof(Instruction);
+	return count;
+}
+
+
+// Decodes the instructions in the order of the trace through a decode cache that starts out empty
+static size_t BenchTraceCached(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t count = 0;
+	X86DecodeCache cache;
+	Instruction instr;
+
+	InitDecodeCache(&cache, ctx->cacheEntries, DECODE_CACHE_ENTRIES);
+	for (size_t i = 0; i < ctx->traceCount; i++)
+	{
+		size_t offset = ctx->trace[i];
+		if (ctx->funcs->cachedDisassemble(&cache, &code[offset], CORPUS_BASE_ADDRESS + offset, size - offset,
+			&instr))
+			count++;
+	}
+
+	ctx->outputBytes = count * sizeof(Instruction);
+	return count;
+}
+
+
+static size_t BenchDisassembleToString(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+	size_t chars = 0;
+	Instruction instr;
+	char text[256];
+
+	while (offset < size)
+	{
+		size_t len = ctx->funcs->disassembleToString(text, sizeof(text), FORMAT_STRING, &code[offset],
+			CORPUS_BASE_ADDRESS + offset, size - offset, &instr);
+		if (len)
+		{
+			offset += instr.length;
+			count++;
+		}
+		else
+		{
+			offset++;
+		}
+		chars += len;
+	}
+
+	ctx->outputBytes = chars;
+	return count;
+}
+
+
+static size_t BenchFormatInstructionString(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t offset = 0;
+	size_t count = 0;
+	size_t chars = 0;
+	char text[256];
+
+	for (size_t i = 0; i < ctx->decodedCount; i++)
+	{
+		// Invalid instructions were recorded with a length of zero and are skipped
+		if (ctx->decoded[i].length == 0)
+		{
+			offset++;
+			continue;
+		}
+		chars += FormatInstructionString(text, sizeof(text), FORMAT_STRING, &code[offset],
+			CORPUS_BASE_ADDRESS + offset, &ctx->decoded[i]);
+		offset += ctx->decoded[i].length;
+		count++;
+	}
+
+	ctx->outputBytes = chars;
+	return count;
+}
+
+
+static size_t BenchFormatInstructionStringCompiled(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t offset = 0;
+	size_t count = 0;
+	size_t chars = 0;
+	char text[256];
+
+	for (size_t i = 0; i < ctx->decodedCount; i++)
+	{
+		if (ctx->decoded[i].length == 0)
+		{
+			offset++;
+			continue;
+		}
+		chars += FormatInstructionStringCompiled(text, sizeof(text), &ctx->format, &code[offset],
+			CORPUS_BASE_ADDRESS + offset, &ctx->decoded[i]);
+		offset += ctx->decoded[i].length;
+		count++;
+	}
+
+	ctx->outputBytes = chars;
+	return count;
+}
+
+
+// Discards the text, counting how much was written
+static bool FlushText(TextArena* arena)
+{
+	*(size_t*)arena->context += arena->used;
+	arena->used = 0;
+	return true;
+}
+
+
+static size_t BenchRangeToText(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+	size_t chars = 0;
+	TextArena arena;
+
+	arena.buffer = ctx->text;
+	arena.size = TEXT_ARENA_SIZE;
+	arena.used = 0;
+	arena.flush = FlushText;
+	arena.context = &chars;
+	while (offset < size)
+	{
+		size_t next;
+		count += ctx->funcs->disassembleRangeToText(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset,
+			&ctx->format, &arena, &next);
+		// Stopped at an invalid instruction, skip a byte
+		offset += next + 1;
+	}
+	FlushText(&arena);
+
+	ctx->outputBytes = chars;
+	return count;
+}
+
+
+typedef struct
+{
+	X86TaskFunction func;
+	void* arg;
+	size_t index;
+} Task;
+
+
+static void* RunTask(void* arg)
+{
+	Task* task = (Task*)arg;
+	task->func(task->arg, task->index);
+	return NULL;
+}
+
+
+// Runs the tasks of a parallel sweep or traversal on a thread each
+static void RunThreads(void* context, X86TaskFunction func, void* arg, size_t count)
+{
+	pthread_t threads[MAX_THREADS];
+	Task tasks[MAX_THREADS];
+	(void)context;
+
+	if (count == 0)
+		return;
+	for (size_t i = 0; i < count; i++)
+	{
+		tasks[i].func = func;
+		tasks[i].arg = arg;
+		tasks[i].index = i;
+		if ((i == 0) || (pthread_create(&threads[i], NULL, RunTask, &tasks[i]) != 0))
+			threads[i] = pthread_self();
+	}
+	func(arg, 0);
+	for (size_t i = 1; i < count; i++)
+	{
+		if (pthread_equal(threads[i], pthread_self()))
+			RunTask(&tasks[i]);
+		else
+			pthread_join(threads[i], NULL);
+	}
+}
+
+
+static size_t BenchParallelSweep(BenchContext* ctx)
+{
+	size_t count = ctx->funcs->parallelSweep(ctx->corpus->code, CORPUS_BASE_ADDRESS, ctx->corpus->size, ctx->sweep,
+		ctx->corpus->size, ctx->chunks, ctx->threads, (ctx->threads > 1) ? RunThreads : NULL, NULL, NULL);
+
+	// The sweep includes an entry for each invalid byte, which are not counted
+	size_t valid = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		if (ctx->sweep[i].operation != INVALID)
+			valid++;
+	}
+
+	ctx->outputBytes = count * sizeof(Instruction);
+	return valid;
+}
+
+
+// Recovers the control flow graph from entry points spread evenly through the corpus, and counts the
+// instructions in the blocks found
+static size_t CountControlFlowGraph(BenchContext* ctx, bool parallel)
+{
+	uint64_t entries[CFG_ENTRY_COUNT];
+	X86ControlFlowGraph cfg;
+	size_t count = 0;
+	bool ok;
+
+	// Start each entry on the first instruction at or after its share of the corpus
+	for (size_t i = 0, j = 0, offset = 0; i < CFG_ENTRY_COUNT; i++)
+	{
+		size_t target = (i * ctx->corpus->size) / CFG_ENTRY_COUNT;
+		for (; (offset < target) && (j < ctx->decodedCount); j++)
+			offset += (ctx->decoded[j].length == 0) ? 1 : ctx->decoded[j].length;
+		entries[i] = CORPUS_BASE_ADDRESS + offset;
+	}
+
+	if (parallel)
+	{
+		ok = ctx->funcs->buildControlFlowGraphParallel(ctx->corpus->code, CORPUS_BASE_ADDRESS, ctx->corpus->size,
+			entries, CFG_ENTRY_COUNT, ctx->cfgMemory, ctx->cfgMemorySize, (ctx->threads > 1) ? RunThreads : NULL,
+			NULL, ctx->threads, &cfg);
+	}
+	else
+	{
+		ok = ctx->funcs->buildControlFlowGraph(ctx->corpus->code, CORPUS_BASE_ADDRESS, ctx->corpus->size, entries,
+			CFG_ENTRY_COUNT, ctx->cfgMemory, ctx->cfgMemorySize, &cfg);
+	}
+	if (!ok)
+	{
+		fprintf(stderr, "control flow graph does not fit in %zu bytes\n", ctx->cfgMemorySize);
+		exit(1);
+	}
+
+	for (size_t i = 0; i < cfg.blockCount; i++)
+		count += cfg.blocks[i].instructionCount;
+	ctx->outputBytes = (cfg.blockCount * sizeof(X86BasicBlock)) + (cfg.successorCount * sizeof(uint32_t));
+	return count;
+}
+
+
+static size_t BenchControlFlowGraph(BenchContext* ctx)
+{
+	return CountControlFlowGraph(ctx, false);
+}
+
+
+static size_t BenchControlFlowGraphParallel(BenchContext* ctx)
+{
+	return CountControlFlowGraph(ctx, true);
+}
+
+
+static size_t BenchDisassembleBlock(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+
+	while (offset < size)
+	{
+		size_t next;
+		size_t n = ctx->funcs->disassembleBlock(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset,
+			ctx->block, BLOCK_SIZE, &next);
+		// Skip over an invalid instruction
+		offset += (n < BLOCK_SIZE) ? (next + 1) : next;
+		count += n;
+	}
+
+	ctx->outputBytes = count * sizeof(Instruction);
+	return count;
+}
+
+
+static size_t BenchDecodeNext(BenchContext* ctx)
+{
+	X86Decoder decoder;
+	Instruction instr;
+	size_t count = 0;
+
+	ctx->funcs->initDecoder(&decoder, ctx->corpus->code, CORPUS_BASE_ADDRESS, ctx->corpus->size);
+	while (decoder.len > 0)
+	{
+		if (DecodeNext(&decoder, &instr))
+			count++;
+		else
+			SetDecoderPosition(&decoder, decoder.opcode + 1, decoder.addr + 1, decoder.len - 1);
+	}
+
+	ctx->outputBytes = count * sizeof(Instruction);
+	return count;
+}
+
+
+static size_t BenchInstructionLength(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+
+	while (offset < size)
+	{
+		size_t len = ctx->funcs->instructionLength(&code[offset], size - offset);
+		if (len)
+		{
+			offset += len;
+			count++;
+		}
+		else
+		{
+			offset++;
+		}
+	}
+
+	ctx->outputBytes = count;
+	return count;
+}
+
+
+static bool VisitMemoryCall(void* context, const Instruction* instr, size_t offset)
+{
+	BenchContext* ctx = (BenchContext*)context;
+	(void)offset;
+	if (instr->operands[0].operand == MEM)
+		ctx->memoryCalls++;
+	return true;
+}
+
+
+// Counts the calls through memory, with only the calls decoded in full
+static size_t BenchVisitMemoryCalls(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+	X86OperationFilter filter;
+
+	ClearOperationFilter(&filter);
+	AddOperationToFilter(&filter, CALL);
+	ctx->memoryCalls = 0;
+	while (offset < size)
+	{
+		size_t next;
+		count += ctx->funcs->decodeRangeVisit(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset, &filter,
+			VisitMemoryCall, ctx, &next);
+		offset += next + 1;
+	}
+
+	ctx->outputBytes = 0;
+	return count;
+}
+
+
+static size_t BenchPackedBlock(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+	size_t totalValues = 0;
+
+	while (offset < size)
+	{
+		size_t next;
+		size_t valueCount = 0;
+		size_t n = ctx->funcs->disassemblePackedBlock(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset,
+			ctx->packed, BLOCK_SIZE, ctx->values, BLOCK_SIZE * 3, &valueCount, &next);
+		offset += (n < BLOCK_SIZE) ? (next + 1) : next;
+		count += n;
+		totalValues += valueCount;
+	}
+
+	ctx->outputBytes = (count * sizeof(PackedInstruction)) + (totalValues * sizeof(int64_t));
+	return count;
+}
+
+
+static size_t BenchBlockHistogram(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+
+	memset(ctx->histogram, 0, sizeof(ctx->histogram));
+	while (offset < size)
+	{
+		size_t next;
+		size_t n = ctx->funcs->disassembleBlock(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset,
+			ctx->block, BLOCK_SIZE, &next);
+		for (size_t i = 0; i < n; i++)
+			ctx->histogram[ctx->block[i].operation]++;
+		offset += (n < BLOCK_SIZE) ? (next + 1) : next;
+		count += n;
+	}
+
+	ctx->outputBytes = count * sizeof(Instruction);
+	return count;
+}
+
+
+static size_t BenchColumnsHistogram(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+	InstructionColumns columns;
+
+	memset(&columns, 0, sizeof(columns));
+	columns.operation = ctx->operations;
+	memset(ctx->histogram, 0, sizeof(ctx->histogram));
+	while (offset < size)
+	{
+		size_t next;
+		size_t n = ctx->funcs->disassembleColumns(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset,
+			&columns, X86_COLUMN_OPERATION, BLOCK_SIZE, &next);
+		for (size_t i = 0; i < n; i++)
+			ctx->histogram[ctx->operations[i]]++;
+		offset += (n < BLOCK_SIZE) ? (next + 1) : next;
+		count += n;
+	}
+
+	ctx->outputBytes = count * sizeof(uint16_t);
+	return count;
+}
+
+
+// Counts the instructions that read a register written by the instruction just before them, using
+// the register mask columns
+static size_t BenchColumnsDependencies(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+	uint64_t lastWritten = 0;
+	InstructionColumns columns;
+
+	memset(&columns, 0, sizeof(columns));
+	columns.regsRead = ctx->regsRead;
+	columns.regsWritten = ctx->regsWritten;
+	ctx->dependencies = 0;
+	while (offset < size)
+	{
+		size_t next;
+		size_t n = ctx->funcs->disassembleColumns(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset,
+			&columns, X86_COLUMN_REGS_READ | X86_COLUMN_REGS_WRITTEN, BLOCK_SIZE, &next);
+		for (size_t i = 0; i < n; i++)
+		{
+			if (ctx->regsRead[i] & lastWritten)
+				ctx->dependencies++;
+			lastWritten = ctx->regsWritten[i];
+		}
+		offset += (n < BLOCK_SIZE) ? (next + 1) : next;
+		count += n;
+	}
+
+	ctx->outputBytes = count * sizeof(uint64_t) * 2;
+	return count;
+}
+
+
+// Counts the instructions whose flag results are never read, walking each block backwards from the
+// end with all flags live, as an emulator skipping dead flag computation would. Instructions that may
+// keep the earlier flags, such as shifts by cl, have those flags in the read mask and keep them live.
+static size_t BenchBlockFlagLiveness(BenchContext* ctx)
+{
+	const uint8_t* code = ctx->corpus->code;
+	size_t size = ctx->corpus->size;
+	size_t offset = 0;
+	size_t count = 0;
+
+	ctx->deadFlagWrites = 0;
+	while (offset < size)
+	{
+		size_t next;
+		uint16_t live = X86_EFLAGS_STATUS;
+		size_t n = ctx->funcs->disassembleBlock(&code[offset], CORPUS_BASE_ADDRESS + offset, size - offset,
+			ctx->block, BLOCK_SIZE, &next);
+		for (size_t i = n; i > 0; i--)
+		{
+			X86FlagMasks flags;
+			GetInstructionFlags(&ctx->block[i - 1], &flags);
+			if ((flags.written & X86_EFLAGS_STATUS) && !(flags.written & live))
+				ctx->deadFlagWrites++;
+			live = (live & ~(flags.written | flags.undefined)) | flags.read;
+		}
+		offset += (n < BLOCK_SIZE) ? (next + 1) : next;
+		count += n;
+	}
+
+	ctx->outputBytes = count * sizeof(Instruction);
+	return count;
+}
+
+
+static const Benchmark benchmarks[] =
+{
+	{"disassemble", BenchDisassemble},
+	{"disassemble_with_encoding", BenchDisassembleWithEncoding},
+	{"trace_disassemble", BenchTraceDisassemble},
+	{"trace_cached", BenchTraceCached},
+	{"disassemble_to_string", BenchDisassembleToString},
+	{"format_instruction_string", BenchFormatInstructionString},
+	{"format_instruction_string_compiled", BenchFormatInstructionStringCompiled},
+	{"range_to_text", BenchRangeToText},
+	{"parallel_sweep", BenchParallelSweep},
+	{"cfg", BenchControlFlowGraph},
+	{"cfg_parallel", BenchControlFlowGraphParallel},
+	{"disassemble_block", BenchDisassembleBlock},
+	{"decode_next", BenchDecodeNext},
+	{"instruction_length", BenchInstructionLength},
+	{"visit_memory_calls", BenchVisitMemoryCalls},
+	{"packed_block", BenchPackedBlock},
+	{"block_histogram", BenchBlockHistogram},
+	{"columns_histogram", BenchColumnsHistogram},
+	{"columns_dependencies", BenchColumnsDependencies},
+	{"block_flag_liveness", BenchBlockFlagLiveness}
+};
+
+
+// The last corpus is loaded from the file given with -f, and is skipped without one
+static Corpus corpora[] =
+{
+	{"codegen32", 32, CORPUS_UNIFORM, NULL, 0, 0},
+	{"mix32", 32, CORPUS_COMPILER_MIX, NULL, 0, 0},
+	{"codegen64", 64, CORPUS_UNIFORM, NULL, 0, 0},
+	{"mix64", 64, CORPUS_COMPILER_MIX, NULL, 0, 0},
+	{"sse32", 32, CORPUS_SSE, NULL, 0, 0},
+	{"sse64", 64, CORPUS_SSE, NULL, 0, 0},
+	{"file", 64, CORPUS_FILE, NULL, 0, 0}
+};
+
+#define FILE_CORPUS (sizeof(corpora) / sizeof(corpora[0]) - 1)
+
+
+// The 16-bit benchmarks decode the 32-bit corpus, as the assembler does not emit 16-bit code. The
+// mode of the file corpus is set with -m.
+static CorpusMode corpusModes[] =
+{
+	{"codegen32", 0, 16},
+	{"codegen32", 0, 32},
+	{"mix32", 1, 32},
+	{"sse32", 4, 32},
+	{"codegen64", 2, 64},
+	{"mix64", 3, 64},
+	{"sse64", 5, 64},
+	{"file", FILE_CORPUS, 64}
+};
+
+
+static uint64_t GetTimeNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+
+static uint64_t GetCycles(void)
+{
+#ifdef HAVE_CYCLE_COUNTER
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+
+static const char* GetConfigName(void)
+{
+#if defined(ASMX86_MODE_SPECIALIZED)
+	return "mode_specialized";
+#elif defined(ASMX86_DIRECT_DISPATCH)
+	return "direct_dispatch";
+#else
+	return "default";
+#endif
+}
+
+
+// Generates an instruction address trace like that of an emulator running the corpus. Execution
+// stays in short loops at random places for a number of iterations, so most addresses repeat soon
+// after they are first seen. The trace has as many entries as the corpus has valid instructions.
+static void GenerateTrace(BenchContext* ctx, uint64_t seed)
+{
+	Random rng;
+	size_t validCount = 0;
+	size_t offset = 0;
+
+	for (size_t i = 0; i < ctx->decodedCount; i++)
+	{
+		if (ctx->decoded[i].length)
+		{
+			ctx->instrOffsets[validCount++] = (uint32_t)offset;
+			offset += ctx->decoded[i].length;
+		}
+		else
+		{
+			offset++;
+		}
+	}
+
+	rng.state = seed;
+	ctx->traceCount = 0;
+	while ((validCount > 0) && (ctx->traceCount < validCount))
+	{
+		size_t first = RandomRange(&rng, (uint32_t)validCount);
+		size_t loopLen = 4 + RandomRange(&rng, 60);
+		size_t iterations = 1 + RandomRange(&rng, 50);
+		if ((first + loopLen) > validCount)
+			loopLen = validCount - first;
+		for (size_t i = 0; (i < iterations) && (ctx->traceCount < validCount); i++)
+		{
+			for (size_t j = 0; (j < loopLen) && (ctx->traceCount < validCount); j++)
+				ctx->trace[ctx->traceCount++] = ctx->instrOffsets[first + j];
+		}
+	}
+}
+
+
+static bool MatchesFilter(const char* name, const char* corpus, int argc, char** argv, int firstFilter)
+{
+	if (firstFilter >= argc)
+		return true;
+	for (int i = firstFilter; i < argc; i++)
+	{
+		if (strstr(name, argv[i]) || strstr(corpus, argv[i]))
+			return true;
+	}
+	return false;
+}
+
+
+// Loads raw code bytes from a file, such as a text section extracted with objcopy, as a corpus
+static bool LoadCorpusFile(Corpus* corpus, const char* path)
+{
+	FILE* fp = fopen(path, "rb");
+	long size;
+
+	if (!fp)
+		return false;
+	if ((fseek(fp, 0, SEEK_END) != 0) || ((size = ftell(fp)) <= 0) || (fseek(fp, 0, SEEK_SET) != 0))
+	{
+		fclose(fp);
+		return false;
+	}
+
+	corpus->code = (uint8_t*)malloc((size_t)size);
+	if ((!corpus->code) || (fread(corpus->code, 1, (size_t)size, fp) != (size_t)size))
+	{
+		free(corpus->code);
+		corpus->code = NULL;
+		fclose(fp);
+		return false;
+	}
+
+	fclose(fp);
+	corpus->size = (size_t)size;
+	corpus->count = 0;
+	return true;
+}
+
+
+static void Usage(const char* name)
+{
+	fprintf(stderr, "usage: %s [-n instructions] [-r repetitions] [-t threads] [-f file] [-m mode] [filter...]\n",
+		name);
+	exit(1);
+}
+
+
+int main(int argc, char** argv)
+{
+	size_t count = DEFAULT_INSTRUCTION_COUNT;
+	size_t repetitions = DEFAULT_REPETITIONS;
+	size_t threads = 1;
+	int firstFilter = 1;
+	const char* file = NULL;
+	unsigned long fileMode = 64;
+	size_t maxSize = 0;
+	BenchContext* ctx;
+
+	while (firstFilter < argc)
+	{
+		if ((strcmp(argv[firstFilter], "-n") == 0) && ((firstFilter + 1) < argc))
+			count = (size_t)strtoul(argv[firstFilter + 1], NULL, 0);
+		else if ((strcmp(argv[firstFilter], "-r") == 0) && ((firstFilter + 1) < argc))
+			repetitions = (size_t)strtoul(argv[firstFilter + 1], NULL, 0);
+		else if ((strcmp(argv[firstFilter], "-t") == 0) && ((firstFilter + 1) < argc))
+			threads = (size_t)strtoul(argv[firstFilter + 1], NULL, 0);
+		else if ((strcmp(argv[firstFilter], "-f") == 0) && ((firstFilter + 1) < argc))
+			file = argv[firstFilter + 1];
+		else if ((strcmp(argv[firstFilter], "-m") == 0) && ((firstFilter + 1) < argc))
+			fileMode = strtoul(argv[firstFilter + 1], NULL, 0);
+		else if (argv[firstFilter][0] == '-')
+			Usage(argv[0]);
+		else
+			break;
+		firstFilter += 2;
+	}
+	if ((count == 0) || (repetitions == 0) || (threads == 0) || (threads > MAX_THREADS))
+		Usage(argv[0]);
+	if ((fileMode != 16) && (fileMode != 32) && (fileMode != 64))
+		Usage(argv[0]);
+
+	for (size_t i = 0; i < sizeof(corpora) / sizeof(corpora[0]); i++)
+	{
+		if (i == FILE_CORPUS)
+		{
+			if (!file)
+				continue;
+			if (!LoadCorpusFile(&corpora[i], file))
+			{
+				fprintf(stderr, "%s: unable to read %s\n", argv[0], file);
+				return 1;
+			}
+			corpora[i].bits = (uint8_t)fileMode;
+			corpusModes[(sizeof(corpusModes) / sizeof(corpusModes[0])) - 1].mode = (uint8_t)fileMode;
+		}
+		else
+		{
+			GenerateCorpus(&corpora[i], count, 0x5eed0000 + i);
+		}
+		if (corpora[i].size > maxSize)
+			maxSize = corpora[i].size;
+	}
+
+	// There is at most one instruction per byte of the largest corpus
+	ctx = (BenchContext*)calloc(1, sizeof(BenchContext));
+	ctx->decoded = (Instruction*)malloc(sizeof(Instruction) * maxSize);
+	ctx->instrOffsets = (uint32_t*)malloc(sizeof(uint32_t) * maxSize);
+	ctx->trace = (uint32_t*)malloc(sizeof(uint32_t) * maxSize);
+	ctx->cacheEntries = (X86DecodeCacheEntry*)malloc(sizeof(X86DecodeCacheEntry) * DECODE_CACHE_ENTRIES);
+	ctx->block = (Instruction*)malloc(sizeof(Instruction) * BLOCK_SIZE);
+	ctx->packed = (PackedInstruction*)malloc(sizeof(PackedInstruction) * BLOCK_SIZE);
+	ctx->values = (int64_t*)malloc(sizeof(int64_t) * BLOCK_SIZE * 3);
+	ctx->operations = (uint16_t*)malloc(sizeof(uint16_t) * BLOCK_SIZE);
+	ctx->regsRead = (uint64_t*)malloc(sizeof(uint64_t) * BLOCK_SIZE);
+	ctx->regsWritten = (uint64_t*)malloc(sizeof(uint64_t) * BLOCK_SIZE);
+	ctx->text = (char*)malloc(TEXT_ARENA_SIZE);
+	ctx->sweep = (Instruction*)malloc(sizeof(Instruction) * maxSize);
+	ctx->threads = threads;
+	ctx->cfgMemorySize = maxSize * CFG_MEMORY_PER_BYTE;
+	ctx->cfgMemory = (uint8_t*)malloc(ctx->cfgMemorySize);
+	CompileInstructionFormat(&ctx->format, FORMAT_STRING);
+
+	printf("# asmx86 benchmark\n");
+	printf("# config\t%s\n", GetConfigName());
+	printf("# instructions_per_corpus\t%zu\n", count);
+	printf("# repetitions\t%zu\n", repetitions);
+	printf("# sweep_threads\t%zu\n", threads);
+	printf("# cycles are time stamp counter ticks, best of all repetitions\n");
+	printf("benchmark\tcorpus\tmode\tinstructions\tbytes\tns_per_instr\tinstr_per_sec\tcycles_per_instr\t"
+		"out_bytes_per_instr\n");
+
+	for (size_t c = 0; c < sizeof(corpusModes) / sizeof(corpusModes[0]); c++)
+	{
+		const CorpusMode* cm = &corpusModes[c];
+		const Corpus* corpus = &corpora[cm->corpus];
+		size_t offset = 0;
+
+		if (!corpus->code)
+			continue;
+		ctx->corpus = corpus;
+		if (cm->mode == 16)
+			ctx->funcs = &mode16Functions;
+		else if (cm->mode == 32)
+			ctx->funcs = &mode32Functions;
+		else
+			ctx->funcs = &mode64Functions;
+
+		// Decode the corpus up front for the formatting benchmark
+		ctx->decodedCount = 0;
+		while (offset < corpus->size)
+		{
+			Instruction* instr = &ctx->decoded[ctx->decodedCount++];
+			if (ctx->funcs->disassemble(&corpus->code[offset], CORPUS_BASE_ADDRESS + offset, corpus->size - offset,
+				instr))
+				offset += instr->length;
+			else
+			{
+				instr->length = 0;
+				offset++;
+			}
+		}
+		GenerateTrace(ctx, TRACE_SEED + c);
+
+		for (size_t b = 0; b < sizeof(benchmarks) / sizeof(benchmarks[0]); b++)
+		{
+			const Benchmark* bench = &benchmarks[b];
+			uint64_t bestNs = 0;
+			uint64_t bestCycles = 0;
+			size_t instrCount;
+
+			if (!MatchesFilter(bench->name, cm->name, argc, argv, firstFilter))
+				continue;
+
+			// Warm up caches and branch predictors before timing
+			instrCount = bench->func(ctx);
+			for (size_t r = 0; r < repetitions; r++)
+			{
+				uint64_t startNs = GetTimeNs();
+				uint64_t startCycles = GetCycles();
+				bench->func(ctx);
+				uint64_t cycles = GetCycles() - startCycles;
+				uint64_t ns = GetTimeNs() - startNs;
+				if ((r == 0) || (ns < bestNs))
+					bestNs = ns;
+				if ((r == 0) || (cycles < bestCycles))
+					bestCycles = cycles;
+			}
+
+			printf("%s\t%s\t%d\t%zu\t%zu\t%.2f\t%.0f\t%.1f\t%.1f\n", bench->name, cm->name, cm->mode, instrCount,
+				corpus->size, (double)bestNs / (double)instrCount,
+				bestNs ? ((double)instrCount * 1e9 / (double)bestNs) : 0.0,
+				(double)bestCycles / (double)instrCount, (double)ctx->outputBytes / (double)instrCount);
+			fflush(stdout);
+		}
+	}
+
+	for (size_t i = 0; i < sizeof(corpora) / sizeof(corpora[0]); i++)
+		free(corpora[i].code);
+	free(ctx->decoded);
+	free(ctx->instrOffsets);
+	free(ctx->trace);
+	free(ctx->cacheEntries);
+	free(ctx->block);
+	free(ctx->packed);
+	free(ctx->values);
+	free(ctx->operations);
+	free(ctx->regsRead);
+	free(ctx->regsWritten);
+	free(ctx->text);
+	free(ctx->sweep);
+	free(ctx->cfgMemory);
+	free(ctx);
+	return 0;
+}
@@ -0,0 +1,309 @@
+// Copyright (c) 2006-2015, Rusty Wagner
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+// the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+//      following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+//      the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Corpus generator. This file is included by bench.c once for 32-bit code and once for 64-bit code,
+// with __BENCH_CORPUS_32BIT or __BENCH_CORPUS_64BIT defined. Instructions are emitted with the
+// codegenx86.h assembler, so every generated encoding is valid.
+
+#ifdef __CORPUS
+#undef __CORPUS
+#undef __EMIT
+#undef __EMIT_R
+#undef __EMIT_M
+#undef __EMIT_I
+#undef __EMIT_P
+#undef __EMIT_RR
+#undef __EMIT_RM
+#undef __EMIT_MR
+#undef __EMIT_RI
+#undef __EMIT_MI
+#undef __EMIT_RRI
+#undef __GPR_COUNT
+#undef __MEM_OPERAND
+#endif
+
+#if defined(__BENCH_CORPUS_32BIT)
+#define __CORPUS(n) n ## 32
+#define __EMIT X86_EMIT32
+#define __EMIT_R X86_EMIT32_R
+#define __EMIT_M X86_EMIT32_M
+#define __EMIT_I X86_EMIT32_I
+#define __EMIT_P X86_EMIT32_P
+#define __EMIT_RR X86_EMIT32_RR
+#define __EMIT_RM X86_EMIT32_RM
+#define __EMIT_MR X86_EMIT32_MR
+#define __EMIT_RI X86_EMIT32_RI
+#define __EMIT_MI X86_EMIT32_MI
+#define __EMIT_RRI X86_EMIT32_RRI
+#define __GPR_COUNT 8
+#else
+#define __CORPUS(n) n ## 64
+#define __EMIT X86_EMIT64
+#define __EMIT_R X86_EMIT64_R
+#define __EMIT_M X86_EMIT64_M
+#define __EMIT_I X86_EMIT64_I
+#define __EMIT_P X86_EMIT64_P
+#define __EMIT_RR X86_EMIT64_RR
+#define __EMIT_RM X86_EMIT64_RM
+#define __EMIT_MR X86_EMIT64_MR
+#define __EMIT_RI X86_EMIT64_RI
+#define __EMIT_MI X86_EMIT64_MI
+#define __EMIT_RRI X86_EMIT64_RRI
+#define __GPR_COUNT 16
+#endif
+
+#define __MEM_OPERAND X86_MEM_INDEX(mem.base, mem.index, mem.scale, mem.offset)
+
+
+	static OperandType __CORPUS(RandomReg32)(Random* rng)
+	{
+		return (OperandType)(REG_EAX + RandomRange(rng, __GPR_COUNT));
+	}
+
+
+	static OperandType __CORPUS(RandomRegNative)(Random* rng)
+	{
+#ifdef __BENCH_CORPUS_64BIT
+		return (OperandType)(REG_RAX + RandomRange(rng, __GPR_COUNT));
+#else
+		return (OperandType)(REG_EAX + RandomRange(rng, __GPR_COUNT));
+#endif
+	}
+
+
+	static OperandType __CORPUS(RandomReg8)(Random* rng)
+	{
+		// AL through BL can be used with or without a REX prefix
+		return (OperandType)(REG_AL + RandomRange(rng, 4));
+	}
+
+
+	static MemOperand __CORPUS(RandomMem)(Random* rng)
+	{
+		MemOperand mem;
+		uint32_t form = RandomRange(rng, 8);
+
+#ifdef __BENCH_CORPUS_64BIT
+		if (form == 0)
+		{
+			mem.base = REG_RIP;
+			mem.index = NONE;
+			mem.scale = 1;
+			mem.offset = (int32_t)RandomRange(rng, 0x100000);
+			return mem;
+		}
+#endif
+
+		mem.base = __CORPUS(RandomRegNative)(rng);
+		mem.index = NONE;
+		mem.scale = 1;
+		if (form >= 6)
+		{
+			do
+			{
+				mem.index = __CORPUS(RandomRegNative)(rng);
+			} while ((mem.index == REG_ESP) || (mem.index == REG_RSP));
+			mem.scale = (uint8_t)(1 << RandomRange(rng, 4));
+		}
+
+		switch (RandomRange(rng, 4))
+		{
+		case 0:
+			mem.offset = 0;
+			break;
+		case 1:
+		case 2:
+			mem.offset = (int32_t)RandomRange(rng, 0x100) - 0x80;
+			break;
+		default:
+			mem.offset = (int32_t)RandomRange(rng, 0x100000);
+			break;
+		}
+		return mem;
+	}
+
+
+	// Emits one instruction of the given form and returns its length. The target of branches is a
+	// random location within the corpus.
+	static size_t __CORPUS(EmitForm)(Random* rng, InstructionForm form, uint8_t* code, uint8_t* start, size_t size)
+	{
+		MemOperand mem = __CORPUS(RandomMem)(rng);
+		OperandType a = __CORPUS(RandomReg32)(rng);
+		OperandType b = __CORPUS(RandomReg32)(rng);
+		OperandType wa = __CORPUS(RandomRegNative)(rng);
+		OperandType wb = __CORPUS(RandomRegNative)(rng);
+		OperandType xa = (OperandType)(REG_XMM0 + RandomRange(rng, 8));
+		OperandType xb = (OperandType)(REG_XMM0 + RandomRange(rng, 8));
+		int32_t imm = RandomImmediate(rng);
+		uint8_t* target = start + RandomRange(rng, (uint32_t)size);
+
+		switch (form)
+		{
+		case FORM_MOV_RR:
+			return __EMIT_RR(code, mov_32, a, b);
+		case FORM_MOV_RM:
+			return __EMIT_RM(code, mov_32, a, __MEM_OPERAND);
+		case FORM_MOV_MR:
+			return __EMIT_MR(code, mov_32, __MEM_OPERAND, a);
+		case FORM_MOV_RI:
+			return __EMIT_RI(code, mov_32, a, imm);
+		case FORM_MOV_MI:
+			return __EMIT_MI(code, mov_32, __MEM_OPERAND, imm);
+		case FORM_MOV8_RM:
+			return __EMIT_RM(code, mov_8, __CORPUS(RandomReg8)(rng), __MEM_OPERAND);
+		case FORM_MOV8_MR:
+			return __EMIT_MR(code, mov_8, __MEM_OPERAND, __CORPUS(RandomReg8)(rng));
+		case FORM_MOV16_MR:
+			return __EMIT_MR(code, mov_16, __MEM_OPERAND, (OperandType)(REG_AX + (a - REG_EAX)));
+#ifdef __BENCH_CORPUS_64BIT
+		case FORM_MOV_NATIVE_RR:
+			return __EMIT_RR(code, mov_64, wa, wb);
+		case FORM_MOV_NATIVE_RM:
+			return __EMIT_RM(code, mov_64, wa, __MEM_OPERAND);
+		case FORM_MOV_NATIVE_MR:
+			return __EMIT_MR(code, mov_64, __MEM_OPERAND, wa);
+		case FORM_LEA:
+			return __EMIT_RM(code, lea_64, wa, __MEM_OPERAND);
+		case FORM_ALU_NATIVE_RI:
+			return RandomRange(rng, 2) ? __EMIT_RI(code, add_64, wa, imm) :
+				__EMIT_RI(code, sub_64, wa, imm);
+		case FORM_MOVSXD:
+			return __EMIT_RM(code, movsxd_64_32, wa, __MEM_OPERAND);
+#else
+		case FORM_MOV_NATIVE_RR:
+			return __EMIT_RR(code, mov_32, wa, wb);
+		case FORM_MOV_NATIVE_RM:
+			return __EMIT_RM(code, mov_32, wa, __MEM_OPERAND);
+		case FORM_MOV_NATIVE_MR:
+			return __EMIT_MR(code, mov_32, __MEM_OPERAND, wa);
+		case FORM_LEA:
+			return __EMIT_RM(code, lea_32, wa, __MEM_OPERAND);
+		case FORM_ALU_NATIVE_RI:
+			return RandomRange(rng, 2) ? __EMIT_RI(code, add_32, wa, imm) :
+				__EMIT_RI(code, sub_32, wa, imm);
+		case FORM_MOVSXD:
+			return __EMIT_RM(code, movsx_32_16, a, __MEM_OPERAND);
+#endif
+		case FORM_ALU_RR:
+			switch (RandomRange(rng, 4))
+			{
+			case 0:
+				return __EMIT_RR(code, add_32, a, b);
+			case 1:
+				return __EMIT_RR(code, sub_32, a, b);
+			case 2:
+				return __EMIT_RR(code, and_32, a, b);
+			default:
+				return __EMIT_RR(code, xor_32, a, b);
+			}
+		case FORM_ALU_RM:
+			return RandomRange(rng, 2) ? __EMIT_RM(code, add_32, a, __MEM_OPERAND) :
+				__EMIT_RM(code, or_32, a, __MEM_OPERAND);
+		case FORM_ALU_MR:
+			return RandomRange(rng, 2) ? __EMIT_MR(code, add_32, __MEM_OPERAND, a) :
+				__EMIT_MR(code, sub_32, __MEM_OPERAND, a);
+		case FORM_ALU_RI:
+			return RandomRange(rng, 2) ? __EMIT_RI(code, and_32, a, imm) :
+				__EMIT_RI(code, adc_32, a, imm);
+		case FORM_ALU_MI:
+			return RandomRange(rng, 2) ? __EMIT_MI(code, add_32, __MEM_OPERAND, imm) :
+				__EMIT_MI(code, sbb_32, __MEM_OPERAND, imm);
+		case FORM_CMP_RR:
+			return __EMIT_RR(code, cmp_32, a, b);
+		case FORM_CMP_RI:
+			return __EMIT_RI(code, cmp_32, a, imm);
+		case FORM_CMP_MI:
+			return __EMIT_MI(code, cmp_32, __MEM_OPERAND, imm);
+		case FORM_TEST_RR:
+			return __EMIT_RR(code, test_32, a, b);
+		case FORM_INC_DEC:
+			return RandomRange(rng, 2) ? __EMIT_R(code, inc_32, a) : __EMIT_M(code, dec_32, __MEM_OPERAND);
+		case FORM_NEG_NOT:
+			return RandomRange(rng, 2) ? __EMIT_R(code, neg_32, a) : __EMIT_R(code, not_32, a);
+		case FORM_SHIFT:
+			switch (RandomRange(rng, 3))
+			{
+			case 0:
+				return __EMIT_RI(code, shl_32, a, (uint8_t)RandomRange(rng, 32));
+			case 1:
+				return __EMIT_RI(code, sar_32, a, (uint8_t)RandomRange(rng, 32));
+			default:
+				return __EMIT_RR(code, shr_32, a, REG_CL);
+			}
+		case FORM_IMUL:
+			return RandomRange(rng, 2) ? __EMIT_RR(code, imul_32, a, b) : __EMIT_RRI(code, imul_32, a, b, imm);
+		case FORM_DIV:
+			return RandomRange(rng, 2) ? __EMIT_R(code, div_32, a) : __EMIT_M(code, idiv_32, __MEM_OPERAND);
+		case FORM_MOVZX:
+			return __EMIT_RM(code, movzx_32_8, a, __MEM_OPERAND);
+		case FORM_MOVSX:
+			return __EMIT_RR(code, movsx_32_16, a, (OperandType)(REG_AX + (b - REG_EAX)));
+		case FORM_SETCC:
+			return __EMIT_R(code, setne, __CORPUS(RandomReg8)(rng));
+		case FORM_CMOV:
+			return __EMIT_RR(code, cmovl_32, a, b);
+		case FORM_BT:
+			return __EMIT_RI(code, bt_32, a, (uint8_t)RandomRange(rng, 32));
+		case FORM_BSWAP:
+			return __EMIT_R(code, bswap_32, a);
+		case FORM_XADD:
+			return __EMIT_MR(code, lock_xadd_32, __MEM_OPERAND, a);
+		case FORM_PUSH:
+			return RandomRange(rng, 4) ? __EMIT_R(code, push, wa) : __EMIT_I(code, push, imm);
+		case FORM_POP:
+			return __EMIT_R(code, pop, wa);
+		case FORM_JCC:
+			switch (RandomRange(rng, 4))
+			{
+			case 0:
+				return __EMIT_P(code, je, target);
+			case 1:
+				return __EMIT_P(code, jne, target);
+			case 2:
+				return __EMIT_P(code, jl, target);
+			default:
+				return __EMIT_P(code, jbe, target);
+			}
+		case FORM_JMP:
+			return __EMIT_P(code, jmpn, target);
+		case FORM_CALL:
+			return __EMIT_P(code, calln, target);
+		case FORM_CALL_INDIRECT:
+			return RandomRange(rng, 2) ? __EMIT_R(code, calln, wa) : __EMIT_M(code, calln, __MEM_OPERAND);
+		case FORM_RET:
+			return __EMIT(code, retn);
+		case FORM_LEAVE:
+			return __EMIT(code, leave);
+		case FORM_NOP:
+			return __EMIT(code, nop);
+		case FORM_CDQ:
+			return __EMIT(code, cdq);
+		case FORM_STRING:
+			return RandomRange(rng, 2) ? __EMIT(code, rep_stos_32) : __EMIT(code, rep_mov_8);
+		case FORM_SSE_RR:
+			return RandomRange(rng, 2) ? __EMIT_RR(code, addsd, xa, xb) : __EMIT_RR(code, mulsd, xa, xb);
+		case FORM_SSE_RM:
+			return __EMIT_RM(code, movsd, xa, __MEM_OPERAND);
+		case FORM_SSE_CVT:
+			return __EMIT_RR(code, cvtsi2sd_32, xa, a);
+		default:
+			return __EMIT(code, nop);
+		}
+	}
@@ -1,7 +1,8 @@
+from __future__ import print_function
 import sys
 
 if len(sys.argv) < 2:
-	print "Usage: %s <header-file> [<output-file>]"
+	print("Usage: %s <header-file> [<output-file>]" % sys.argv[0])
 	sys.exit(1)
 
 hdr = open(sys.argv[1], "r")
@@ -10,9 +11,16 @@ operation = False
 operand = False
 
 operation_list = []
+operation_names = []
 operand_list = []
+defines = {}
 
 for line in hdr:
+	if line.startswith("#define X86_OP_") or line.startswith("#define X86_ACCESS_") or \
+		line.startswith("#define X86_OPERATION_FILTER_WORDS") or \
+		(line.startswith("#define X86_EFLAGS_") and line.split()[2].startswith("0x")):
+		parts = line.split()
+		defines[parts[1]] = int(parts[2], 0)
 	if ("enum InstructionOperation" in line) and ("typedef" not in line):
 		operation = True
 	elif ("enum OperandType" in line) and ("typedef" not in line):
@@ -26,6 +34,8 @@ for line in hdr:
 			text = part.split("=")[0].strip().lower()
 			if len(text) == 0:
 				continue
+			if operation:
+				operation_names.append(part.split("=")[0].strip())
 			if text in ["invalid", "none", "imm", "mem"]:
 				text = ""
 			if text.startswith("__x86_oper(reg_"):
@@ -40,16 +50,373 @@ if len(sys.argv) > 2:
 else:
 	out = sys.stdout
 
-out.write("static const char* operationString[] = {\n");
-for i in xrange(0, len(operation_list)):
+def write_table(name, define, strings):
+	# All strings are stored back to back in a single blob, without terminators, and found using
+	# offset and length tables. This avoids a table of pointers that needs relocating at load time.
+	offsets = []
+	offset = 0
+	out.write("static const char %sStringData[] =\n" % name)
+	for text in strings:
+		offsets.append(offset)
+		offset += len(text)
+		if len(text) > 0:
+			out.write('\t"%s"\n' % text)
+	out.write(";\n")
+	if offset > 0xffff:
+		print("String table %s is too large for 16-bit offsets" % name)
+		sys.exit(1)
+
+	out.write("static const uint16_t %sStringOffset[] = {\n" % name)
+	for i in range(0, len(offsets)):
+		if i > 0:
+			out.write(",\n")
+		out.write('\t%d' % offsets[i])
+	out.write("\n};\n")
+
+	out.write("static const uint8_t %sStringLength[] = {\n" % name)
+	for i in range(0, len(strings)):
+		if i > 0:
+			out.write(",\n")
+		out.write('\t%d' % len(strings[i]))
+	out.write("\n};\n")
+	out.write("#define %s %d\n" % (define, max([len(s) for s in strings])))
+
+if len(operation_names) > (defines["X86_OPERATION_FILTER_WORDS"] * 64):
+	print("Too many operations for X86OperationFilter")
+	sys.exit(1)
+
+write_table("operation", "MAX_OPERATION_STRING_LENGTH", operation_list)
+write_table("operand", "MAX_OPERAND_STRING_LENGTH", operand_list)
+
+
+def operations(names):
+	result = []
+	for name in names.split():
+		if name not in operation_names:
+			print("Unknown operation %s" % name)
+			sys.exit(1)
+		result.append(name)
+	return result
+
+conditional_branches = "JO JNO JB JAE JE JNE JBE JA JS JNS JPE JPO JL JGE JLE JG JCXZ JECXZ JRCXZ LOOP LOOPE LOOPNE"
+string_operations = ("MOVSB MOVSW MOVSD MOVSQ CMPSB CMPSW CMPSD CMPSQ SCASB SCASW SCASD SCASQ LODSB LODSW LODSD LODSQ "
+	"STOSB STOSW STOSD STOSQ INSB INSW INSD INSQ OUTSB OUTSW OUTSD OUTSQ")
+
+operation_attributes = {
+	"X86_OP_BRANCH": operations("JMP JMPF " + conditional_branches),
+	"X86_OP_CONDITIONAL": operations(conditional_branches + " CMOVO CMOVNO CMOVB CMOVAE CMOVE CMOVNE CMOVBE CMOVA "
+		"CMOVS CMOVNS CMOVPE CMOVPO CMOVL CMOVGE CMOVLE CMOVG SETO SETNO SETB SETAE SETE SETNE SETBE SETA SETS "
+		"SETNS SETPE SETPO SETL SETGE SETLE SETG FCMOVB FCMOVBE FCMOVE FCMOVNB FCMOVNBE FCMOVNE FCMOVNU FCMOVU"),
+	"X86_OP_CALL": operations("CALL CALLF"),
+	"X86_OP_RETURN": operations("RETN RETF IRET SYSRET SYSEXIT"),
+	"X86_OP_INTERRUPT": operations("INT INT1 INT3 INTO SYSCALL SYSENTER"),
+	"X86_OP_PRIVILEGED": operations("CLTS HLT INVD WBINVD INVLPG LGDT LIDT LLDT LTR LMSW RDMSR WRMSR RDPMC SWAPGS "
+		"SYSEXIT SYSRET XSETBV MONITOR MWAIT CLI STI IN OUT INSB INSW INSD INSQ OUTSB OUTSW OUTSD OUTSQ CLAC STAC "
+		"GETSEC ENCLS RSM VMREAD VMWRITE VMCLEAR VMLAUNCH VMPTRLD VMPTRST VMRESUME VMXOFF VMXON"),
+	"X86_OP_STRING": operations(string_operations),
+	"X86_OP_IO": operations("IN OUT INSB INSW INSD INSQ OUTSB OUTSW OUTSD OUTSQ"),
+	"X86_OP_STACK": operations("PUSH POP PUSHA PUSHAD POPA POPAD PUSHF PUSHFD PUSHFQ POPF POPFD POPFQ ENTER LEAVE "
+		"CALL CALLF RETN RETF IRET"),
+	"X86_OP_NO_FALLTHROUGH": operations("JMP JMPF RETN RETF IRET SYSRET SYSEXIT HLT UD2 RSM"),
+	"X86_OP_FPU": [name for name in operation_names if name.startswith("F") and (name != "FEMMS")]
+}
+
+# Access of each operand in order: r is read, w is written, rw is read and written, and - is not
+# accessed. Operations that are decoded with differing numbers of operands give a pattern for each
+# count. Operations not listed read and write their first operand and read the rest. Conditional
+# moves are read and written, as the destination is kept when the condition is false.
+default_access = "rw r r"
+operand_access = {}
+
+def access(pattern, names):
+	for name in operations(names):
+		operand_access[name] = pattern
+
+access("", "INVALID")
+access("r", "PUSH CALL CALLF JMP JMPF RETN RETF INT DIV IDIV MUL LLDT LTR LGDT LIDT LMSW VERR VERW LDMXCSR "
+	"FXRSTOR XRSTOR VMPTRLD VMCLEAR VMXON FLD FILD FBLD FLDCW FLDENV FRSTOR " + conditional_branches)
+access("w", "POP SETO SETNO SETB SETAE SETE SETNE SETBE SETA SETS SETNS SETPE SETPO SETL SETGE SETLE SETG "
+	"SGDT SIDT SLDT SMSW STR STMXCSR FXSAVE XSAVE VMPTRST FST FSTP FIST FISTP FISTTP FBSTP FSTCW FSTSW FSTDW FSTSG "
+	"FSTENV FSAVE FFREE FFREEP")
+access("-", "NOP MMXNOP PREFETCH PREFETCHNTA PREFETCHT0 PREFETCHT1 PREFETCHT2 PREFETCHW CLFLUSH INVLPG")
+access("w -", "LEA")
+access("r r", "CMP TEST BT BOUND ENTER OUT OUTSB OUTSW OUTSD OUTSQ CMPSB CMPSW CMPSQ SCASB SCASW SCASD SCASQ "
+	"VMWRITE COMISD COMISS UCOMISD UCOMISS PTEST MASKMOVQ MASKMOVDQU FCOM FCOMP FCOMPP FCOMI FCOMIP FUCOM FUCOMP "
+	"FUCOMPP FUCOMI FUCOMIP FICOM FICOMP FTST")
+access("r r r", "PCMPESTRI PCMPESTRM PCMPISTRI PCMPISTRM")
+access("w r", "MOV MOVZX MOVSX MOVSXD MOVNTI BSF BSR POPCNT LAR LSL LDS LES LFS LGS LSS IN INSB INSW INSD INSQ "
+	"LODSB LODSW LODSD LODSQ STOSB STOSW STOSD STOSQ MOVSB MOVSW MOVSD MOVSQ XLAT VMREAD "
+	"MOVD MOVQ MOVAPS MOVAPD MOVUPS MOVUPD MOVSS MOVDQA MOVDQU MOVDDUP MOVSHDUP MOVSLDUP "
+	"MOVHPS MOVHPD MOVLPS MOVLPD MOVMSKPS MOVMSKPD PMOVMSKB MOVNTDQ MOVNTDQA MOVNTPD MOVNTPS MOVNTQ MOVDQ2Q "
+	"MOVQ2DQ LDDQU PMOVSXBD PMOVSXBQ PMOVSXDQ PMOVSXBW PMOVSXWD PMOVSXWQ PMOVZXBD PMOVZXBQ PMOVZXDQ PMOVZXBW "
+	"PMOVZXWD PMOVZXWQ CVTDQ2PD CVTDQ2PS CVTPD2DQ CVTPD2PI CVTPD2PS CVTPI2PD CVTPS2DQ CVTPS2PD "
+	"CVTPS2PI CVTSD2SI CVTSS2SI CVTTPD2DQ CVTTPD2PI CVTTPS2DQ CVTTPS2PI "
+	"CVTTSD2SI CVTTSS2SI RCPPS RSQRTPS SQRTPS SQRTPD PABSB PABSD PABSW PHMINPOSUW PF2ID PF2IW PI2FD PI2FW "
+	"PFRCP PFRSQRT PSWAPD")
+# These write part of an XMM register and keep the rest, so the destination is read as well
+access("rw r", "MOVHLPS MOVLHPS CVTPI2PS CVTSD2SS CVTSI2SD CVTSI2SS CVTSS2SD")
+access("w r r", "PSHUFD PSHUFHW PSHUFLW PSHUFW PEXTRB PEXTRW PEXTRD PEXTRQ EXTRACTPS ROUNDPS ROUNDPD")
+access("rw rw", "XCHG XADD FXCH")
+access("rw", "INC DEC NEG NOT BSWAP CMPXCH8B CMPXCH16B")
+access({1: "r", 2: "rw r", 3: "w r r"}, "IMUL")
+access({1: "r", 2: "rw r"}, "FADD FSUB FSUBR FMUL FDIV FDIVR")
+access({2: "r r", 3: "rw r r"}, "CMPSD")
+
+# The partial moves keep the rest of an XMM destination, but only when it is a register, and the scalar
+# moves only when the source is a register as well, as a scalar load from memory clears the rest. These
+# rules are applied by SetOperandAccess, and must match ACCESS_PARTIAL_WRITE and ACCESS_REGISTER_SOURCE.
+partial_write_access = 0x1000
+register_source_access = 0x2000
+partial_write = {}
+for name in operations("MOVLPS MOVHPS MOVLPD MOVHPD"):
+	partial_write[name] = partial_write_access
+for name in operations("MOVSS MOVSD"):
+	partial_write[name] = partial_write_access | register_source_access
+
+access_bits = {"-": defines["X86_ACCESS_NONE"], "r": defines["X86_ACCESS_READ"],
+	"w": defines["X86_ACCESS_WRITE"], "rw": defines["X86_ACCESS_READ_WRITE"]}
+
+def encode_access(pattern):
+	# Each operand count has its own field: bits 0-1 for one operand, 2-5 for two, and 6-11 for three
+	if not isinstance(pattern, dict):
+		roles = pattern.split()
+		pattern = {}
+		for count in range(1, len(roles) + 1):
+			pattern[count] = " ".join(roles[0:count])
+	result = 0
+	for count in pattern:
+		shift = [0, 0, 2, 6][count]
+		roles = pattern[count].split()
+		for i in range(0, len(roles)):
+			result |= access_bits[roles[i]] << (shift + (i * 2))
+	return result
+
+out.write("const uint16_t X86OperationAttributes[] = {\n")
+for i in range(0, len(operation_names)):
+	flags = [define for define in sorted(operation_attributes) if operation_names[i] in operation_attributes[define]]
+	value = 0
+	for define in flags:
+		value |= defines[define]
+	out.write("\t0x%.4x%s" % (value, "," if i < (len(operation_names) - 1) else ""))
+	if len(flags) > 0:
+		out.write(" // %s: %s" % (operation_names[i], " ".join(flags)))
+	out.write("\n")
+out.write("};\n")
+
+out.write("static const uint16_t operationOperandAccess[] = {\n")
+for i in range(0, len(operation_names)):
 	if i > 0:
 		out.write(",\n")
-	out.write('\t"%s"' % operation_list[i])
+	out.write("\t0x%.4x" % (encode_access(operand_access.get(operation_names[i], default_access)) |
+		partial_write.get(operation_names[i], 0)))
 out.write("\n};\n")
 
-out.write("static const char* operandString[] = {\n");
-for i in xrange(0, len(operand_list)):
+
+# Flags read, set to a defined value, and left undefined by each operation, as strings of flag
+# names. Flags that are cleared or set to a constant are defined. Shifts and rotates list the
+# overflow flag as defined, which is only true for a count of one; GetInstructionFlags refines
+# the masks using the count operand. The string forms of movsd and cmpsd are described by the
+# byte sized operations, as the SSE operations of the same name do not use the flags.
+operation_flags = {}
+
+def eflags(read, written, undefined, names):
+	for name in operations(names):
+		operation_flags[name] = (read, written, undefined)
+
+status_flags = "cf pf af zf sf of"
+all_flags = status_flags + " tf if df"
+conditions = {"O": "of", "NO": "of", "B": "cf", "AE": "cf", "E": "zf", "NE": "zf", "BE": "cf zf", "A": "cf zf",
+	"S": "sf", "NS": "sf", "PE": "pf", "PO": "pf", "L": "sf of", "GE": "sf of", "LE": "zf sf of", "G": "zf sf of"}
+for condition in conditions:
+	eflags(conditions[condition], "", "", "J%s CMOV%s SET%s" % (condition, condition, condition))
+fpu_conditions = {"B": "cf", "NB": "cf", "E": "zf", "NE": "zf", "BE": "cf zf", "NBE": "cf zf", "U": "pf", "NU": "pf"}
+for condition in fpu_conditions:
+	eflags(fpu_conditions[condition], "", "", "FCMOV%s" % condition)
+
+eflags("", status_flags, "", "ADD SUB CMP NEG XADD CMPXCHG POPCNT COMISS COMISD UCOMISS UCOMISD PTEST "
+	"PCMPESTRI PCMPESTRM PCMPISTRI PCMPISTRM FCOMI FCOMIP FUCOMI FUCOMIP VMREAD VMWRITE VMCLEAR VMLAUNCH "
+	"VMPTRLD VMPTRST VMRESUME VMXOFF VMXON VMCALL VMFUNC")
+eflags("cf", status_flags, "", "ADC SBB")
+eflags("", "pf af zf sf of", "", "INC DEC")
+eflags("", "cf pf zf sf of", "af", "AND OR XOR TEST SHL SHR SAR SHLD SHRD")
+eflags("", "cf of", "", "ROL ROR")
+eflags("cf", "cf of", "", "RCL RCR")
+eflags("", "cf of", "pf af zf sf", "MUL IMUL")
+eflags("", "", status_flags, "DIV IDIV")
+eflags("", "cf", "pf af sf of", "BT BTS BTR BTC")
+eflags("", "zf", "cf pf af sf of", "BSF BSR")
+eflags("", "zf", "", "LAR LSL VERR VERW ARPL CMPXCH8B CMPXCH16B")
+eflags("af", "af cf", "pf zf sf of", "AAA AAS")
+eflags("", "pf zf sf", "cf af of", "AAD AAM")
+eflags("af cf", "cf pf af zf sf", "of", "DAA DAS")
+eflags("", "cf", "", "CLC STC")
+eflags("cf", "cf", "", "CMC")
+eflags("cf", "", "", "SALC")
+eflags("", "df", "", "CLD STD")
+eflags("", "if", "", "CLI STI SYSENTER")
+eflags("cf pf af zf sf", "", "", "LAHF")
+eflags("", "cf pf af zf sf", "", "SAHF")
+eflags(all_flags, "", "", "PUSHF PUSHFD PUSHFQ")
+eflags("", all_flags, "", "POPF POPFD POPFQ IRET SYSRET RSM")
+eflags(all_flags, all_flags, "", "SYSCALL")
+eflags("", "tf if", "", "INT INT1 INT3")
+eflags("of", "tf if", "", "INTO")
+eflags("zf", "", "", "LOOPE LOOPNE")
+eflags("df", "", "", "MOVSB MOVSW MOVSQ LODSB LODSW LODSD LODSQ STOSB STOSW STOSD STOSQ INSB INSW INSD INSQ "
+	"OUTSB OUTSW OUTSD OUTSQ")
+eflags("df", status_flags, "", "CMPSB CMPSW CMPSQ SCASB SCASW SCASD SCASQ")
+
+def encode_flags(names):
+	result = 0
+	for name in names.split():
+		result |= defines["X86_EFLAGS_" + name.upper()]
+	return result
+
+out.write("const X86FlagMasks X86OperationFlags[] = {\n")
+for i in range(0, len(operation_names)):
+	read, written, undefined = operation_flags.get(operation_names[i], ("", "", ""))
+	out.write("\t{0x%.3x, 0x%.3x, 0x%.3x}%s\n" % (encode_flags(read), encode_flags(written),
+		encode_flags(undefined), "," if i < (len(operation_names) - 1) else ""))
+out.write("};\n")
+
+
+# Bit in the register masks for each register, matching the X86_REG_MASK_* definitions in asmx86.h
+gpr_names = [["al", "ax", "eax", "rax"], ["cl", "cx", "ecx", "rcx"], ["dl", "dx", "edx", "rdx"],
+	["bl", "bx", "ebx", "rbx"], ["spl", "sp", "esp", "rsp"], ["bpl", "bp", "ebp", "rbp"],
+	["sil", "si", "esi", "rsi"], ["dil", "di", "edi", "rdi"]]
+for i in range(8, 16):
+	gpr_names.append(["r%db" % i, "r%dw" % i, "r%dd" % i, "r%d" % i])
+gpr_names[0].append("ah")
+gpr_names[1].append("ch")
+gpr_names[2].append("dh")
+gpr_names[3].append("bh")
+
+register_bits = {"rip": 54, "flags": 55}
+for i in range(0, 16):
+	for name in gpr_names[i]:
+		register_bits[name] = i
+	register_bits["xmm%d" % i] = 16 + i
+	register_bits["cr%d" % i] = 56
+	register_bits["dr%d" % i] = 57
+	register_bits["tr%d" % i] = 58
+for i in range(0, 8):
+	register_bits["mm%d" % i] = 32 + i
+	register_bits["st%d" % i] = 40 + i
+for i, name in enumerate(["es", "cs", "ss", "ds", "fs", "gs"]):
+	register_bits[name] = 48 + i
+
+out.write("static const uint8_t operandRegisterBit[] = {\n")
+for i in range(0, len(operand_list)):
+	if i > 0:
+		out.write(",\n")
+	if len(operand_list[i]) == 0:
+		out.write("\t0xff")
+	else:
+		out.write("\t%d" % register_bits[operand_list[i]])
+out.write("\n};\n")
+
+# Registers used implicitly by each operation, as a string of registers read and a string of
+# registers written. Operands that are listed in the instruction are not included. Forms that
+# differ from these are handled by GetRegisterMasks: byte sized multiplies and divides that do not
+# use rdx, imul with more than one operand, the rcx count of a rep prefix, and the string forms of
+# movsd and cmpsd, which are also SSE operations. The flags bit is set from the flag tables above.
+implicit_registers = {}
+
+def implicit(read, written, names):
+	for name in operations(names):
+		implicit_registers[name] = (read, written)
+
+implicit("rsp", "rsp", "PUSH POP CALL CALLF RETN RETF PUSHF PUSHFD PUSHFQ POPF POPFD POPFQ")
+implicit("rsp rax rcx rdx rbx rbp rsi rdi", "rsp", "PUSHA PUSHAD")
+implicit("rsp", "rsp rax rcx rdx rbx rbp rsi rdi", "POPA POPAD")
+implicit("rsp", "rsp cs ss", "IRET")
+implicit("rsp rbp", "rsp rbp", "ENTER")
+implicit("rbp", "rsp rbp", "LEAVE")
+implicit("", "rcx r11", "SYSCALL")
+implicit("rcx r11", "", "SYSRET")
+implicit("rcx rdx", "rsp", "SYSEXIT")
+
+implicit("rax", "rax rdx", "MUL IMUL")
+implicit("rax rdx", "rax rdx", "DIV IDIV")
+implicit("rax", "rax", "CBW CWDE CDQE")
+implicit("rax", "rdx", "CWD CDQ CQO")
+implicit("rax", "rax", "AAA AAS DAA DAS AAD AAM")
+implicit("", "rax", "LAHF SALC")
+implicit("rax", "", "SAHF")
+implicit("rax", "rax", "CMPXCHG")
+implicit("rax rdx rbx rcx", "rax rdx", "CMPXCH8B CMPXCH16B")
+
+implicit("rax rcx", "rax rbx rcx rdx", "CPUID")
+implicit("", "rax rdx", "RDTSC")
+implicit("", "rax rdx rcx", "RDTSCP")
+implicit("rcx", "rax rdx", "RDPMC RDMSR XGETBV")
+implicit("rcx rax rdx", "", "WRMSR XSETBV")
+implicit("rax rdx", "", "XSAVE XRSTOR")
+implicit("rax rcx rdx", "", "MONITOR")
+implicit("rax rcx", "", "MWAIT")
+
+implicit("rcx", "rcx", "LOOP")
+implicit("rcx", "rcx", "LOOPE LOOPNE")
+implicit("rcx", "", "JCXZ JECXZ JRCXZ")
+
+# The registers that string operations address memory with are part of the memory operands, and are
+# also advanced in the direction given by the flags
+implicit("", "rsi rdi", "MOVSB MOVSW MOVSQ")
+implicit("", "rsi rdi", "CMPSB CMPSW CMPSQ")
+implicit("", "rdi", "SCASB SCASW SCASD SCASQ")
+implicit("", "rsi", "LODSB LODSW LODSD LODSQ OUTSB OUTSW OUTSD OUTSQ")
+implicit("", "rdi", "STOSB STOSW STOSD STOSQ INSB INSW INSD INSQ")
+
+implicit("rax rdx", "rcx", "PCMPESTRI")
+implicit("", "rcx", "PCMPISTRI")
+implicit("rax rdx", "xmm0", "PCMPESTRM")
+implicit("", "xmm0", "PCMPISTRM")
+implicit("xmm0", "", "BLENDVPD BLENDVPS PBLENDVB")
+implicit("rdi", "", "MASKMOVQ MASKMOVDQU")
+
+# The x87 register stack is modelled as accesses to st0, the top of the stack
+implicit("", "st0", "FLD FILD FBLD FLD1 FLDL2E FLDL2T FLDLG2 FLDLN2 FLDPI FLDZ")
+implicit("st0", "", "FST FSTP FIST FISTP FISTTP FBSTP FCOM FCOMP FUCOM FUCOMP FICOM FICOMP FTST FXAM")
+implicit("st0 st1", "", "FCOMPP FUCOMPP")
+implicit("st0", "st0", "FADD FSUB FSUBR FMUL FDIV FDIVR FIADD FISUB FISUBR FIMUL FIDIV FIDIVR FCHS FABS FSQRT "
+	"FRNDINT FSIN FCOS F2XM1 FXTRACT")
+implicit("st0", "st0 st1", "FPTAN FSINCOS")
+implicit("st0 st1", "st0", "FSCALE FPREM FPREM1")
+implicit("st0 st1", "st1", "FPATAN FYL2X FYL2XP1")
+
+def encode_registers(names):
+	result = 0
+	for name in names.split():
+		result |= 1 << register_bits[name]
+	return result
+
+# Operations share entries in a table of unique masks, so that the mask table stays small
+implicit_masks = [(0, 0)]
+implicit_index = []
+for name in operation_names:
+	read, written = implicit_registers.get(name, ("", ""))
+	flags = operation_flags.get(name, ("", "", ""))
+	if len(flags[0]) > 0:
+		read += " flags"
+	if len(flags[1]) > 0 or len(flags[2]) > 0:
+		written += " flags"
+	masks = (encode_registers(read), encode_registers(written))
+	if masks not in implicit_masks:
+		implicit_masks.append(masks)
+	implicit_index.append(implicit_masks.index(masks))
+if len(implicit_masks) > 0x100:
+	print("Too many implicit register masks")
+	sys.exit(1)
+
+out.write("static const X86RegisterMasks implicitRegisterMasks[] = {\n")
+for i in range(0, len(implicit_masks)):
+	if i > 0:
+		out.write(",\n")
+	out.write("\t{0x%.16xULL, 0x%.16xULL}" % implicit_masks[i])
+out.write("\n};\n")
+out.write("static const uint8_t operationImplicitRegisters[] = {\n")
+for i in range(0, len(implicit_index)):
 	if i > 0:
 		out.write(",\n")
-	out.write('\t"%s"' % operand_list[i])
+	out.write("\t%d" % implicit_index[i])
 out.write("\n};\n")
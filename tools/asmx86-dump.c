@@ -0,0 +1,505 @@
+// Copyright (c) 2006-2015, Rusty Wagner
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+// the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+//      following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+//      the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+// Command line disassembler for the executable sections of ELF files. Run "make asmx86-dump" to
+// build it. The file is mapped into memory and each section is disassembled with
+// DisassembleRangeToText into a large output buffer that is written out as it fills. With -j,
+// sections are split into pieces at instruction boundaries and the pieces are formatted by
+// worker threads.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <elf.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "asmx86.h"
+
+#define OUTPUT_BUFFER_SIZE  (1 << 20)
+#define PIECE_SIZE          (1 << 20)
+#define PIECE_BUFFER_SIZE   (PIECE_SIZE * 8)
+#define MAX_THREADS         64
+
+// Longest line written for a byte that is not a valid instruction
+#define MAX_INVALID_LINE_LENGTH 32
+
+
+typedef size_t (*RangeToTextFunction)(const uint8_t* opcode, uint64_t addr, size_t len,
+	const InstructionFormat* format, TextArena* arena, size_t* nextOffset);
+
+typedef struct
+{
+	RangeToTextFunction rangeToText;
+	size_t (*instructionLength)(const uint8_t* opcode, size_t maxLen);
+	InstructionFormat format;
+	int addressWidth;
+	size_t minRoom;
+} Dumper;
+
+
+typedef struct
+{
+	char name[64];
+	const uint8_t* code;
+	uint64_t addr;
+	size_t size;
+} CodeSection;
+
+
+typedef struct
+{
+	const Dumper* dumper;
+	const uint8_t* code;
+	uint64_t addr;
+	size_t size;
+	TextArena arena;
+	bool ok;
+} Piece;
+
+
+static bool WriteAll(int fd, const char* data, size_t len)
+{
+	while (len > 0)
+	{
+		ssize_t written = write(fd, data, len);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+		data += written;
+		len -= (size_t)written;
+	}
+	return true;
+}
+
+
+static bool FlushToOutput(TextArena* arena)
+{
+	if (!WriteAll(STDOUT_FILENO, arena->buffer, arena->used))
+		return false;
+	arena->used = 0;
+	return true;
+}
+
+
+// Pieces formatted by worker threads are kept in memory until they can be written in order, so the
+// piece buffer grows instead of being written out
+static bool GrowPieceBuffer(TextArena* arena)
+{
+	size_t size = arena->size * 2;
+	char* buffer = (char*)realloc(arena->buffer, size);
+	if (!buffer)
+		return false;
+	arena->buffer = buffer;
+	arena->size = size;
+	return true;
+}
+
+
+static bool MakeRoom(TextArena* arena, size_t room)
+{
+	if ((arena->size - arena->used) > room)
+		return true;
+	if (!arena->flush(arena))
+		return false;
+	return (arena->size - arena->used) > room;
+}
+
+
+static bool DumpRange(const Dumper* dumper, const uint8_t* code, uint64_t addr, size_t size, TextArena* arena)
+{
+	size_t offset = 0;
+	while (offset < size)
+	{
+		size_t next;
+		int len;
+
+		dumper->rangeToText(&code[offset], addr + offset, size - offset, &dumper->format, arena, &next);
+		offset += next;
+		if (offset >= size)
+			break;
+
+		// Disassembly stops at invalid instructions and when the output could not be flushed
+		if (dumper->instructionLength(&code[offset], size - offset) != 0)
+			return false;
+		if (!MakeRoom(arena, dumper->minRoom))
+			return false;
+		len = snprintf(&arena->buffer[arena->used], arena->size - arena->used, "%0*" PRIx64 "  (bad)   0x%02x\n",
+			dumper->addressWidth, addr + offset, code[offset]);
+		arena->used += (size_t)len;
+		offset++;
+	}
+	return true;
+}
+
+
+// Returns the offset of the first instruction boundary at or after target, following the same
+// path through invalid bytes as DumpRange
+static size_t FindInstructionBoundary(const Dumper* dumper, const uint8_t* code, size_t size, size_t start,
+	size_t target)
+{
+	size_t offset = start;
+	while ((offset < target) && (offset < size))
+	{
+		size_t len = dumper->instructionLength(&code[offset], size - offset);
+		offset += (len != 0) ? len : 1;
+	}
+	return (offset > size) ? size : offset;
+}
+
+
+static void* DumpPiece(void* arg)
+{
+	Piece* piece = (Piece*)arg;
+	piece->ok = DumpRange(piece->dumper, piece->code, piece->addr, piece->size, &piece->arena);
+	return NULL;
+}
+
+
+static bool DumpSectionParallel(const Dumper* dumper, const CodeSection* section, TextArena* output,
+	size_t threadCount)
+{
+	Piece pieces[MAX_THREADS];
+	pthread_t threads[MAX_THREADS];
+	size_t offset = 0;
+	bool ok = true;
+
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		pieces[i].dumper = dumper;
+		pieces[i].arena.buffer = (char*)malloc(PIECE_BUFFER_SIZE);
+		pieces[i].arena.size = PIECE_BUFFER_SIZE;
+		pieces[i].arena.flush = GrowPieceBuffer;
+		pieces[i].arena.context = NULL;
+		if (!pieces[i].arena.buffer)
+			ok = false;
+	}
+
+	// Everything before the pieces has to be written first
+	if (ok)
+		ok = FlushToOutput(output);
+
+	while (ok && (offset < section->size))
+	{
+		size_t count = 0;
+
+		// Piece boundaries are found with the length decoder, which is much faster than formatting, so
+		// that every piece starts on the same instruction as a sequential disassembly would
+		while ((count < threadCount) && (offset < section->size))
+		{
+			size_t end = FindInstructionBoundary(dumper, section->code, section->size, offset, offset + PIECE_SIZE);
+			pieces[count].code = &section->code[offset];
+			pieces[count].addr = section->addr + offset;
+			pieces[count].size = end - offset;
+			pieces[count].arena.used = 0;
+			offset = end;
+			count++;
+		}
+
+		for (size_t i = 1; i < count; i++)
+		{
+			if (pthread_create(&threads[i], NULL, DumpPiece, &pieces[i]) != 0)
+			{
+				// Run the piece on this thread instead
+				threads[i] = pthread_self();
+			}
+		}
+		DumpPiece(&pieces[0]);
+		for (size_t i = 1; i < count; i++)
+		{
+			if (pthread_equal(threads[i], pthread_self()))
+				DumpPiece(&pieces[i]);
+			else
+				pthread_join(threads[i], NULL);
+		}
+
+		for (size_t i = 0; i < count; i++)
+		{
+			if (ok && !pieces[i].ok)
+				ok = false;
+			if (ok && !WriteAll(STDOUT_FILENO, pieces[i].arena.buffer, pieces[i].arena.used))
+				ok = false;
+		}
+	}
+
+	for (size_t i = 0; i < threadCount; i++)
+		free(pieces[i].arena.buffer);
+	return ok;
+}
+
+
+static bool DumpSection(const Dumper* dumper, const CodeSection* section, TextArena* output, size_t threadCount)
+{
+	int len;
+
+	if (!MakeRoom(output, sizeof(section->name) + 64))
+		return false;
+	len = snprintf(&output->buffer[output->used], output->size - output->used,
+		"\nDisassembly of section %s:\n\n", section->name);
+	output->used += (size_t)len;
+
+	if ((threadCount > 1) && (section->size > PIECE_SIZE))
+		return DumpSectionParallel(dumper, section, output, threadCount);
+	return DumpRange(dumper, section->code, section->addr, section->size, output);
+}
+
+
+static bool ReadSectionHeader(const uint8_t* file, size_t fileSize, bool elf64, uint64_t offset, uint32_t* name,
+	uint32_t* type, uint64_t* flags, uint64_t* addr, uint64_t* dataOffset, uint64_t* size)
+{
+	if (elf64)
+	{
+		Elf64_Shdr shdr;
+		if ((offset > fileSize) || ((fileSize - offset) < sizeof(shdr)))
+			return false;
+		memcpy(&shdr, &file[offset], sizeof(shdr));
+		*name = shdr.sh_name;
+		*type = shdr.sh_type;
+		*flags = shdr.sh_flags;
+		*addr = shdr.sh_addr;
+		*dataOffset = shdr.sh_offset;
+		*size = shdr.sh_size;
+	}
+	else
+	{
+		Elf32_Shdr shdr;
+		if ((offset > fileSize) || ((fileSize - offset) < sizeof(shdr)))
+			return false;
+		memcpy(&shdr, &file[offset], sizeof(shdr));
+		*name = shdr.sh_name;
+		*type = shdr.sh_type;
+		*flags = shdr.sh_flags;
+		*addr = shdr.sh_addr;
+		*dataOffset = shdr.sh_offset;
+		*size = shdr.sh_size;
+	}
+	return true;
+}
+
+
+// Finds the executable sections of a little endian x86 ELF file. Returns the number of sections,
+// or -1 if the file is not supported.
+static ssize_t FindCodeSections(const uint8_t* file, size_t fileSize, CodeSection** sections, uint8_t* mode)
+{
+	bool elf64;
+	uint16_t machine;
+	uint64_t shoff;
+	uint16_t shentsize, shnum, shstrndx;
+	uint32_t strName, strType;
+	uint64_t strFlags, strAddr, strOffset, strSize;
+	ssize_t count = 0;
+
+	if ((fileSize < EI_NIDENT) || (memcmp(file, ELFMAG, SELFMAG) != 0) || (file[EI_DATA] != ELFDATA2LSB))
+		return -1;
+
+	if (file[EI_CLASS] == ELFCLASS64)
+	{
+		Elf64_Ehdr ehdr;
+		if (fileSize < sizeof(ehdr))
+			return -1;
+		memcpy(&ehdr, file, sizeof(ehdr));
+		elf64 = true;
+		machine = ehdr.e_machine;
+		shoff = ehdr.e_shoff;
+		shentsize = ehdr.e_shentsize;
+		shnum = ehdr.e_shnum;
+		shstrndx = ehdr.e_shstrndx;
+	}
+	else if (file[EI_CLASS] == ELFCLASS32)
+	{
+		Elf32_Ehdr ehdr;
+		if (fileSize < sizeof(ehdr))
+			return -1;
+		memcpy(&ehdr, file, sizeof(ehdr));
+		elf64 = false;
+		machine = ehdr.e_machine;
+		shoff = ehdr.e_shoff;
+		shentsize = ehdr.e_shentsize;
+		shnum = ehdr.e_shnum;
+		shstrndx = ehdr.e_shstrndx;
+	}
+	else
+		return -1;
+
+	if (machine == EM_X86_64)
+		*mode = 64;
+	else if (machine == EM_386)
+		*mode = 32;
+	else
+		return -1;
+
+	if ((shentsize < (elf64 ? sizeof(Elf64_Shdr) : sizeof(Elf32_Shdr))) || (shstrndx >= shnum))
+		return -1;
+	if (!ReadSectionHeader(file, fileSize, elf64, shoff + ((uint64_t)shstrndx * shentsize), &strName, &strType,
+		&strFlags, &strAddr, &strOffset, &strSize))
+		return -1;
+	if ((strOffset > fileSize) || (strSize > (fileSize - strOffset)))
+		return -1;
+
+	*sections = (CodeSection*)calloc(shnum, sizeof(CodeSection));
+	if (!*sections)
+		return -1;
+
+	for (uint16_t i = 0; i < shnum; i++)
+	{
+		uint32_t name, type;
+		uint64_t flags, addr, offset, size;
+		CodeSection* section = &(*sections)[count];
+
+		if (!ReadSectionHeader(file, fileSize, elf64, shoff + ((uint64_t)i * shentsize), &name, &type, &flags,
+			&addr, &offset, &size))
+			break;
+		if ((type != SHT_PROGBITS) || (!(flags & SHF_EXECINSTR)))
+			continue;
+		if ((offset > fileSize) || (size > (fileSize - offset)))
+			continue;
+
+		if (name < strSize)
+		{
+			size_t maxName = strSize - name;
+			if (maxName > (sizeof(section->name) - 1))
+				maxName = sizeof(section->name) - 1;
+			strncpy(section->name, (const char*)&file[strOffset + name], maxName);
+		}
+		section->code = &file[offset];
+		section->addr = addr;
+		section->size = (size_t)size;
+		count++;
+	}
+	return count;
+}
+
+
+static void Usage(const char* name)
+{
+	fprintf(stderr, "Usage: %s [-j threads] [-f format] <elf-file>\n", name);
+	fprintf(stderr, "The format uses the FormatInstructionString specifiers, default \"%%<width>a  %%7i %%o\"\n");
+	exit(1);
+}
+
+
+int main(int argc, char* argv[])
+{
+	const char* fmt = NULL;
+	size_t threadCount = 1;
+	char defaultFormat[32];
+	struct stat st;
+	uint8_t* file;
+	CodeSection* sections;
+	ssize_t sectionCount;
+	uint8_t mode;
+	Dumper dumper;
+	TextArena output;
+	bool ok = true;
+	int fd;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "j:f:")) != -1)
+	{
+		if (opt == 'j')
+		{
+			threadCount = (size_t)strtoul(optarg, NULL, 0);
+			if ((threadCount == 0) || (threadCount > MAX_THREADS))
+				Usage(argv[0]);
+		}
+		else if (opt == 'f')
+			fmt = optarg;
+		else
+			Usage(argv[0]);
+	}
+	if (optind != (argc - 1))
+		Usage(argv[0]);
+
+	fd = open(argv[optind], O_RDONLY);
+	if (fd < 0)
+	{
+		perror(argv[optind]);
+		return 1;
+	}
+	if ((fstat(fd, &st) < 0) || (st.st_size == 0))
+	{
+		fprintf(stderr, "%s: not a valid file\n", argv[optind]);
+		return 1;
+	}
+	file = (uint8_t*)mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (file == MAP_FAILED)
+	{
+		perror(argv[optind]);
+		return 1;
+	}
+	madvise(file, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+	sectionCount = FindCodeSections(file, (size_t)st.st_size, &sections, &mode);
+	if (sectionCount < 0)
+	{
+		fprintf(stderr, "%s: not a little endian x86 ELF file\n", argv[optind]);
+		return 1;
+	}
+
+	if (mode == 64)
+	{
+		dumper.rangeToText = DisassembleRangeToText64;
+		dumper.instructionLength = InstructionLength64;
+		dumper.addressWidth = 16;
+	}
+	else
+	{
+		dumper.rangeToText = DisassembleRangeToText32;
+		dumper.instructionLength = InstructionLength32;
+		dumper.addressWidth = 8;
+	}
+	snprintf(defaultFormat, sizeof(defaultFormat), "%%%da  %%7i %%o", dumper.addressWidth);
+	if (!CompileInstructionFormat(&dumper.format, fmt ? fmt : defaultFormat))
+	{
+		fprintf(stderr, "Format string is too long\n");
+		return 1;
+	}
+	dumper.minRoom = (dumper.format.maxLength > MAX_INVALID_LINE_LENGTH) ? dumper.format.maxLength :
+		MAX_INVALID_LINE_LENGTH;
+
+	output.buffer = (char*)malloc(OUTPUT_BUFFER_SIZE);
+	output.size = OUTPUT_BUFFER_SIZE;
+	output.used = 0;
+	output.flush = FlushToOutput;
+	output.context = NULL;
+	if (!output.buffer)
+		return 1;
+
+	for (ssize_t i = 0; ok && (i < sectionCount); i++)
+		ok = DumpSection(&dumper, &sections[i], &output, threadCount);
+	if (ok)
+		ok = FlushToOutput(&output);
+	if (!ok)
+		fprintf(stderr, "Error writing output\n");
+
+	free(output.buffer);
+	free(sections);
+	munmap(file, (size_t)st.st_size);
+	return ok ? 0 : 1;
+}
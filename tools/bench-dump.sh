@@ -0,0 +1,35 @@
+#!/bin/sh
+# Compares the time taken by asmx86-dump and "objdump -d" to disassemble the executable sections of
+# an ELF file. Run with "make dump-bench", or directly with the file to disassemble and an optional
+# thread count: tools/bench-dump.sh <elf-file> [threads]
+
+FILE=${1:-$(command -v objdump)}
+THREADS=${2:-$(nproc 2>/dev/null || echo 1)}
+DUMP=$(dirname "$0")/asmx86-dump
+
+if [ ! -x "$DUMP" ]; then
+	echo "Build asmx86-dump first with \"make asmx86-dump\"" >&2
+	exit 1
+fi
+
+# Returns the best wall clock time in seconds of three runs of the given command
+best_time() {
+	best=""
+	for run in 1 2 3; do
+		start=$(date +%s.%N)
+		"$@" > /dev/null || exit 1
+		end=$(date +%s.%N)
+		best=$(echo "$start $end $best" | awk '{ t = $2 - $1; if ($3 == "" || t < $3) print t; else print $3 }')
+	done
+	echo "$best"
+}
+
+echo "# file	$FILE"
+echo "# size	$(wc -c < "$FILE")"
+echo "# lines	$("$DUMP" "$FILE" | wc -l)"
+echo "tool	seconds"
+echo "objdump	$(best_time objdump -d -M intel --no-show-raw-insn "$FILE")"
+echo "asmx86-dump	$(best_time "$DUMP" "$FILE")"
+if [ "$THREADS" -gt 1 ]; then
+	echo "asmx86-dump -j $THREADS	$(best_time "$DUMP" -j "$THREADS" "$FILE")"
+fi
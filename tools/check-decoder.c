@@ -0,0 +1,604 @@
+// Copyright (c) 2006-2015, Rusty Wagner
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification, are permitted provided that
+// the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice, this list of conditions and the
+//      following disclaimer.
+//    * Redistributions in binary form must reproduce the above copyright notice, this list of conditions and
+//      the following disclaimer in the documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED
+// WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+// PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+// NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Differential check of the decoders that must agree with the full disassembler. The length
+// decoder has its own copy of the rules for which encodings are valid, and DecodeRangeVisit,
+// ParallelSweep and asmx86-dump -j rely on it finding the same instruction boundaries. The block
+// decoders use the copy of the decoder without bounds checks. ParallelSweep is checked against a
+// serial sweep, and BuildControlFlowGraphParallel against BuildControlFlowGraph, with the tasks run
+// out of order. The register masks of partial register writes are checked against a table. Run
+// with "make check", which builds and runs this for each decoder build option. The optional
+// argument is the number of random buffers to check in each mode.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "asmx86.h"
+
+#define DEFAULT_BUFFER_COUNT 32
+#define BUFFER_SIZE          0x10000
+#define BLOCK_SIZE           256
+#define CHECK_ADDRESS        0x1000
+#define MAX_FAILURES         20
+#define MAX_SWEEP_CHUNKS     64
+#define MAX_GRAPH_TASKS      16
+#define GRAPH_ENTRY_COUNT    2048
+#define GRAPH_MEMORY_SIZE    (BUFFER_SIZE * 128)
+
+
+typedef struct
+{
+	const char* name;
+	bool (*disassemble)(const uint8_t* opcode, uint64_t addr, size_t maxLen, Instruction* result);
+	size_t (*instructionLength)(const uint8_t* opcode, size_t maxLen);
+	size_t (*disassembleBlock)(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results,
+		size_t maxCount, size_t* nextOffset);
+	size_t (*instructionLengthBlock)(const uint8_t* opcode, size_t len, uint8_t* lengths, size_t maxCount,
+		size_t* nextOffset);
+	size_t (*decodeRangeVisit)(const uint8_t* opcode, uint64_t addr, size_t len, const X86OperationFilter* filter,
+		X86InstructionVisitor visitor, void* context, size_t* nextOffset);
+	size_t (*parallelSweep)(const uint8_t* opcode, uint64_t addr, size_t len, Instruction* results, size_t maxCount,
+		X86SweepChunk* chunks, size_t chunkCount, X86TaskRunner runner, void* runnerContext, size_t* nextOffset);
+	bool (*buildControlFlowGraph)(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86ControlFlowGraph* cfg);
+	bool (*buildControlFlowGraphParallel)(const uint8_t* opcode, uint64_t addr, size_t len, const uint64_t* entries,
+		size_t entryCount, void* memory, size_t memorySize, X86TaskRunner runner, void* runnerContext,
+		size_t taskCount, X86ControlFlowGraph* cfg);
+} ModeFunctions;
+
+
+static const ModeFunctions modes[] =
+{
+	{"16-bit", Disassemble16, InstructionLength16, DisassembleBlock16, InstructionLengthBlock16, DecodeRangeVisit16,
+		ParallelSweep16, BuildControlFlowGraph16, BuildControlFlowGraphParallel16},
+	{"32-bit", Disassemble32, InstructionLength32, DisassembleBlock32, InstructionLengthBlock32, DecodeRangeVisit32,
+		ParallelSweep32, BuildControlFlowGraph32, BuildControlFlowGraphParallel32},
+	{"64-bit", Disassemble64, InstructionLength64, DisassembleBlock64, InstructionLengthBlock64, DecodeRangeVisit64,
+		ParallelSweep64, BuildControlFlowGraph64, BuildControlFlowGraphParallel64}
+};
+
+
+// Byte sequences placed before the opcode bytes under test, to reach the escaped opcode maps and
+// the prefix dependent encodings
+static const struct
+{
+	uint8_t len;
+	uint8_t bytes[4];
+} leads[] =
+{
+	{0, {0}}, {1, {0x66}}, {1, {0x67}}, {1, {0xf2}}, {1, {0xf3}}, {1, {0xf0}}, {1, {0x2e}}, {1, {0x48}},
+	{1, {0x41}}, {2, {0x66, 0x48}}, {1, {0x0f}}, {2, {0x66, 0x0f}}, {2, {0xf2, 0x0f}}, {2, {0xf3, 0x0f}},
+	{2, {0x48, 0x0f}}, {2, {0x0f, 0x38}}, {3, {0x66, 0x0f, 0x38}}, {3, {0xf2, 0x0f, 0x38}},
+	{3, {0x66, 0x48, 0x0f}}, {2, {0x0f, 0x3a}}, {3, {0x66, 0x0f, 0x3a}}, {4, {0x66, 0x48, 0x0f, 0x3a}},
+	{2, {0x0f, 0x0f}}
+};
+
+
+// Chunk counts for ParallelSweep, from a single chunk to chunks of two sync windows in a full buffer
+static const size_t sweepChunkCounts[] = {1, 2, 3, 7, 16, MAX_SWEEP_CHUNKS};
+
+
+// Register masks of instructions that write part of a register, which must also read it. These are
+// decoded in 64-bit mode.
+static const struct
+{
+	uint8_t len;
+	uint8_t bytes[4];
+	uint8_t access;
+	uint64_t read;
+	uint64_t written;
+} registerForms[] =
+{
+	{4, {0xf2, 0x0f, 0x10, 0xc1}, X86_ACCESS_READ_WRITE, X86_REG_MASK_XMM(0) | X86_REG_MASK_XMM(1), X86_REG_MASK_XMM(0)},
+	{4, {0xf2, 0x0f, 0x10, 0x01}, X86_ACCESS_WRITE, X86_REG_MASK_RCX, X86_REG_MASK_XMM(0)},
+	{4, {0xf2, 0x0f, 0x11, 0x01}, X86_ACCESS_WRITE, X86_REG_MASK_RCX | X86_REG_MASK_XMM(0), 0},
+	{4, {0xf3, 0x0f, 0x10, 0xc1}, X86_ACCESS_READ_WRITE, X86_REG_MASK_XMM(0) | X86_REG_MASK_XMM(1), X86_REG_MASK_XMM(0)},
+	{4, {0xf3, 0x0f, 0x10, 0x01}, X86_ACCESS_WRITE, X86_REG_MASK_RCX, X86_REG_MASK_XMM(0)},
+	{3, {0x0f, 0x12, 0x01}, X86_ACCESS_READ_WRITE, X86_REG_MASK_RCX | X86_REG_MASK_XMM(0), X86_REG_MASK_XMM(0)},
+	{3, {0x0f, 0x13, 0x01}, X86_ACCESS_WRITE, X86_REG_MASK_RCX | X86_REG_MASK_XMM(0), 0},
+	{4, {0x66, 0x0f, 0x16, 0x01}, X86_ACCESS_READ_WRITE, X86_REG_MASK_RCX | X86_REG_MASK_XMM(0), X86_REG_MASK_XMM(0)},
+	{4, {0x66, 0x0f, 0x12, 0xc1}, X86_ACCESS_READ_WRITE, X86_REG_MASK_XMM(0) | X86_REG_MASK_XMM(1), X86_REG_MASK_XMM(0)},
+	{4, {0xf2, 0x0f, 0x2a, 0xc0}, X86_ACCESS_READ_WRITE, X86_REG_MASK_XMM(0) | X86_REG_MASK_RAX, X86_REG_MASK_XMM(0)},
+	{4, {0xf3, 0x0f, 0x5a, 0xc1}, X86_ACCESS_READ_WRITE, X86_REG_MASK_XMM(0) | X86_REG_MASK_XMM(1), X86_REG_MASK_XMM(0)},
+	{3, {0x0f, 0x2a, 0xc1}, X86_ACCESS_READ_WRITE, X86_REG_MASK_XMM(0) | X86_REG_MASK_MM(1), X86_REG_MASK_XMM(0)},
+	{4, {0x66, 0x0f, 0x2a, 0xc1}, X86_ACCESS_WRITE, X86_REG_MASK_MM(1), X86_REG_MASK_XMM(0)},
+	{4, {0xf2, 0x0f, 0x51, 0xc1}, X86_ACCESS_READ_WRITE, X86_REG_MASK_XMM(0) | X86_REG_MASK_XMM(1), X86_REG_MASK_XMM(0)},
+	{3, {0x0f, 0x28, 0xc1}, X86_ACCESS_WRITE, X86_REG_MASK_XMM(1), X86_REG_MASK_XMM(0)},
+	{2, {0x88, 0xc8}, X86_ACCESS_WRITE, X86_REG_MASK_RAX | X86_REG_MASK_RCX, X86_REG_MASK_RAX},
+	{2, {0x89, 0xc8}, X86_ACCESS_WRITE, X86_REG_MASK_RCX, X86_REG_MASK_RAX}
+};
+
+
+typedef struct
+{
+	uint64_t state;
+} Random;
+
+
+typedef struct
+{
+	size_t offsets[BUFFER_SIZE];
+	size_t count;
+} VisitRecord;
+
+
+static size_t failures = 0;
+
+
+static uint64_t RandomNext(Random* rng)
+{
+	// xorshift64*
+	rng->state ^= rng->state >> 12;
+	rng->state ^= rng->state << 25;
+	rng->state ^= rng->state >> 27;
+	return rng->state * 0x2545f4914f6cdd1dULL;
+}
+
+
+static uint32_t RandomRange(Random* rng, uint32_t count)
+{
+	return (uint32_t)((RandomNext(rng) >> 32) % count);
+}
+
+
+static void Fail(const ModeFunctions* mode, const char* what, const uint8_t* opcode, size_t len, size_t expected,
+	size_t actual)
+{
+	failures++;
+	if (failures > MAX_FAILURES)
+		return;
+	printf("%s %s: expected %zu, got %zu for", mode->name, what, expected, actual);
+	for (size_t i = 0; (i < len) && (i < X86_MAX_INSTRUCTION_LENGTH); i++)
+		printf(" %02x", opcode[i]);
+	printf("\n");
+}
+
+
+// Unused operands and the segment of operands other than memory are not filled in by the
+// decoder, so instructions are compared field by field
+static bool SameInstruction(const Instruction* a, const Instruction* b)
+{
+	if ((a->operation != b->operation) || (a->flags != b->flags) || (a->segment != b->segment) ||
+		(a->length != b->length))
+		return false;
+	for (size_t i = 0; i < 3; i++)
+	{
+		const InstructionOperand* x = &a->operands[i];
+		const InstructionOperand* y = &b->operands[i];
+		if (x->operand != y->operand)
+			return false;
+		if (x->operand == NONE)
+			break;
+		if ((x->size != y->size) || (x->immediate != y->immediate) || (x->relative != y->relative) ||
+			(x->access != y->access))
+			return false;
+		if ((x->operand == MEM) && ((x->components[0] != y->components[0]) ||
+			(x->components[1] != y->components[1]) || (x->scale != y->scale) || (x->segment != y->segment)))
+			return false;
+	}
+	return true;
+}
+
+
+static void CheckLength(const ModeFunctions* mode, const uint8_t* opcode, size_t maxLen)
+{
+	Instruction instr;
+	size_t expected = mode->disassemble(opcode, CHECK_ADDRESS, maxLen, &instr) ? instr.length : 0;
+	size_t actual = mode->instructionLength(opcode, maxLen);
+	if (actual != expected)
+		Fail(mode, "instruction length", opcode, maxLen, expected, actual);
+}
+
+
+// Checks every pair of opcode bytes after each lead, with random bytes for the rest
+static void CheckOpcodes(const ModeFunctions* mode, Random* rng)
+{
+	uint8_t opcode[X86_MAX_INSTRUCTION_LENGTH];
+
+	for (size_t l = 0; l < sizeof(leads) / sizeof(leads[0]); l++)
+	{
+		for (uint32_t pair = 0; pair < 0x10000; pair++)
+		{
+			size_t i = leads[l].len;
+			memcpy(opcode, leads[l].bytes, i);
+			opcode[i++] = (uint8_t)pair;
+			opcode[i++] = (uint8_t)(pair >> 8);
+			for (; i < sizeof(opcode); i++)
+				opcode[i] = (uint8_t)RandomNext(rng);
+
+			CheckLength(mode, opcode, sizeof(opcode));
+			CheckLength(mode, opcode, 1 + RandomRange(rng, X86_MAX_INSTRUCTION_LENGTH));
+		}
+	}
+}
+
+
+static void CheckRegisterMasks(const ModeFunctions* mode)
+{
+	for (size_t i = 0; i < sizeof(registerForms) / sizeof(registerForms[0]); i++)
+	{
+		const uint8_t* opcode = registerForms[i].bytes;
+		size_t len = registerForms[i].len;
+		Instruction instr;
+		X86RegisterMasks masks;
+
+		if (!mode->disassemble(opcode, CHECK_ADDRESS, len, &instr))
+		{
+			Fail(mode, "register form length", opcode, len, len, 0);
+			continue;
+		}
+		GetRegisterMasks(&instr, &masks);
+		if (instr.operands[0].access != registerForms[i].access)
+			Fail(mode, "destination access", opcode, len, registerForms[i].access, instr.operands[0].access);
+		if (masks.read != registerForms[i].read)
+			Fail(mode, "registers read", opcode, len, (size_t)registerForms[i].read, (size_t)masks.read);
+		if (masks.written != registerForms[i].written)
+			Fail(mode, "registers written", opcode, len, (size_t)registerForms[i].written, (size_t)masks.written);
+	}
+}
+
+
+static size_t GreatestCommonDivisor(size_t a, size_t b)
+{
+	while (b != 0)
+	{
+		size_t r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+
+// Task runner that runs the tasks on the calling thread, from a random first task with a random
+// stride, so that results that depend on the tasks running in order are found
+static void RunTasksOutOfOrder(void* context, X86TaskFunction func, void* arg, size_t count)
+{
+	Random* rng = (Random*)context;
+	size_t index;
+	size_t stride;
+
+	if (count == 0)
+		return;
+	index = RandomRange(rng, (uint32_t)count);
+	do
+	{
+		stride = 1 + RandomRange(rng, (uint32_t)count);
+	} while (GreatestCommonDivisor(stride, count) != 1);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		func(arg, index);
+		index = (index + stride) % count;
+	}
+}
+
+
+// Checks ParallelSweep against a serial sweep that gives each byte without a valid instruction a
+// result of its own. Each chunk count is checked, with the tasks run out of order, and with random
+// limits on the number of results.
+static void CheckSweep(const ModeFunctions* mode, const uint8_t* code, size_t size, Random* rng,
+	Instruction* serial, Instruction* swept, X86SweepChunk* chunks)
+{
+	size_t count = 0;
+	size_t offset = 0;
+
+	while (offset < size)
+	{
+		Instruction* instr = &serial[count++];
+		if (!mode->disassemble(&code[offset], CHECK_ADDRESS + offset, size - offset, instr))
+		{
+			memset(instr, 0, sizeof(Instruction));
+			instr->operation = INVALID;
+			instr->segment = SEG_DEFAULT;
+			instr->length = 1;
+		}
+		offset += instr->length;
+	}
+
+	for (size_t c = 0; c < sizeof(sweepChunkCounts) / sizeof(sweepChunkCounts[0]); c++)
+	{
+		size_t maxCount = (RandomRange(rng, 2) == 0) ? size : RandomRange(rng, (uint32_t)count + 1);
+		size_t expected = (count < maxCount) ? count : maxCount;
+		size_t next = 0;
+		size_t n;
+
+		// The first chunk count runs the tasks without a runner, in order
+		n = mode->parallelSweep(code, CHECK_ADDRESS, size, swept, maxCount, chunks, sweepChunkCounts[c],
+			(c == 0) ? NULL : RunTasksOutOfOrder, rng, &next);
+		if (n != expected)
+		{
+			Fail(mode, "sweep count", code, size, expected, n);
+			continue;
+		}
+
+		offset = 0;
+		for (size_t i = 0; i < n; i++)
+		{
+			if (!SameInstruction(&serial[i], &swept[i]))
+			{
+				Fail(mode, "sweep instruction length", &code[offset], size - offset, serial[i].length,
+					swept[i].length);
+				break;
+			}
+			offset += serial[i].length;
+		}
+		if (next != offset)
+			Fail(mode, "sweep next offset", code, size, offset, next);
+	}
+}
+
+
+// The padding of X86BasicBlock is not defined, so blocks are compared field by field, reporting the
+// first field that differs
+static bool CheckBasicBlock(const ModeFunctions* mode, const uint8_t* code, size_t size,
+	const X86BasicBlock* expected, const X86BasicBlock* actual)
+{
+	const uint8_t* opcode = &code[expected->addr - CHECK_ADDRESS];
+	size_t len = size - (size_t)(expected->addr - CHECK_ADDRESS);
+
+	if (actual->addr != expected->addr)
+		Fail(mode, "parallel graph block address", opcode, len, (size_t)expected->addr, (size_t)actual->addr);
+	else if (actual->length != expected->length)
+		Fail(mode, "parallel graph block length", opcode, len, expected->length, actual->length);
+	else if (actual->instructionCount != expected->instructionCount)
+		Fail(mode, "parallel graph block instruction count", opcode, len, expected->instructionCount,
+			actual->instructionCount);
+	else if (actual->firstSuccessor != expected->firstSuccessor)
+		Fail(mode, "parallel graph block first successor", opcode, len, expected->firstSuccessor,
+			actual->firstSuccessor);
+	else if (actual->successorCount != expected->successorCount)
+		Fail(mode, "parallel graph block successor count", opcode, len, expected->successorCount,
+			actual->successorCount);
+	else if (actual->flags != expected->flags)
+		Fail(mode, "parallel graph block flags", opcode, len, expected->flags, actual->flags);
+	else
+		return true;
+	return false;
+}
+
+
+// Checks that BuildControlFlowGraphParallel builds the same graph as BuildControlFlowGraph for each
+// number of tasks, with the tasks run out of order
+static void CheckControlFlowGraph(const ModeFunctions* mode, const uint8_t* code, size_t size, Random* rng,
+	uint8_t* serialMemory, uint8_t* parallelMemory)
+{
+	uint64_t entries[GRAPH_ENTRY_COUNT];
+	X86ControlFlowGraph serial;
+
+	entries[0] = CHECK_ADDRESS;
+	for (size_t i = 1; i < GRAPH_ENTRY_COUNT; i++)
+		entries[i] = CHECK_ADDRESS + RandomRange(rng, (uint32_t)size);
+
+	if (!mode->buildControlFlowGraph(code, CHECK_ADDRESS, size, entries, GRAPH_ENTRY_COUNT, serialMemory,
+		GRAPH_MEMORY_SIZE, &serial))
+	{
+		Fail(mode, "graph memory", code, size, 1, 0);
+		return;
+	}
+
+	for (size_t tasks = 1; tasks <= MAX_GRAPH_TASKS; tasks++)
+	{
+		X86ControlFlowGraph parallel;
+
+		if (!mode->buildControlFlowGraphParallel(code, CHECK_ADDRESS, size, entries, GRAPH_ENTRY_COUNT,
+			parallelMemory, GRAPH_MEMORY_SIZE, RunTasksOutOfOrder, rng, tasks, &parallel))
+		{
+			Fail(mode, "parallel graph memory", code, size, 1, 0);
+			continue;
+		}
+		if (parallel.blockCount != serial.blockCount)
+		{
+			Fail(mode, "parallel graph block count", code, size, serial.blockCount, parallel.blockCount);
+			continue;
+		}
+		if (parallel.successorCount != serial.successorCount)
+		{
+			Fail(mode, "parallel graph successor count", code, size, serial.successorCount,
+				parallel.successorCount);
+			continue;
+		}
+
+		for (size_t i = 0; i < serial.blockCount; i++)
+		{
+			if (!CheckBasicBlock(mode, code, size, &serial.blocks[i], &parallel.blocks[i]))
+				break;
+		}
+		for (size_t i = 0; i < serial.successorCount; i++)
+		{
+			if (parallel.successors[i] != serial.successors[i])
+			{
+				Fail(mode, "parallel graph successor", code, size, serial.successors[i], parallel.successors[i]);
+				break;
+			}
+		}
+	}
+}
+
+
+static bool RecordVisit(void* context, const Instruction* instr, size_t offset)
+{
+	VisitRecord* record = (VisitRecord*)context;
+	(void)instr;
+	record->offsets[record->count++] = offset;
+	return true;
+}
+
+
+// Checks the block decoders and DecodeRangeVisit against one instruction at a time decoding of a
+// buffer of random bytes
+static void CheckBuffer(const ModeFunctions* mode, const uint8_t* code, size_t size, Random* rng,
+	Instruction* decoded, Instruction* block, uint8_t* lengths, VisitRecord* record)
+{
+	size_t count = 0;
+	size_t end = 0;
+	size_t next;
+	size_t n;
+	size_t offset;
+	X86OperationFilter filter;
+	size_t expectedVisits = 0;
+
+	// Decode up to the first invalid instruction
+	while (end < size)
+	{
+		if (!mode->disassemble(&code[end], CHECK_ADDRESS + end, size - end, &decoded[count]))
+			break;
+		end += decoded[count++].length;
+	}
+
+	n = mode->disassembleBlock(code, CHECK_ADDRESS, size, block, BLOCK_SIZE, &next);
+	if (n != ((count < BLOCK_SIZE) ? count : BLOCK_SIZE))
+		Fail(mode, "block count", code, size, count, n);
+	else
+	{
+		offset = 0;
+		for (size_t i = 0; i < n; i++)
+		{
+			if (!SameInstruction(&decoded[i], &block[i]))
+			{
+				Fail(mode, "block instruction length", &code[offset], size - offset, decoded[i].length,
+					block[i].length);
+				break;
+			}
+			offset += decoded[i].length;
+		}
+	}
+
+	n = mode->instructionLengthBlock(code, size, lengths, BLOCK_SIZE, &next);
+	if (n != ((count < BLOCK_SIZE) ? count : BLOCK_SIZE))
+		Fail(mode, "length block count", code, size, count, n);
+	else
+	{
+		offset = 0;
+		for (size_t i = 0; i < n; i++)
+		{
+			if (lengths[i] != decoded[i].length)
+			{
+				Fail(mode, "length block", &code[offset], size - offset, decoded[i].length, lengths[i]);
+				break;
+			}
+			offset += decoded[i].length;
+		}
+	}
+
+	// Visit a few random operations. Operations past the last one are never matched.
+	ClearOperationFilter(&filter);
+	for (size_t i = 0; i < 4; i++)
+		AddOperationToFilter(&filter, (InstructionOperation)RandomRange(rng, X86_OPERATION_FILTER_WORDS * 64));
+	if (count > 0)
+		AddOperationToFilter(&filter, decoded[RandomRange(rng, (uint32_t)count)].operation);
+	record->count = 0;
+	n = mode->decodeRangeVisit(code, CHECK_ADDRESS, size, &filter, RecordVisit, record, &next);
+	if ((n != count) || (next != end))
+		Fail(mode, "visit count", code, size, count, n);
+	else
+	{
+		offset = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			if (IsOperationInFilter(&filter, decoded[i].operation))
+			{
+				if ((expectedVisits >= record->count) || (record->offsets[expectedVisits] != offset))
+				{
+					Fail(mode, "visit", &code[offset], size - offset, offset,
+						(expectedVisits < record->count) ? record->offsets[expectedVisits] : 0);
+					break;
+				}
+				expectedVisits++;
+			}
+			offset += decoded[i].length;
+		}
+		if (expectedVisits != record->count)
+			Fail(mode, "visit total", code, size, expectedVisits, record->count);
+	}
+}
+
+
+int main(int argc, char** argv)
+{
+	size_t bufferCount = (argc > 1) ? (size_t)strtoul(argv[1], NULL, 0) : DEFAULT_BUFFER_COUNT;
+	uint8_t* code = (uint8_t*)malloc(BUFFER_SIZE);
+	Instruction* decoded = (Instruction*)malloc(sizeof(Instruction) * (BUFFER_SIZE + 1));
+	Instruction* block = (Instruction*)malloc(sizeof(Instruction) * BLOCK_SIZE);
+	uint8_t* lengths = (uint8_t*)malloc(BLOCK_SIZE);
+	VisitRecord* record = (VisitRecord*)malloc(sizeof(VisitRecord));
+	Instruction* swept = (Instruction*)malloc(sizeof(Instruction) * BUFFER_SIZE);
+	X86SweepChunk* chunks = (X86SweepChunk*)malloc(sizeof(X86SweepChunk) * MAX_SWEEP_CHUNKS);
+	uint8_t* serialGraphMemory = (uint8_t*)malloc(GRAPH_MEMORY_SIZE);
+	uint8_t* parallelGraphMemory = (uint8_t*)malloc(GRAPH_MEMORY_SIZE);
+	size_t checked = 0;
+
+	CheckRegisterMasks(&modes[2]);
+
+	for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); m++)
+	{
+		const ModeFunctions* mode = &modes[m];
+		Random rng;
+
+		rng.state = 0x5eed0000 + m;
+		CheckOpcodes(mode, &rng);
+
+		for (size_t b = 0; b < bufferCount; b++)
+		{
+			// Random bytes with the leads mixed in, so that the escaped opcode maps are common
+			size_t offset = 0;
+			while (offset < BUFFER_SIZE)
+			{
+				size_t l = RandomRange(&rng, sizeof(leads) / sizeof(leads[0]));
+				if ((RandomRange(&rng, 4) == 0) && ((offset + leads[l].len) <= BUFFER_SIZE))
+				{
+					memcpy(&code[offset], leads[l].bytes, leads[l].len);
+					offset += leads[l].len;
+				}
+				else
+					code[offset++] = (uint8_t)RandomNext(&rng);
+			}
+
+			// Check from many starting points, as random bytes soon reach an invalid instruction
+			for (offset = 0; offset < BUFFER_SIZE; offset += 1 + RandomRange(&rng, 64))
+			{
+				CheckBuffer(mode, &code[offset], BUFFER_SIZE - offset, &rng, decoded, block, lengths, record);
+				checked++;
+			}
+
+			offset = RandomRange(&rng, X86_MAX_INSTRUCTION_LENGTH);
+			CheckSweep(mode, &code[offset], BUFFER_SIZE - offset, &rng, decoded, swept, chunks);
+			CheckControlFlowGraph(mode, code, BUFFER_SIZE, &rng, serialGraphMemory, parallelGraphMemory);
+		}
+	}
+
+	free(code);
+	free(decoded);
+	free(block);
+	free(lengths);
+	free(record);
+	free(swept);
+	free(chunks);
+	free(serialGraphMemory);
+	free(parallelGraphMemory);
+
+	if (failures)
+	{
+		printf("%zu failures\n", failures);
+		return 1;
+	}
+	printf("decoders agree over %zu buffers in each mode\n", checked / (sizeof(modes) / sizeof(modes[0])));
+	return 0;
+}